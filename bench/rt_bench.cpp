@@ -0,0 +1,438 @@
+#include "engine/router.hpp"
+#include "io/udp_receiver.hpp"
+#include "md/feed_handler.hpp"
+#include "md/feed_sim.hpp"
+#include "md/spsc_queue.hpp"
+#include "md/symbol_table.hpp"
+#include "md/tick.hpp"
+#include "stats/covariance_matrix.hpp"
+#include "stats/rolling_stats.hpp"
+#include "stats/soa_stats.hpp"
+#include "util/latency.hpp"
+#include "util/random.hpp"
+#include "util/thread_affinity.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <numbers>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Microbenchmarks for the hot-path components. Run `rt_bench` for a console
+// table, or build the `bench_json` target to write bench_results.json for
+// release-over-release comparison (e.g. with Google Benchmark's compare.py).
+
+namespace {
+
+// Pin the calling thread to core % hardware threads; best effort
+void pin_to_core(unsigned core) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    pin_current_thread(core % cores);
+}
+
+// Puts the calling thread's CPU mask back on scope exit, so a benchmark that
+// pins the main thread leaves the ones registered after it unpinned
+class AffinityRestorer {
+private:
+#if defined(__linux__)
+    cpu_set_t saved_{};
+    bool valid_{pthread_getaffinity_np(pthread_self(), sizeof(saved_), &saved_) == 0};
+#endif
+
+public:
+    AffinityRestorer() = default;
+
+    ~AffinityRestorer() {
+#if defined(__linux__)
+        if (valid_) pthread_setaffinity_np(pthread_self(), sizeof(saved_), &saved_);
+#endif
+    }
+
+    AffinityRestorer(const AffinityRestorer&) = delete;
+    AffinityRestorer& operator=(const AffinityRestorer&) = delete;
+};
+
+std::vector<double> make_values(std::size_t n) {
+    std::vector<double> values(n);
+    Xoshiro256x4 rng(42);
+    rng.fill_normal(values.data(), n);
+    for (auto& v : values) v = 100.0 + v;
+    return values;
+}
+
+// Pre-generated ticks for n symbols, so Router benchmarks time only the Router
+std::vector<Tick> make_ticks(std::size_t symbols, std::size_t steps) {
+    std::vector<SymbolConfig> configs;
+    configs.reserve(symbols);
+    for (std::size_t i = 0; i < symbols; ++i) {
+        configs.emplace_back("BENCH" + std::to_string(i), 100.0 + static_cast<double>(i % 50), 200.0);
+    }
+    FeedSimulator feed(std::move(configs));
+
+    struct VectorSink {
+        std::vector<Tick>& out;
+        bool push(const Tick& tick) { out.push_back(tick); return true; }
+    };
+    std::vector<Tick> ticks;
+    ticks.reserve(symbols * steps);
+    VectorSink sink{ticks};
+    for (std::size_t s = 0; s < steps; ++s) feed.generate_ticks(sink);
+    return ticks;
+}
+
+} // namespace
+
+// --- SPSCQueue ---------------------------------------------------------------
+
+static void BM_SPSC_PushPop(benchmark::State& state) {
+    auto queue = std::make_unique<SPSCQueue<Tick, 1024>>();
+    Tick tick;
+    Tick out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queue->push(tick));
+        benchmark::DoNotOptimize(queue->pop(out));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SPSC_PushPop);
+
+static void BM_SPSC_Batch(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    auto queue = std::make_unique<SPSCQueue<Tick, 1024>>();
+    std::vector<Tick> in(batch);
+    std::vector<Tick> out(batch);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(queue->try_push_n(in.data(), batch));
+        benchmark::DoNotOptimize(queue->try_pop_n(out.data(), batch));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+}
+BENCHMARK(BM_SPSC_Batch)->Arg(8)->Arg(64)->Arg(256);
+
+// Producer on core 0, consumer (the timed thread) on core 1. Arg: batch size
+// (1 = push/pop per item).
+static void BM_SPSC_ThreadPair(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    auto queue = std::make_unique<SPSCQueue<Tick, 65536>>();
+    std::atomic<bool> running{true};
+
+    std::thread producer([&]() {
+        pin_to_core(0);
+        std::vector<Tick> items(batch);
+        while (running.load(std::memory_order_relaxed)) {
+            if (batch == 1) {
+                benchmark::DoNotOptimize(queue->push(items[0]));
+            } else {
+                benchmark::DoNotOptimize(queue->try_push_n(items.data(), batch));
+            }
+        }
+    });
+
+    const AffinityRestorer restore_affinity;
+    pin_to_core(1);
+    std::vector<Tick> out(batch);
+    int64_t received = 0;
+    for (auto _ : state) {
+        std::size_t n = 0;
+        while (n == 0) {
+            n = batch == 1 ? (queue->pop(out[0]) ? 1 : 0) : queue->try_pop_n(out.data(), batch);
+        }
+        received += static_cast<int64_t>(n);
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    producer.join();
+    state.SetItemsProcessed(received);
+}
+BENCHMARK(BM_SPSC_ThreadPair)->Arg(1)->Arg(64)->UseRealTime();
+
+// --- Random numbers ----------------------------------------------------------
+
+// Batched normals, against the same Box-Muller transform through libm
+static void BM_FillNormal(benchmark::State& state) {
+    std::vector<double> out(static_cast<std::size_t>(state.range(0)));
+    Xoshiro256x4 rng(42);
+    for (auto _ : state) {
+        rng.fill_normal(out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FillNormal)->Arg(4096);
+
+static void BM_FillNormalLibm(benchmark::State& state) {
+    std::vector<double> out(static_cast<std::size_t>(state.range(0)));
+    Xoshiro256x4 rng(42);
+    for (auto _ : state) {
+        rng.fill_uniform(out.data(), out.size());
+        for (std::size_t i = 0; i + 1 < out.size(); i += 2) {
+            const double r = std::sqrt(-2.0 * std::log(out[i]));
+            const double theta = 2.0 * std::numbers::pi * out[i + 1];
+            out[i] = r * std::cos(theta);
+            out[i + 1] = r * std::sin(theta);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FillNormalLibm)->Arg(4096);
+
+// --- Statistics --------------------------------------------------------------
+
+template <typename Stats>
+static void BM_StatsAdd(benchmark::State& state) {
+    const auto values = make_values(4096);
+    Stats stats = [] {
+        if constexpr (std::is_default_constructible_v<Stats>) return Stats{};
+        else return Stats{std::size_t{20}};
+    }();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        stats.add(values[i++ & 4095]);
+        benchmark::DoNotOptimize(stats);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_StatsAdd, RollingStats);
+BENCHMARK_TEMPLATE(BM_StatsAdd, EMAStats);
+BENCHMARK_TEMPLATE(BM_StatsAdd, WindowedStats<256>);
+
+static void BM_SlidingWindowStatsAdd(benchmark::State& state) {
+    const auto values = make_values(4096);
+    SlidingWindowStats stats(static_cast<std::size_t>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        stats.add(values[i++ & 4095]);
+        benchmark::DoNotOptimize(stats);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlidingWindowStatsAdd)->Arg(64)->Arg(1024);
+
+// One step of every symbol: update each symbol's stats with its new price, then
+// collect the symbols whose z-score crosses 2. Arg: symbols. Items are symbol
+// updates. SoAStats against the heap-allocated RollingStats it replaces.
+constexpr std::size_t STATS_STEPS = 64;
+
+static void BM_SoAStatsStep(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto values = make_values(n * STATS_STEPS);
+    SoAStats stats(n);
+    std::vector<uint32_t> hits(n);
+    std::size_t step = 0;
+    for (auto _ : state) {
+        const double* row = values.data() + (step++ % STATS_STEPS) * n;
+        stats.update_all(row);
+        benchmark::DoNotOptimize(stats.scan_zscore(row, 2.0, 2, hits.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SoAStatsStep)->Arg(64)->Arg(1024);
+
+static void BM_RollingStatsStep(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto values = make_values(n * STATS_STEPS);
+    std::vector<std::unique_ptr<RollingStats>> stats;
+    for (std::size_t i = 0; i < n; ++i) stats.push_back(std::make_unique<RollingStats>());
+    std::vector<uint32_t> hits(n);
+    std::size_t step = 0;
+    for (auto _ : state) {
+        const double* row = values.data() + (step++ % STATS_STEPS) * n;
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            stats[i]->add(row[i]);
+            if (stats[i]->count() >= 2 && std::abs(stats[i]->z_score(row[i])) >= 2.0) {
+                hits[found++] = static_cast<uint32_t>(i);
+            }
+        }
+        benchmark::DoNotOptimize(found);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RollingStatsStep)->Arg(64)->Arg(1024);
+
+// One synchronized snapshot into the all-pairs EMA covariance. Args: series,
+// snapshots per blocked update. Items are pair updates.
+static void BM_CovarianceMatrixUpdate(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto batch = static_cast<std::size_t>(state.range(1));
+    const auto values = make_values(4096);
+    std::vector<double> snapshots(n * batch);
+    for (std::size_t i = 0; i < snapshots.size(); ++i) snapshots[i] = values[i & 4095];
+
+    EMACovarianceMatrix matrix(n, std::size_t{64});
+    matrix.update_batch(snapshots.data(), batch);
+    for (auto _ : state) {
+        matrix.update_batch(snapshots.data(), batch);
+        benchmark::DoNotOptimize(matrix.covariance(0, n - 1));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch * n * (n + 1) / 2));
+}
+BENCHMARK(BM_CovarianceMatrixUpdate)
+    ->Args({100, 1})->Args({100, 16})
+    ->Args({500, 1})->Args({500, 16})
+    ->Args({1000, 1})->Args({1000, 16});
+
+// --- Latency histogram -------------------------------------------------------
+
+static void BM_LatencyHistogramAddSampleUs(benchmark::State& state) {
+    LatencyHistogram histogram;
+    uint64_t latency = 1;
+    for (auto _ : state) {
+        histogram.add_sample_us(latency);
+        latency = (latency * 7 + 3) & 0xfff;  // Spread over buckets
+    }
+    benchmark::DoNotOptimize(histogram.max_latency_ns());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LatencyHistogramAddSampleUs);
+
+// --- SymbolTable -------------------------------------------------------------
+
+// Lookup of already-interned symbols (the steady-state path). Arg: distinct symbols.
+static void BM_SymbolTableIntern(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back("SYM" + std::to_string(i));
+        SymbolTable::intern_id(names.back());
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SymbolTable::intern_id(names[i]));
+        if (++i == count) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SymbolTableIntern)->Arg(16)->Arg(1024);
+
+// --- Router ------------------------------------------------------------------
+
+// End to end process_tick. Args: symbols, pairs (pair i watches symbols i, i+1)
+static void BM_RouterProcessTick(benchmark::State& state) {
+    const auto symbols = static_cast<std::size_t>(state.range(0));
+    const auto pairs = static_cast<std::size_t>(state.range(1));
+    const auto ticks = make_ticks(symbols, std::max<std::size_t>(64, 65536 / symbols));
+
+    Router router;
+    router.reserve(symbols, pairs);
+    for (std::size_t p = 0; p < pairs; ++p) {
+        router.add_watched_pair("BENCH" + std::to_string(p % symbols),
+                                "BENCH" + std::to_string((p + 1) % symbols));
+    }
+    uint64_t signals = 0;
+    router.set_signal_callback([&signals](const SignalEvent&) { ++signals; });
+
+    // Warm up: every symbol's rules exist before timing
+    for (std::size_t i = 0; i < symbols; ++i) router.process_tick(ticks[i]);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        router.process_tick(ticks[i]);
+        if (++i == ticks.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["signals_per_tick"] = benchmark::Counter(
+        static_cast<double>(signals) / static_cast<double>(state.iterations() + symbols));
+}
+BENCHMARK(BM_RouterProcessTick)
+    ->Args({10, 0})->Args({10, 10})
+    ->Args({100, 0})->Args({100, 100})
+    ->Args({1000, 0})->Args({1000, 1000});
+
+// --- Network feed ------------------------------------------------------------
+
+namespace {
+
+// One RTMD packet of quotes for instrument 1 after its definition packet
+std::pair<std::vector<std::byte>, std::vector<std::byte>> make_rtmd_packets(std::size_t quotes) {
+    RtmdPacketBuilder builder;
+    builder.add_instrument(1, "BENCH_NET", 0.01);
+    std::vector<std::byte> definition(builder.finish().begin(), builder.finish().end());
+    builder.clear();
+    for (std::size_t q = 0; q < quotes; ++q) {
+        const double px = 100.0 + static_cast<double>(q) * 0.01;
+        builder.add_tick(1, Tick{INVALID_SYMBOL_ID, px, px - 0.01, px + 0.01, 100.0, 0}, 0.01);
+    }
+    const auto quote_packet = builder.finish();
+    return {definition, std::vector<std::byte>(quote_packet.begin(), quote_packet.end())};
+}
+
+// Rewrite the header sequence so each replayed packet is new to the decoder
+void set_rtmd_sequence(std::vector<std::byte>& packet, uint64_t sequence) {
+    std::memcpy(packet.data() + offsetof(RtmdPacketHeader, sequence), &sequence, sizeof(sequence));
+}
+
+} // namespace
+
+// Decode only. Arg: quotes per packet
+static void BM_RtmdDecode(benchmark::State& state) {
+    const auto quotes = static_cast<std::size_t>(state.range(0));
+    auto [definition, packet] = make_rtmd_packets(quotes);
+    RtmdDecoder decoder;
+    std::vector<Tick> out(FeedHandler<RtmdDecoder>::MAX_TICKS_PER_PACKET);
+    const auto rx = TickClock::now();
+    decoder.decode(definition, rx, out);
+
+    uint64_t sequence = 2;
+    for (auto _ : state) {
+        set_rtmd_sequence(packet, sequence);
+        sequence += quotes;
+        benchmark::DoNotOptimize(decoder.decode(packet, rx, out));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(quotes));
+}
+BENCHMARK(BM_RtmdDecode)->Arg(1)->Arg(60);
+
+// Loopback UDP: sendto, recvmmsg batch, decode and queue push. Arg: packets per batch
+static void BM_UdpFeedHandler(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    UdpReceiverConfig config;
+    config.bind_address = "127.0.0.1";
+    UdpReceiver receiver(config);
+    FeedHandler<RtmdDecoder> handler(receiver);
+    SPSCQueue<Tick, 4096> queue;
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in to{};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(receiver.port());
+    ::inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+    auto send = [&](const std::vector<std::byte>& packet) {
+        ::sendto(fd, packet.data(), packet.size(), 0, reinterpret_cast<const sockaddr*>(&to), sizeof(to));
+    };
+
+    auto [definition, packet] = make_rtmd_packets(1);
+    send(definition);
+    while (handler.poll(queue) == 0) {}
+
+    uint64_t sequence = 2;
+    Tick tick;
+    for (auto _ : state) {
+        for (std::size_t p = 0; p < batch; ++p) {
+            set_rtmd_sequence(packet, sequence++);
+            send(packet);
+        }
+        for (std::size_t received = 0; received < batch;) received += handler.poll(queue);
+        while (queue.pop(tick)) {}
+    }
+    ::close(fd);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch));
+    state.counters["gaps"] = benchmark::Counter(static_cast<double>(handler.decoder().sequence_gaps()));
+}
+BENCHMARK(BM_UdpFeedHandler)->Arg(1)->Arg(32);
+
+BENCHMARK_MAIN();
@@ -144,6 +144,175 @@ class TradingSystemWrapper:
             return pd.read_csv(latency_file)
         return None
 
+    def run_parameter_sweep(self,
+                            zscore_thresholds=(2.0, 2.5, 3.0),
+                            correlation_thresholds=(0.3,),
+                            volume_thresholds=(3.0,),
+                            steps: int = 200000,
+                            tick_journals=None,
+                            watched_pairs=None,
+                            threads: int = 0) -> Optional[pd.DataFrame]:
+        """
+        Evaluate every threshold combination over one tick stream with the
+        param_sweep tool (engine/backtest.hpp), instead of one demo run each
+
+        Args:
+            steps: Simulated steps (4 symbols each) when no journals are given
+            tick_journals: Recorded ticks-*.rtj files to replay instead
+            watched_pairs: (symbol, symbol) pairs to watch; by default the
+                simulated pairs, and none for journals
+            threads: Worker threads (0: one per core)
+
+        Returns:
+            One row per configuration with signal counts per type, or None
+            if the tool failed
+        """
+        import io
+        join = lambda values: ",".join(str(v) for v in values)
+        cmd = [
+            str(self.build_dir / "param_sweep"),
+            "--zscore", join(zscore_thresholds),
+            "--corr", join(correlation_thresholds),
+            "--volume", join(volume_thresholds),
+            "--steps", str(steps),
+            "--threads", str(threads),
+        ]
+        for first, second in (watched_pairs or []):
+            cmd.extend(["--pair", f"{first}:{second}"])
+        cmd.extend(str(path) for path in (tick_journals or []))
+
+        result = subprocess.run(cmd, capture_output=True, text=True)
+        if result.returncode != 0:
+            print(f"❌ Parameter sweep failed: {result.stderr.strip()}")
+            return None
+        return pd.read_csv(io.StringIO(result.stdout))
+
+    def native_module(self):
+        """
+        The rtcore extension (python/rtcore.cpp) from the build directory,
+        or None if it was not built (configure with -DRT_BUILD_PYTHON=ON)
+        """
+        import importlib
+        import sys
+        if str(self.build_dir) not in sys.path:
+            sys.path.insert(0, str(self.build_dir))
+        try:
+            return importlib.import_module("rtcore")
+        except ImportError:
+            return None
+
+    def run_in_process(self,
+                       steps: int = 100000,
+                       symbols: str = "AAPL,MSFT,GOOGL,TSLA",
+                       zscore_threshold: float = 2.5,
+                       router=None,
+                       feed=None,
+                       signal_capacity: int = 65536) -> Dict[str, Any]:
+        """
+        Same result shape as run_simulation(), computed in this process by
+        the rtcore module instead of a demo run plus CSV round trip. Pass the
+        returned router and feed back in to continue where the last call
+        stopped (live dashboards); signals accumulate in the router, up to
+        signal_capacity rows for a new one.
+        """
+        rtcore = self.native_module()
+        if rtcore is None:
+            raise RuntimeError(f"rtcore module not found in {self.build_dir}; "
+                               "configure with -DRT_BUILD_PYTHON=ON")
+
+        names = symbols.split(',')
+        if feed is None:
+            feed = rtcore.FeedSimulator([(name, 100.0 + 50.0 * i, 0.3) for i, name in enumerate(names)])
+        if router is None:
+            router = rtcore.Router(signal_capacity=signal_capacity)
+            router.set_zscore_threshold(zscore_threshold)
+            for first, second in zip(names[::2], names[1::2]):
+                router.add_watched_pair(first, second)
+
+        start_time = time.time()
+        router.run(feed, steps)
+        execution_time = time.time() - start_time
+
+        snapshot = router.snapshot()
+        return {
+            'success': True,
+            'execution_time': execution_time,
+            'metrics': {
+                'total_ticks': snapshot.ticks_processed,
+                'total_signals': snapshot.signals_generated,
+                'average_rate': snapshot.ticks_per_second,
+                'drop_rate': 0.0,
+            },
+            'signals': self.signals_frame(rtcore, router.signals()),
+            'latency_histogram': self.latency_frame(snapshot),
+            'router': router,
+            'feed': feed,
+            'config': {
+                'steps': steps,
+                'symbols': names,
+                'zscore_threshold': zscore_threshold
+            }
+        }
+
+    @staticmethod
+    def signals_frame(rtcore, signals) -> pd.DataFrame:
+        """Router.signals() as the data/signals.csv columns"""
+        types = [rtcore.SIGNAL_TYPES[t] for t in signals['event_type']]
+        return pd.DataFrame({
+            'timestamp': signals['event_time_ns'] // 1_000_000,
+            'signal_id': signals['signal_id'],
+            'type': types,
+            'primary_symbol': signals['primary_symbol'].astype(str),
+            'secondary_symbol': signals['secondary_symbol'].astype(str),
+            'signal_strength': signals['signal_strength'],
+            'confidence': signals['confidence'],
+            'latency_us': (signals['generation_time_ns'] - signals['event_time_ns']) // 1000,
+        })
+
+    @staticmethod
+    def latency_frame(snapshot) -> pd.DataFrame:
+        """Non-empty latency buckets as the data/latency_histogram.csv columns"""
+        counts = snapshot.latency_counts
+        bounds = snapshot.latency_bounds_ns()
+        used = counts > 0
+        total = max(int(counts.sum()), 1)
+        return pd.DataFrame({
+            'lower_bound_us': bounds[used, 0] / 1000.0,
+            'upper_bound_us': bounds[used, 1] / 1000.0,
+            'count': counts[used],
+            'percentage': counts[used] * 100.0 / total,
+        })
+
+    @staticmethod
+    def fetch_live_metrics(port: int = 9464, host: str = "127.0.0.1",
+                           timeout: float = 1.0) -> Optional[Dict[str, float]]:
+        """
+        Poll a running demo started with --metrics-port for its Prometheus
+        metrics, instead of re-running the binary
+
+        Returns:
+            {'rt_ticks_processed_total': 1234.0,
+             'rt_signals_total{type="ZBreak"}': 5.0, ...}, or None if the
+            endpoint is unreachable
+        """
+        import urllib.request
+        try:
+            with urllib.request.urlopen(f"http://{host}:{port}/metrics", timeout=timeout) as response:
+                text = response.read().decode("utf-8")
+        except OSError:
+            return None
+
+        metrics = {}
+        for line in text.splitlines():
+            if not line or line.startswith("#"):
+                continue
+            name, _, value = line.rpartition(" ")
+            try:
+                metrics[name] = float(value)
+            except ValueError:
+                continue
+        return metrics
+
     def get_system_info(self) -> Dict[str, str]:
         """Get system information"""
         return {
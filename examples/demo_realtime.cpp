@@ -1,19 +1,28 @@
 #include "md/spsc_queue.hpp"
 #include "md/feed_sim.hpp"
 #include "md/tick.hpp"
+#include "md/compact_tick.hpp"
+#include "engine/consumer_runner.hpp"
 #include "engine/router.hpp"
+#include "engine/signal_dispatcher.hpp"
+#include "io/checkpoint_file.hpp"
+#include "io/journal.hpp"
+#include "io/metrics_exporter.hpp"
 #include "util/latency.hpp"
+#include "util/thread_affinity.hpp"
+#include "util/wait_strategy.hpp"
 
 #include <iostream>
+#include <memory>
 #include <iomanip>
 #include <thread>
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <filesystem>
 #include <fstream>
 #include <vector>
 #include <sstream>
-#include <mutex>
 
 // Global shutdown signal
 std::atomic<bool> g_running{true};
@@ -33,13 +42,24 @@ struct DemoConfig {
     std::chrono::seconds duration{30};
     bool enable_csv_output = true;
     bool enable_live_display = true;
+    bool record_ticks = false;  // Journal every processed tick for ReplayFeed
+    ConsumerConfig consumer;    // Wait strategy and placement of the tick consumer
+    int feed_cpu = -1;
+    int metrics_port = -1;      // Serve Prometheus metrics on this port (-1: off)
+    std::string trace_out;      // Chrome trace of the last TRACE_CAPACITY stage spans (RT_ENABLE_TRACING)
+    OverloadConfig overload{OverloadPolicy::DROP, 0, 0.75, 0.5, {}};  // Full tick queue handling
+    std::string checkpoint_path;  // Rule state saved here and restored at startup
 };
 
-// Signal event logger
+constexpr std::size_t TRACE_CAPACITY = 1 << 18;
+constexpr auto CHECKPOINT_INTERVAL = std::chrono::seconds(1);
+constexpr auto REANCHOR_INTERVAL = std::chrono::seconds(1);   // CycleClock drift correction
+constexpr uint64_t CHECKPOINT_CHECK_TICKS = 4096;  // Ticks between clock reads
+
+// Signal event logger - a SignalDispatcher sink, so it runs on its own drain
+// thread and never slows down tick processing or the journal sink
 class SignalLogger {
 private:
-    std::vector<SignalEvent> events_;
-    std::mutex events_mutex_;
     std::atomic<uint64_t> signal_count_{0};
 
 public:
@@ -65,30 +85,6 @@ public:
 
             std::cout << std::endl;
         }
-
-        // Store for CSV export
-        std::lock_guard<std::mutex> lock(events_mutex_);
-        events_.push_back(event);
-    }
-
-    void export_csv(const std::string& filename) const {
-        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(events_mutex_));
-        std::ofstream file(filename);
-
-        file << "timestamp,signal_id,type,primary_symbol,secondary_symbol,"
-             << "signal_strength,confidence,latency_us\n";
-
-        for (const auto& event : events_) {
-            const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                event.event_time.time_since_epoch()).count();
-            const auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                event.generation_time - event.event_time).count();
-
-            file << timestamp << "," << event.signal_id << "," << event.type_name()
-                 << "," << event.primary_symbol << "," << event.secondary_symbol
-                 << "," << event.signal_strength << "," << event.confidence
-                 << "," << latency_us << "\n";
-        }
     }
 
     [[nodiscard]] uint64_t signal_count() const {
@@ -106,7 +102,7 @@ public:
 
     void print_status(const Router& router, const FeedSimulator& feed_sim,
                      const SignalLogger& signal_logger,
-                     const SPSCQueue<Tick, 65536>& queue) const {
+                     const SPSCQueue<CompactTick, 65536>& queue) const {
 
         const auto now = std::chrono::steady_clock::now();
         const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
@@ -137,12 +133,16 @@ public:
 
         // Queue status
         const auto queue_fill = queue.fill_ratio() * 100.0;
-        std::cout << "║ Queue: " << std::fixed << std::setprecision(1) << queue_fill << "% full"
-                  << "                                                ║\n";
+        const auto& depth = feed_sim.queue_depth();
+        std::cout << "║ Queue: " << std::fixed << std::setprecision(1) << std::setw(5) << queue_fill << "% full"
+                  << " | Depth P99 <= " << std::setw(6) << depth.quantile(0.99)
+                  << " | Max: " << std::setw(6) << depth.max()
+                  << "     ║\n";
 
-        // Router stats
-        const auto ticks_processed = router.ticks_processed();
-        const auto processing_rate = router.processing_rate();
+        // Router stats, one consistent snapshot for the whole panel
+        const RouterSnapshot snapshot = router.snapshot();
+        const auto ticks_processed = snapshot.counters.ticks_processed;
+        const auto processing_rate = snapshot.counters.ticks_per_second();
 
         std::cout << "║ Processed: " << std::setw(8) << ticks_processed << " ticks"
                   << " | Rate: " << std::fixed << std::setprecision(0)
@@ -155,11 +155,11 @@ public:
                   << "                                                   ║\n";
 
         // Latency stats
-        const auto& latency_hist = router.latency_histogram();
-        std::cout << "║ Latency: P50=" << std::fixed << std::setprecision(0)
-                  << latency_hist.p50_us() << "μs | P95=" << latency_hist.p95_us()
-                  << "μs | P99=" << latency_hist.p99_us() << "μs"
-                  << "          ║\n";
+        const auto& latency = snapshot.latency;
+        std::cout << "║ Latency: P50=" << std::fixed << std::setprecision(2)
+                  << latency.percentile_us(50.0) << "μs | P99=" << latency.percentile_us(99.0)
+                  << "μs | P99.9=" << latency.percentile_us(99.9) << "μs"
+                  << "     ║\n";
 
         std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
         std::cout << std::flush;
@@ -183,6 +183,16 @@ int main(int argc, char* argv[]) {
                       << "  --duration N     Run for N seconds (default: 30)\n"
                       << "  --rate N         Tick rate in Hz (default: 2000)\n"
                       << "  --zscore N       Z-score threshold (default: 2.5)\n"
+                      << "  --record-ticks   Record ticks to data/journal for replay\n"
+                      << "  --wait MODE      Consumer idle strategy: spin|yield|block|sleep (default: block)\n"
+                      << "  --consumer-cpu N Pin the consumer thread to CPU N\n"
+                      << "  --feed-cpu N     Pin the feed thread to CPU N\n"
+                      << "  --fifo N         Run the consumer under SCHED_FIFO priority N\n"
+                      << "  --metrics-port N Serve Prometheus metrics at http://127.0.0.1:N/metrics\n"
+                      << "  --trace-out FILE Write a Chrome/Perfetto trace of the last ticks (RT_ENABLE_TRACING builds)\n"
+                      << "  --overload MODE  Full tick queue: drop|conflate (default: drop)\n"
+                      << "  --spin-retries N Retry a full push N times before the overload policy applies\n"
+                      << "  --checkpoint FILE Save rule state to FILE every second; warm start from it if present\n"
                       << "  --help           Show this help\n";
             return 0;
         } else if (arg == "--duration" && i + 1 < argc) {
@@ -191,15 +201,53 @@ int main(int argc, char* argv[]) {
             config.tick_rate_ms = 1000.0 / std::stod(argv[++i]);
         } else if (arg == "--zscore" && i + 1 < argc) {
             config.zscore_threshold = std::stod(argv[++i]);
+        } else if (arg == "--record-ticks") {
+            config.record_ticks = true;
+        } else if (arg == "--wait" && i + 1 < argc) {
+            const auto wait = parse_wait_strategy(argv[++i]);
+            if (!wait) {
+                std::cerr << "Unknown wait strategy: " << argv[i] << "\n";
+                return 1;
+            }
+            config.consumer.wait = *wait;
+        } else if (arg == "--consumer-cpu" && i + 1 < argc) {
+            config.consumer.cpu = std::stoi(argv[++i]);
+        } else if (arg == "--feed-cpu" && i + 1 < argc) {
+            config.feed_cpu = std::stoi(argv[++i]);
+        } else if (arg == "--fifo" && i + 1 < argc) {
+            config.consumer.realtime_priority = std::stoi(argv[++i]);
+        } else if (arg == "--metrics-port" && i + 1 < argc) {
+            config.metrics_port = std::stoi(argv[++i]);
+        } else if (arg == "--trace-out" && i + 1 < argc) {
+            config.trace_out = argv[++i];
+        } else if (arg == "--overload" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode == "drop") {
+                config.overload.policy = OverloadPolicy::DROP;
+            } else if (mode == "conflate") {
+                config.overload.policy = OverloadPolicy::CONFLATE;
+            } else {
+                std::cerr << "Unknown overload policy: " << mode << "\n";
+                return 1;
+            }
+        } else if (arg == "--spin-retries" && i + 1 < argc) {
+            config.overload.spin_retries = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            config.checkpoint_path = argv[++i];
         }
     }
 
     std::cout << "🚀 Starting Real-Time Trading System Demo...\n";
+    std::cout << "Consumer wait strategy: " << wait_strategy_name(config.consumer.wait) << "\n";
     std::cout << "Press Ctrl+C to stop gracefully\n\n";
 
+    // Calibrate the timestamp clock before any worker thread reads it
+    CycleClock::calibrate();
+
     // Initialize components
-    SPSCQueue<Tick, 65536> tick_queue;  // 64K tick buffer
+    SPSCQueue<CompactTick, 65536> tick_queue;  // 64K ticks, 2MB of ring
     SignalLogger signal_logger;
+    SignalDispatcher signal_dispatcher;
     Router router;
     Dashboard dashboard;
 
@@ -207,14 +255,61 @@ int main(int argc, char* argv[]) {
     router.set_zscore_threshold(config.zscore_threshold);
     router.set_correlation_threshold(config.correlation_threshold);
     router.set_volume_threshold(config.volume_threshold);
-    router.set_signal_callback([&signal_logger](const SignalEvent& event) {
+
+    // One signal per regime change rather than one per tick
+    router.set_emission_policy(SignalEvent::Type::Z_SCORE_BREAK, EmissionPolicy::hysteresis(0.5));
+    router.set_emission_policy(SignalEvent::Type::VOLUME_SPIKE, EmissionPolicy::edge());
+    router.set_emission_policy(SignalEvent::Type::PAIR_TRADE_ENTRY, EmissionPolicy::hysteresis(0.5));
+    router.set_emission_policy(SignalEvent::Type::CORRELATION_BREAK, EmissionPolicy::hysteresis(0.05));
+    signal_dispatcher.add_sink([&signal_logger](const SignalEvent& event) {
         signal_logger.log_signal(event);
     });
 
+    // Signals stream to a binary journal as they arrive; data/signals.csv is
+    // converted from it at shutdown
+    JournalConfig journal_config;
+    journal_config.prefix = "signals";
+    SignalJournal signal_journal(journal_config);
+    if (config.enable_csv_output) {
+        signal_journal.start();
+        signal_dispatcher.add_sink([&signal_journal](const SignalEvent& event) {
+            signal_journal.append(SignalRecord::from(event));
+        });
+    }
+    router.set_signal_dispatcher(&signal_dispatcher);
+    signal_dispatcher.start();
+
+    // All rule state is allocated here, before the feed starts
+    router.reserve(config.symbols.size(), 2);
+    for (const auto& symbol : config.symbols) {
+        router.add_symbol(symbol);
+    }
+
+    if (!config.trace_out.empty() && !router.enable_trace(TRACE_CAPACITY)) {
+        std::cerr << "--trace-out needs a build with -DRT_ENABLE_TRACING=ON; no trace will be written\n";
+    }
+
     // Add correlation pairs
     router.add_watched_pair("AAPL", "MSFT");
     router.add_watched_pair("GOOGL", "TSLA");
 
+    // Warm start: rule windows and pair statistics from the last run
+    if (!config.checkpoint_path.empty() && std::filesystem::exists(config.checkpoint_path)) {
+        try {
+            const auto load_start = std::chrono::steady_clock::now();
+            const CheckpointMapping mapping(config.checkpoint_path);
+            const CheckpointRestore restored = router.restore(mapping.bytes());
+            const std::chrono::duration<double, std::milli> load_time =
+                std::chrono::steady_clock::now() - load_start;
+            std::cout << "♻️  Restored " << restored.symbols << " symbols and " << restored.pairs
+                      << " pairs from " << config.checkpoint_path << " in " << std::fixed
+                      << std::setprecision(2) << load_time.count() << " ms\n";
+        } catch (const std::exception& e) {
+            router.reset_stats();
+            std::cerr << "Ignoring checkpoint: " << e.what() << "\n";
+        }
+    }
+
     // Create symbol configurations
     std::vector<SymbolConfig> symbol_configs;
     for (const auto& symbol : config.symbols) {
@@ -226,26 +321,99 @@ int main(int argc, char* argv[]) {
                           PriceModel::GEOMETRIC_BROWNIAN_MOTION,
                           config.tick_rate_ms);
 
-    // Start feed simulator thread
-    std::thread feed_thread([&feed_sim, &tick_queue]() {
+    // The watched pairs move together, so correlation breaks are real events
+    feed_sim.set_pair_correlation("AAPL", "MSFT", 0.8);
+    feed_sim.set_pair_correlation("GOOGL", "TSLA", 0.7);
+
+    // Count excursions above the queue's high-water mark (feed thread)
+    std::atomic<uint64_t> high_water_events{0};
+    config.overload.on_pressure = [&high_water_events](bool high, std::size_t) {
+        if (high) high_water_events.fetch_add(1, std::memory_order_relaxed);
+    };
+    feed_sim.set_overload_config(config.overload);
+
+    // Optional tick recording, replayable later with ReplayFeed
+    JournalConfig tick_journal_config;
+    tick_journal_config.prefix = "ticks";
+    TickJournal tick_journal(tick_journal_config);
+    if (config.record_ticks) {
+        tick_journal.start();
+    }
+
+    // Periodic checkpoints: the consumer snapshots the rules between ticks
+    // and the writer thread does the disk I/O
+    std::unique_ptr<CheckpointWriter> checkpoint_writer;
+    if (!config.checkpoint_path.empty()) {
+        checkpoint_writer = std::make_unique<CheckpointWriter>(config.checkpoint_path);
+    }
+    std::vector<std::byte> checkpoint_image;
+    uint64_t checkpoint_countdown = CHECKPOINT_CHECK_TICKS;
+    auto next_checkpoint = std::chrono::steady_clock::now() + CHECKPOINT_INTERVAL;
+
+    // Start consumer thread
+    auto on_tick = [&router, &tick_journal, &codec = feed_sim.codec(),
+                    record = config.record_ticks, writer = checkpoint_writer.get(),
+                    &checkpoint_image, &checkpoint_countdown, &next_checkpoint](const CompactTick& compact) {
+        const Tick tick = codec.decode(compact);
+        router.process_tick(tick);
+        if (record) tick_journal.append(TickRecord::from(tick));
+        if (writer && --checkpoint_countdown == 0) {
+            checkpoint_countdown = CHECKPOINT_CHECK_TICKS;
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= next_checkpoint) {
+                next_checkpoint = now + CHECKPOINT_INTERVAL;
+                router.checkpoint(checkpoint_image);
+                writer->submit(checkpoint_image);
+            }
+        }
+    };
+    ConsumerRunner consumer(tick_queue, on_tick, config.consumer);
+    consumer.start();
+
+    // Start feed simulator thread, one step per tick interval on an absolute
+    // schedule so processing time does not stretch the period
+    std::thread feed_thread([&feed_sim, &tick_queue, &consumer, &config]() {
+        if (config.feed_cpu >= 0 && !pin_current_thread(static_cast<unsigned>(config.feed_cpu))) {
+            std::cerr << "Could not pin feed thread to CPU " << config.feed_cpu << "\n";
+        }
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(config.tick_rate_ms));
+        auto next = std::chrono::steady_clock::now();
         while (g_running.load(std::memory_order_acquire)) {
             feed_sim.generate_ticks(tick_queue);
-            std::this_thread::sleep_for(std::chrono::microseconds(
-                static_cast<int>(feed_sim.symbols()[0].tick_size * 1000)));
+            consumer.wake_signal().notify();
+            next += period;
+            wait_until(next, config.consumer.wait);
         }
     });
 
-    // Start consumer thread
-    std::thread consumer_thread([&router, &tick_queue]() {
-        Tick tick;
-        while (g_running.load(std::memory_order_acquire)) {
-            if (tick_queue.pop(tick)) {
-                router.process_tick(tick);
-            } else {
-                std::this_thread::sleep_for(std::chrono::microseconds(10));
-            }
+    // Metrics endpoint for Prometheus and the Streamlit dashboards
+    MetricsServerConfig metrics_config;
+    metrics_config.port = static_cast<uint16_t>(std::max(config.metrics_port, 0));
+    MetricsHttpServer metrics_server([&]() {
+        std::ostringstream out;
+        write_prometheus(out, router.snapshot());
+        write_prometheus_gauge(out, "rt_tick_queue_fill_ratio", "Tick queue occupancy", tick_queue.fill_ratio());
+        write_prometheus_gauge(out, "rt_feed_ticks_dropped", "Ticks the feed could not enqueue",
+                               static_cast<double>(feed_sim.ticks_dropped()));
+        write_prometheus_gauge(out, "rt_feed_ticks_conflated", "Parked ticks replaced by a newer one",
+                               static_cast<double>(feed_sim.overload().ticks_conflated()));
+        write_prometheus_gauge(out, "rt_tick_queue_depth_p99", "Upper bound of the sampled queue depth P99",
+                               static_cast<double>(feed_sim.queue_depth().quantile(0.99)));
+        write_prometheus_gauge(out, "rt_tick_queue_high_water_events", "Crossings of the queue high-water mark",
+                               static_cast<double>(high_water_events.load(std::memory_order_relaxed)));
+        write_prometheus_gauge(out, "rt_signals_dropped", "Signals dropped by the dispatcher and journal",
+                               static_cast<double>(signal_dispatcher.dropped() + signal_journal.records_dropped()));
+        return out.str();
+    }, metrics_config);
+    if (config.metrics_port >= 0) {
+        try {
+            metrics_server.start();
+            std::cout << "📈 Metrics at http://127.0.0.1:" << metrics_server.port() << "/metrics\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
         }
-    });
+    }
 
     // Live dashboard display
     std::thread dashboard_thread([&]() {
@@ -259,12 +427,17 @@ int main(int argc, char* argv[]) {
 
     // Run for specified duration or until interrupted
     const auto start_time = std::chrono::steady_clock::now();
+    auto next_reanchor = start_time + REANCHOR_INTERVAL;
     while (g_running.load(std::memory_order_acquire)) {
-        const auto elapsed = std::chrono::steady_clock::now() - start_time;
-        if (elapsed >= config.duration) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - start_time >= config.duration) {
             std::cout << "\n⏰ Time limit reached, shutting down...\n";
             break;
         }
+        if (now >= next_reanchor) {
+            CycleClock::reanchor();
+            next_reanchor = now + REANCHOR_INTERVAL;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
@@ -272,9 +445,35 @@ int main(int argc, char* argv[]) {
     g_running.store(false, std::memory_order_release);
 
     // Wait for threads to finish
+    metrics_server.stop();
     if (feed_thread.joinable()) feed_thread.join();
-    if (consumer_thread.joinable()) consumer_thread.join();
+    consumer.stop();
+    if (config.consumer.cpu >= 0 && !consumer.pinned()) {
+        std::cerr << "Could not pin consumer thread to CPU " << config.consumer.cpu << "\n";
+    }
+    if (config.consumer.realtime_priority > 0 && !consumer.realtime()) {
+        std::cerr << "SCHED_FIFO refused for the consumer thread (needs CAP_SYS_NICE)\n";
+    }
     if (dashboard_thread.joinable()) dashboard_thread.join();
+    signal_dispatcher.stop();
+    signal_journal.stop();
+    tick_journal.stop();
+
+    // Final checkpoint of the stopped Router, written synchronously
+    if (checkpoint_writer) {
+        checkpoint_writer->stop();
+        try {
+            router.checkpoint(checkpoint_image);
+            write_checkpoint_file(config.checkpoint_path, checkpoint_image);
+            std::cout << "💾 Checkpoint (" << checkpoint_image.size() << " bytes) saved to "
+                      << config.checkpoint_path << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+        }
+        if (checkpoint_writer->failures() > 0) {
+            std::cerr << "Checkpoint writes failed: " << checkpoint_writer->last_error() << "\n";
+        }
+    }
 
     // Final statistics
     std::cout << "\n╔══════════════════════════════════════════════════════════════╗\n";
@@ -284,20 +483,52 @@ int main(int argc, char* argv[]) {
     const auto& latency_hist = router.latency_histogram();
     std::cout << "║ Total Ticks Processed: " << std::setw(10) << router.ticks_processed() << "                    ║\n";
     std::cout << "║ Total Signals:         " << std::setw(10) << signal_logger.signal_count() << "                    ║\n";
+    std::cout << "║ Signals Dropped:       " << std::setw(10) << (signal_dispatcher.dropped() + signal_journal.records_dropped()) << "                    ║\n";
     std::cout << "║ Average Rate:           " << std::setw(8) << std::fixed << std::setprecision(0)
               << router.processing_rate() << " TPS               ║\n";
     std::cout << "║ Queue Drop Rate:        " << std::setw(8) << std::fixed << std::setprecision(2)
               << feed_sim.drop_rate() * 100.0 << "%                 ║\n";
+    std::cout << "║ Ticks Conflated:       " << std::setw(10) << feed_sim.overload().ticks_conflated() << "                    ║\n";
+    std::cout << "║ Queue Depth P99/Max:   " << std::setw(10) << feed_sim.queue_depth().quantile(0.99)
+              << " / " << std::setw(6) << feed_sim.queue_depth().max() << "           ║\n";
+    std::cout << "║ High-Water Events:     " << std::setw(10) << high_water_events.load() << "                    ║\n";
+    std::cout << "║ Consumer Parks:        " << std::setw(10) << consumer.parks() << "                    ║\n";
+    if (checkpoint_writer) {
+        std::cout << "║ Checkpoints Written:   " << std::setw(10) << checkpoint_writer->checkpoints_written()
+                  << "                    ║\n";
+    }
     std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
 
     // Print latency histogram
     std::cout << "\n";
     latency_hist.print_histogram(std::cout);
 
+    // Where the time goes inside process_tick (tracing builds only)
+    if (const StageProfiler* stages = router.stage_profiler()) {
+        std::cout << "\nStage latency (ns)      P50        P99      P99.9        Max\n";
+        for (std::size_t i = 0; i < TRACE_STAGE_COUNT; ++i) {
+            const auto stage = static_cast<TraceStage>(i);
+            const LatencyHistogram& hist = stages->histogram(stage);
+            std::cout << "  " << std::left << std::setw(14) << trace_stage_name(stage) << std::right
+                      << std::setw(11) << hist.percentile_ns(50.0) << std::setw(11) << hist.percentile_ns(99.0)
+                      << std::setw(11) << hist.percentile_ns(99.9) << std::setw(11) << hist.max_latency_ns() << "\n";
+        }
+        if (!config.trace_out.empty() && stages->trace()) {
+            std::ofstream trace_file(config.trace_out);
+            const auto events = stages->trace()->events();
+            write_chrome_trace(trace_file, events);
+            std::cout << "🔍 " << events.size() << " stage spans written to " << config.trace_out << "\n";
+        }
+    }
+
     // Export CSV files
     if (config.enable_csv_output) {
         std::cout << "\n📊 Exporting data...\n";
-        signal_logger.export_csv("data/signals.csv");
+        if (signal_journal.failed()) {
+            std::cerr << "Signal journal failed: " << signal_journal.error() << "\n";
+        }
+        std::ofstream signals_file("data/signals.csv");
+        write_signal_journal_csv(signal_journal.files(), signals_file);
 
         // Export latency histogram
         std::ofstream latency_file("data/latency_histogram.csv");
@@ -0,0 +1,258 @@
+#pragma once
+#include "engine/router.hpp"
+#include "engine/signal_gate.hpp"
+#include "md/feed_sim.hpp"
+#include "md/replay_feed.hpp"
+#include "md/tick.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// One Router configuration to evaluate
+struct BacktestParams {
+    double zscore_threshold{2.5};
+    double correlation_threshold{0.3};
+    double volume_threshold{3.0};
+    std::size_t zscore_window{ZScoreRule::DEFAULT_WINDOW};
+    std::size_t volume_window{VolumeRule::DEFAULT_WINDOW};
+    EmissionPolicies emission_policies{};  // LEVEL for every signal type
+};
+
+struct BacktestResult {
+    BacktestParams params;
+    uint64_t ticks_processed{0};
+    uint64_t signals{0};
+    std::array<uint64_t, SIGNAL_TYPE_COUNT> signals_by_type{};
+    double mean_abs_strength{0.0};
+    double max_abs_strength{0.0};
+    double mean_confidence{0.0};
+    std::chrono::nanoseconds elapsed{0};  // Wall time of this configuration's pass
+
+    [[nodiscard]] uint64_t count(SignalEvent::Type type) const noexcept {
+        return signals_by_type[signal_type_index(type)];
+    }
+
+    [[nodiscard]] double signals_per_1k_ticks() const noexcept {
+        return ticks_processed > 0 ? 1000.0 * static_cast<double>(signals) / ticks_processed : 0.0;
+    }
+};
+
+struct BacktestConfig {
+    unsigned threads{0};  // 0: one per hardware thread
+};
+
+// Sink that keeps every tick pushed into it: the queue FeedSimulator and
+// ReplayFeed write into when collecting a stream for BacktestRunner
+class TickRecorder {
+public:
+    using value_type = Tick;
+
+    std::vector<Tick> ticks;
+
+    bool push(Tick&& tick) {
+        ticks.push_back(std::move(tick));
+        return true;
+    }
+
+    std::size_t try_push_n(const Tick* batch, std::size_t n) {
+        ticks.insert(ticks.end(), batch, batch + n);
+        return n;
+    }
+};
+
+// steps steps of feed, one tick per symbol each. Ticks are stamped on a
+// simulated clock advancing by step_ms per step from the first stamp, so
+// time-based emission policies see the simulated rate rather than how fast
+// the generator ran.
+[[nodiscard]] inline std::vector<Tick> simulate_ticks(FeedSimulator& feed, std::size_t steps, double step_ms) {
+    TickRecorder recorder;
+    recorder.ticks.reserve(steps * feed.symbols().size());
+    for (std::size_t step = 0; step < steps; ++step) {
+        feed.generate_ticks(recorder);
+    }
+
+    if (!recorder.ticks.empty()) {
+        const auto origin = recorder.ticks.front().timestamp;
+        const std::size_t per_step = feed.symbols().size();
+        for (std::size_t i = 0; i < recorder.ticks.size(); ++i) {
+            const auto offset = std::chrono::duration<double, std::milli>(step_ms * static_cast<double>(i / per_step));
+            recorder.ticks[i].timestamp = origin + std::chrono::duration_cast<TickClock::duration>(offset);
+        }
+    }
+    return std::move(recorder.ticks);
+}
+
+// Every tick of replay, in order. Build the ReplayFeed with
+// ReplayTimestamps::RECORDED to keep the recorded spacing.
+[[nodiscard]] inline std::vector<Tick> replay_ticks(ReplayFeed& replay) {
+    TickRecorder recorder;
+    recorder.ticks.reserve(replay.total_ticks());
+    const std::atomic<bool> running{true};
+    replay.run(recorder, running);
+    return std::move(recorder.ticks);
+}
+
+// Parameter sweep over one tick stream. Each configuration runs the whole
+// stream through its own Router on a worker thread; the ticks are shared
+// read-only, so a sweep costs one pass per configuration at Router speed
+// instead of one wall-clock run each. Workers take configurations from a
+// shared counter and write to their own result slot, so results come back
+// in input order and do not depend on the thread count.
+class BacktestRunner {
+private:
+    std::vector<Tick> ticks_;
+    std::vector<SymbolId> symbols_;  // Distinct ids in ticks_, pre-registered on every Router
+    std::vector<std::pair<SymbolId, SymbolId>> watched_pairs_;
+    unsigned threads_;
+
+public:
+    explicit BacktestRunner(std::vector<Tick> ticks, BacktestConfig config = {})
+        : ticks_(std::move(ticks))
+        , threads_(config.threads > 0 ? config.threads
+                                      : std::max(1u, std::thread::hardware_concurrency())) {
+        // Ids are dense, so one bit per id finds the distinct ones in one pass
+        std::vector<bool> seen(SymbolTable::size());
+        for (const Tick& tick : ticks_) {
+            const SymbolId symbol = tick.symbol_id;
+            if (symbol == INVALID_SYMBOL_ID) continue;
+            if (symbol >= seen.size()) seen.resize(symbol + 1);
+            if (!seen[symbol]) {
+                seen[symbol] = true;
+                symbols_.push_back(symbol);
+            }
+        }
+    }
+
+    // Watched on every configuration
+    void add_watched_pair(const std::string& symbol1, const std::string& symbol2) {
+        add_watched_pair(SymbolTable::intern_id(symbol1), SymbolTable::intern_id(symbol2));
+    }
+
+    void add_watched_pair(SymbolId symbol1, SymbolId symbol2) {
+        if (symbol1 == INVALID_SYMBOL_ID || symbol2 == INVALID_SYMBOL_ID || symbol1 == symbol2) {
+            throw std::invalid_argument("BacktestRunner::add_watched_pair: need two distinct symbols");
+        }
+        watched_pairs_.emplace_back(symbol1, symbol2);
+    }
+
+    // Evaluate every configuration; results[i] belongs to grid[i]. An
+    // exception from a worker is rethrown here after all workers stop.
+    [[nodiscard]] std::vector<BacktestResult> run(std::span<const BacktestParams> grid) const {
+        std::vector<BacktestResult> results(grid.size());
+        const unsigned threads = static_cast<unsigned>(
+            std::min<std::size_t>(threads_, std::max<std::size_t>(1, grid.size())));
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+
+        auto work = [&]() {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < grid.size();
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                if (failed.load(std::memory_order_relaxed)) return;
+                try {
+                    results[i] = run_one(grid[i]);
+                } catch (...) {
+                    if (!failed.exchange(true)) error = std::current_exception();
+                    return;
+                }
+            }
+        };
+
+        if (threads == 1) {
+            work();
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            for (unsigned w = 0; w < threads; ++w) {
+                workers.emplace_back(work);
+            }
+            for (auto& worker : workers) worker.join();
+        }
+
+        if (error) std::rethrow_exception(error);
+        return results;
+    }
+
+    // One configuration on the calling thread
+    [[nodiscard]] BacktestResult run_one(const BacktestParams& params) const {
+        BacktestResult result;
+        result.params = params;
+        double strength_sum = 0.0;
+        double confidence_sum = 0.0;
+
+        Router router;
+        router.set_zscore_threshold(params.zscore_threshold);
+        router.set_correlation_threshold(params.correlation_threshold);
+        router.set_volume_threshold(params.volume_threshold);
+        router.set_zscore_window(params.zscore_window);
+        router.set_volume_window(params.volume_window);
+        for (std::size_t t = 0; t < SIGNAL_TYPE_COUNT; ++t) {
+            router.set_emission_policy(static_cast<SignalEvent::Type>(t), params.emission_policies[t]);
+        }
+        router.reserve(symbols_.size(), watched_pairs_.size());
+        for (SymbolId symbol : symbols_) {
+            router.add_symbol(symbol);
+        }
+        for (const auto& [first, second] : watched_pairs_) {
+            router.add_watched_pair(first, second);
+        }
+        router.set_signal_callback([&](const SignalEvent& event) {
+            const double strength = std::abs(event.signal_strength);
+            ++result.signals;
+            ++result.signals_by_type[signal_type_index(event.event_type)];
+            strength_sum += strength;
+            confidence_sum += event.confidence;
+            result.max_abs_strength = std::max(result.max_abs_strength, strength);
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const Tick& tick : ticks_) {
+            router.process_tick(tick);
+        }
+        result.elapsed = std::chrono::steady_clock::now() - start;
+
+        result.ticks_processed = router.ticks_processed();
+        if (result.signals > 0) {
+            result.mean_abs_strength = strength_sum / static_cast<double>(result.signals);
+            result.mean_confidence = confidence_sum / static_cast<double>(result.signals);
+        }
+        return result;
+    }
+
+    // Cartesian product of the three thresholds, other fields from base;
+    // the volume threshold varies fastest
+    [[nodiscard]] static std::vector<BacktestParams> grid(std::span<const double> zscore_thresholds,
+                                                          std::span<const double> correlation_thresholds,
+                                                          std::span<const double> volume_thresholds,
+                                                          const BacktestParams& base = {}) {
+        std::vector<BacktestParams> params;
+        params.reserve(zscore_thresholds.size() * correlation_thresholds.size() * volume_thresholds.size());
+        for (double zscore : zscore_thresholds) {
+            for (double correlation : correlation_thresholds) {
+                for (double volume : volume_thresholds) {
+                    BacktestParams p = base;
+                    p.zscore_threshold = zscore;
+                    p.correlation_threshold = correlation;
+                    p.volume_threshold = volume;
+                    params.push_back(p);
+                }
+            }
+        }
+        return params;
+    }
+
+    [[nodiscard]] const std::vector<Tick>& ticks() const noexcept { return ticks_; }
+    [[nodiscard]] const std::vector<SymbolId>& symbols() const noexcept { return symbols_; }
+    [[nodiscard]] unsigned threads() const noexcept { return threads_; }
+};
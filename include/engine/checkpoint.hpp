@@ -0,0 +1,155 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Binary image of the Router's rule statistics for warm restarts.
+//
+// Layout: one 64-byte CheckpointHeader, then the payload: per symbol its
+// name, tick count and rule pipeline state; per watched pair both names and
+// the correlation rule's state. Symbols are stored by name, so an image
+// restores into another process's SymbolTable. Values are in native byte
+// order: images move between restarts of one build, not across platforms.
+// CHECKPOINT_VERSION changes whenever the payload layout does.
+
+inline constexpr char CHECKPOINT_MAGIC[8] = {'R', 'T', 'C', 'K', 'P', 'T', '\0', '\0'};
+inline constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t symbol_count;
+    uint32_t pair_count;
+    uint64_t payload_bytes;
+    uint64_t checksum;          // FNV-1a over the payload
+    int64_t wall_clock_ns;      // system_clock when taken
+    char reserved[16];
+};
+static_assert(sizeof(CheckpointHeader) == 64 && std::is_trivially_copyable_v<CheckpointHeader>);
+
+[[nodiscard]] inline uint64_t fnv1a_64(std::span<const std::byte> bytes) noexcept {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::byte b : bytes) {
+        hash ^= static_cast<uint64_t>(b);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// What Router::restore() found in an image
+struct CheckpointRestore {
+    uint32_t symbols{0};
+    uint32_t pairs{0};
+    uint32_t pairs_skipped{0};  // Not watched by this Router
+};
+
+// Appends values to an image; the save() side of the stats and rule classes
+class CheckpointOut {
+private:
+    std::vector<std::byte>& bytes_;
+
+public:
+    explicit CheckpointOut(std::vector<std::byte>& bytes) noexcept : bytes_(bytes) {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void put(const T& value) {
+        const std::size_t offset = bytes_.size();
+        bytes_.resize(offset + sizeof(T));
+        std::memcpy(bytes_.data() + offset, &value, sizeof(T));
+    }
+
+    void put_string(std::string_view text) {
+        if (text.size() > UINT16_MAX) throw std::invalid_argument("Checkpoint string too long");
+        put(static_cast<uint16_t>(text.size()));
+        const std::size_t offset = bytes_.size();
+        bytes_.resize(offset + text.size());
+        std::memcpy(bytes_.data() + offset, text.data(), text.size());
+    }
+};
+
+// Bounds-checked reader over an image's payload; the load() side. Throws
+// std::runtime_error when the payload ends early.
+class CheckpointIn {
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t offset_{0};
+
+public:
+    explicit CheckpointIn(std::span<const std::byte> bytes) noexcept : bytes_(bytes) {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    [[nodiscard]] T get() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    [[nodiscard]] std::string_view get_string() {
+        const std::size_t size = get<uint16_t>();
+        require(size);
+        const std::string_view text(reinterpret_cast<const char*>(bytes_.data() + offset_), size);
+        offset_ += size;
+        return text;
+    }
+
+    [[nodiscard]] bool done() const noexcept { return offset_ == bytes_.size(); }
+
+private:
+    void require(std::size_t size) const {
+        if (bytes_.size() - offset_ < size) throw std::runtime_error("Checkpoint payload is truncated");
+    }
+};
+
+// Start an image: clears bytes and reserves the header
+inline void begin_checkpoint(std::vector<std::byte>& bytes) {
+    bytes.assign(sizeof(CheckpointHeader), std::byte{0});
+}
+
+// Fill in the header once the payload is written
+inline void finish_checkpoint(std::vector<std::byte>& bytes, uint32_t symbols, uint32_t pairs) {
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.header_size = sizeof(CheckpointHeader);
+    header.symbol_count = symbols;
+    header.pair_count = pairs;
+    header.payload_bytes = bytes.size() - sizeof(CheckpointHeader);
+    header.checksum = fnv1a_64(std::span<const std::byte>(bytes).subspan(sizeof(CheckpointHeader)));
+    header.wall_clock_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(bytes.data(), &header, sizeof(header));
+}
+
+// Validate an image and return its header; throws std::runtime_error on a
+// foreign file, another version, a torn write or a checksum mismatch
+[[nodiscard]] inline CheckpointHeader read_checkpoint_header(std::span<const std::byte> bytes) {
+    CheckpointHeader header;
+    if (bytes.size() < sizeof(header)) throw std::runtime_error("Checkpoint is truncated");
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a checkpoint image");
+    }
+    if (header.version != CHECKPOINT_VERSION || header.header_size != sizeof(CheckpointHeader)) {
+        throw std::runtime_error("Checkpoint version " + std::to_string(header.version) +
+                                 " is not supported (expected " + std::to_string(CHECKPOINT_VERSION) + ")");
+    }
+    if (header.payload_bytes != bytes.size() - sizeof(header)) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+    if (header.checksum != fnv1a_64(bytes.subspan(sizeof(header)))) {
+        throw std::runtime_error("Checkpoint checksum mismatch");
+    }
+    return header;
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include "util/thread_affinity.hpp"
+#include "util/wait_strategy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+struct ConsumerConfig {
+    WaitStrategy wait{WaitStrategy::BLOCKING};
+    uint32_t spin_iterations{2000};                 // Empty polls before yielding/parking
+    std::chrono::microseconds sleep_interval{10};   // SLEEP only
+    int cpu{-1};                                    // Pin to this CPU; -1 leaves it floating
+    int realtime_priority{0};                       // > 0: SCHED_FIFO at this priority
+};
+
+// Owns the consumer thread of a tick queue: drains it into handler(item) and
+// idles between bursts according to ConsumerConfig::wait.
+//
+// With WaitStrategy::BLOCKING the thread parks on wake_signal(), so producers
+// must call wake_signal().notify() after pushing. The other strategies poll
+// and need no cooperation.
+template <typename Queue, typename Handler>
+class ConsumerRunner {
+private:
+    Queue& queue_;
+    Handler handler_;
+    ConsumerConfig config_;
+    WakeSignal wake_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> pinned_{false};
+    std::atomic<bool> realtime_{false};
+
+    alignas(64) std::atomic<uint64_t> items_consumed_{0};
+    std::atomic<uint64_t> parks_{0};
+
+public:
+    ConsumerRunner(Queue& queue, Handler handler, ConsumerConfig config = {})
+        : queue_(queue)
+        , handler_(std::move(handler))
+        , config_(config) {}
+
+    ~ConsumerRunner() { stop(); }
+
+    ConsumerRunner(const ConsumerRunner&) = delete;
+    ConsumerRunner& operator=(const ConsumerRunner&) = delete;
+
+    void start() {
+        if (running_.exchange(true, std::memory_order_acq_rel)) return;
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    // Stops after draining what is already queued
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+        wake_.wake();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    [[nodiscard]] WakeSignal& wake_signal() noexcept { return wake_; }
+
+    // Statistics
+    [[nodiscard]] uint64_t items_consumed() const noexcept {
+        return items_consumed_.load(std::memory_order_acquire);
+    }
+
+    // Times the thread parked (BLOCKING) or went idle past the spin phase
+    [[nodiscard]] uint64_t parks() const noexcept {
+        return parks_.load(std::memory_order_acquire);
+    }
+
+    // Whether the requested placement took effect (valid once started)
+    [[nodiscard]] bool pinned() const noexcept { return pinned_.load(std::memory_order_acquire); }
+    [[nodiscard]] bool realtime() const noexcept { return realtime_.load(std::memory_order_acquire); }
+
+private:
+    void run() {
+        if (config_.cpu >= 0) {
+            pinned_.store(pin_current_thread(static_cast<unsigned>(config_.cpu)), std::memory_order_release);
+        }
+        if (config_.realtime_priority > 0) {
+            realtime_.store(set_current_thread_realtime(config_.realtime_priority),
+                            std::memory_order_release);
+        }
+
+        uint32_t idle = 0;
+        while (running_.load(std::memory_order_acquire)) {
+            const std::size_t n = drain();
+            if (n > 0) {
+                idle = 0;
+            } else {
+                idle_wait(idle);
+                if (idle < UINT32_MAX) ++idle;
+            }
+        }
+
+        // Everything pushed before stop()
+        while (drain() > 0) {}
+    }
+
+    std::size_t drain() {
+        const std::size_t n = queue_.consume_all(handler_);
+        if (n > 0) items_consumed_.fetch_add(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    void idle_wait(uint32_t idle) {
+        switch (config_.wait) {
+            case WaitStrategy::BUSY_SPIN:
+                cpu_relax();
+                break;
+
+            case WaitStrategy::SPIN_YIELD:
+                if (idle < config_.spin_iterations) {
+                    cpu_relax();
+                } else {
+                    if (idle == config_.spin_iterations) parks_.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                }
+                break;
+
+            case WaitStrategy::BLOCKING:
+                if (idle < config_.spin_iterations) {
+                    cpu_relax();
+                } else {
+                    parks_.fetch_add(1, std::memory_order_relaxed);
+                    wake_.wait([this]() {
+                        return !queue_.empty() || !running_.load(std::memory_order_acquire);
+                    });
+                }
+                break;
+
+            case WaitStrategy::SLEEP:
+                std::this_thread::sleep_for(config_.sleep_interval);
+                break;
+        }
+    }
+};
@@ -0,0 +1,188 @@
+#pragma once
+#include "md/tick.hpp"
+#include "stats/covariance_matrix.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct CorrelationMatrixConfig {
+    TickClock::duration sample_interval{std::chrono::milliseconds(100)};
+    std::size_t fast_window{64};        // Samples; the correlations ranked
+    std::size_t reference_window{512};  // Samples; what they are compared to (0: no reference)
+    // Samples per blocked matrix update, at most CorrelationMatrixEngine::MAX_BATCH.
+    // The tick that fills a batch pays for the whole update inline, O(n^2 *
+    // batch) per matrix: about 1.6ms per matrix at 1000 symbols and batch 16
+    // (rt_bench). Smaller batches mean shorter stalls but less cache reuse.
+    std::size_t batch{16};
+};
+
+// top_decorrelating() result with the universe's symbols resolved
+struct DecorrelatingPair {
+    SymbolId first{INVALID_SYMBOL_ID};
+    SymbolId second{INVALID_SYMBOL_ID};
+    double correlation{0.0};
+    double reference_correlation{0.0};
+};
+
+// All-pairs correlation over a fixed universe of symbols, for basket and
+// stat-arb strategies where one CorrelationBreakRule per watched pair does
+// not scale (N symbols are N(N-1)/2 pairs).
+//
+// on_tick() only records the latest price. Every sample_interval of tick
+// time, once every symbol has traded, the latest prices form a synchronized
+// snapshot; its log returns since the previous snapshot are queued and
+// applied to the matrices batch samples at a time (one blocked pass each).
+// Two EMACovarianceMatrix run side by side: fast_window samples, ranked by
+// top_decorrelating(), against reference_window samples.
+//
+// Single-threaded: call everything from the thread feeding ticks (or give it
+// to Router::set_correlation_matrix() and query after the consumer stops).
+class CorrelationMatrixEngine {
+public:
+    static constexpr std::size_t MAX_BATCH = 64;  // Past this, longer stalls buy no more cache reuse
+
+private:
+    static constexpr int32_t NOT_IN_UNIVERSE = -1;
+
+    CorrelationMatrixConfig config_;
+    std::vector<SymbolId> universe_;
+    std::vector<int32_t> slot_of_;  // SymbolId -> row, NOT_IN_UNIVERSE outside it
+    std::vector<double> latest_;
+    std::vector<double> previous_;  // Prices of the last snapshot
+    std::vector<double> pending_;   // batch rows of log returns
+    std::size_t pending_rows_{0};
+    std::size_t priced_{0};         // Symbols with a price so far
+    bool has_previous_{false};
+    TickClock::time_point next_sample_{};
+    uint64_t samples_{0};
+    EMACovarianceMatrix fast_;
+    std::optional<EMACovarianceMatrix> reference_;  // Only with a reference_window
+
+    static std::size_t check_universe(std::span<const SymbolId> universe, const CorrelationMatrixConfig& config) {
+        if (universe.size() < 2) throw std::invalid_argument("Correlation matrix needs at least two symbols");
+        if (config.fast_window == 0) throw std::invalid_argument("Correlation window must be positive");
+        if (config.batch == 0 || config.batch > MAX_BATCH) {
+            throw std::invalid_argument("Correlation batch must be in [1, " + std::to_string(MAX_BATCH) + "]");
+        }
+        if (config.sample_interval <= TickClock::duration::zero()) {
+            throw std::invalid_argument("Correlation sample interval must be positive");
+        }
+        return universe.size();
+    }
+
+    void sample() {
+        if (priced_ < universe_.size()) return;
+        if (has_previous_) {
+            double* row = pending_.data() + pending_rows_ * universe_.size();
+            for (std::size_t i = 0; i < universe_.size(); ++i) {
+                row[i] = std::log(latest_[i] / previous_[i]);
+            }
+            ++samples_;
+            if (++pending_rows_ == config_.batch) flush();
+        }
+        previous_ = latest_;
+        has_previous_ = true;
+    }
+
+public:
+    CorrelationMatrixEngine(std::span<const SymbolId> universe, const CorrelationMatrixConfig& config = {})
+        : config_(config)
+        , universe_(universe.begin(), universe.end())
+        , latest_(check_universe(universe, config), 0.0)
+        , previous_(universe.size(), 0.0)
+        , pending_(universe.size() * config.batch, 0.0)
+        , fast_(universe.size(), config.fast_window) {
+        if (config.reference_window > 0) reference_.emplace(universe.size(), config.reference_window);
+        for (std::size_t i = 0; i < universe_.size(); ++i) {
+            const SymbolId symbol = universe_[i];
+            if (symbol == INVALID_SYMBOL_ID) throw std::invalid_argument("Invalid symbol in correlation universe");
+            if (symbol >= slot_of_.size()) slot_of_.resize(symbol + 1, NOT_IN_UNIVERSE);
+            if (slot_of_[symbol] != NOT_IN_UNIVERSE) {
+                throw std::invalid_argument("Duplicate symbol in correlation universe: " +
+                                            std::string(SymbolTable::name(symbol)));
+            }
+            slot_of_[symbol] = static_cast<int32_t>(i);
+        }
+    }
+
+    // A tick at or past the next sample time first closes the snapshot (the
+    // prices before it). Any tick advances time; only universe symbols with a
+    // positive price update it.
+    void on_tick(const Tick& tick) {
+        if (tick.timestamp >= next_sample_) {
+            // The first tick sets the grid; skipped intervals are not back-filled
+            next_sample_ = tick.timestamp + config_.sample_interval;
+            sample();
+        }
+
+        const SymbolId symbol = tick.symbol_id;
+        if (symbol >= slot_of_.size() || slot_of_[symbol] == NOT_IN_UNIVERSE) return;
+        if (!(tick.last_price > 0.0)) return;
+
+        const auto slot = static_cast<std::size_t>(slot_of_[symbol]);
+        if (latest_[slot] == 0.0) ++priced_;
+        latest_[slot] = tick.last_price;
+    }
+
+    // Apply queued samples now rather than when the batch fills
+    void flush() {
+        if (pending_rows_ == 0) return;
+        fast_.update_batch(pending_.data(), pending_rows_);
+        if (reference_) reference_->update_batch(pending_.data(), pending_rows_);
+        pending_rows_ = 0;
+    }
+
+    void reset() {
+        std::fill(latest_.begin(), latest_.end(), 0.0);
+        pending_rows_ = 0;
+        priced_ = 0;
+        has_previous_ = false;
+        next_sample_ = {};
+        samples_ = 0;
+        fast_.reset();
+        if (reference_) reference_->reset();
+    }
+
+    // Up to k pairs, best first: the largest drops from reference to fast
+    // correlation, or the lowest fast |correlation| without a reference.
+    // Reflects applied samples only; flush() first for the latest.
+    [[nodiscard]] std::vector<DecorrelatingPair> top_decorrelating(std::size_t k) const {
+        const auto pairs = fast_.top_decorrelating(k, reference());
+        std::vector<DecorrelatingPair> result;
+        result.reserve(pairs.size());
+        for (const MatrixPair& pair : pairs) {
+            result.push_back({universe_[pair.i], universe_[pair.j], pair.correlation, pair.reference_correlation});
+        }
+        return result;
+    }
+
+    // Fast-window correlation of two universe symbols (0 if either is outside it)
+    [[nodiscard]] double correlation(SymbolId a, SymbolId b) const noexcept {
+        const int32_t i = slot(a);
+        const int32_t j = slot(b);
+        if (i == NOT_IN_UNIVERSE || j == NOT_IN_UNIVERSE) return 0.0;
+        return fast_.correlation(static_cast<std::size_t>(i), static_cast<std::size_t>(j));
+    }
+
+    // Row of symbol in the matrices, -1 outside the universe
+    [[nodiscard]] int32_t slot(SymbolId symbol) const noexcept {
+        return symbol < slot_of_.size() ? slot_of_[symbol] : NOT_IN_UNIVERSE;
+    }
+
+    [[nodiscard]] const std::vector<SymbolId>& universe() const noexcept { return universe_; }
+    [[nodiscard]] const CorrelationMatrixConfig& config() const noexcept { return config_; }
+    [[nodiscard]] const EMACovarianceMatrix& fast() const noexcept { return fast_; }
+    // Null without a reference_window
+    [[nodiscard]] const EMACovarianceMatrix* reference() const noexcept {
+        return reference_ ? &*reference_ : nullptr;
+    }
+    [[nodiscard]] uint64_t samples() const noexcept { return samples_; }
+    [[nodiscard]] std::size_t pending_samples() const noexcept { return pending_rows_; }
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "md/symbol_table.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+// Latest price per symbol, shared between Router shards so a pair whose legs
+// live on different shards can still be evaluated. One writer per symbol (the
+// owning shard), any number of readers.
+class PriceBoard {
+private:
+    // One cache line per symbol so shards publishing neighbouring ids don't
+    // false-share
+    struct alignas(64) Slot {
+        std::atomic<double> price{std::numeric_limits<double>::quiet_NaN()};
+    };
+
+    std::size_t size_;
+    std::unique_ptr<Slot[]> slots_;
+
+public:
+    explicit PriceBoard(std::size_t max_symbols = SymbolTable::capacity())
+        : size_(max_symbols)
+        , slots_(std::make_unique<Slot[]>(max_symbols)) {}
+
+    void publish(SymbolId symbol, double price) noexcept {
+        if (symbol < size_) {
+            slots_[symbol].price.store(price, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns false until the symbol has published a price
+    [[nodiscard]] bool latest(SymbolId symbol, double& price) const noexcept {
+        if (symbol >= size_) return false;
+        price = slots_[symbol].price.load(std::memory_order_relaxed);
+        return !std::isnan(price);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
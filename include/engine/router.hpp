@@ -1,49 +1,174 @@
 #pragma once
 #include "md/tick.hpp"
 #include "engine/signal_rules.hpp"
+#include "engine/checkpoint.hpp"
+#include "engine/correlation_matrix.hpp"
+#include "engine/rule_pipeline.hpp"
+#include "engine/price_board.hpp"
+#include "engine/router_snapshot.hpp"
+#include "engine/signal_dispatcher.hpp"
+#include "engine/signal_gate.hpp"
+#include "engine/stage_trace.hpp"
+#include "util/arena.hpp"
 #include "util/latency.hpp"
+#include "util/seqlock.hpp"
+#include <algorithm>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <string>
+#include <stdexcept>
 
 // Callback for signal events
 using SignalCallback = std::function<void(const SignalEvent&)>;
 
+// Single-symbol rules run on every tick, in this order
+using SymbolRulePipeline = StaticRulePipeline<ZScoreRule, VolumeRule, MeanReversionRule>;
+
 // Main routing and signal detection engine
+//
+// Rule state lives in an Arena: each symbol gets one cache-line-aligned block
+// holding its rule pipeline followed by the Z-score and volume windows, and
+// each watched pair a block of its own. State is created on a symbol's first
+// tick unless pre-registered with add_symbol(); reserve() sizes the arena and
+// the per-symbol indexes up front so neither path allocates once the feed is
+// live. add_watched_pair() still allocates each leg's short list of pair
+// links, so register pairs before the feed starts.
+//
+// process_tick() runs on one thread. Counters and per-symbol stats are
+// published through seqlocks as each tick completes, so ticks_processed(),
+// snapshot() and friends may be called from any thread.
+//
+// Built with RT_ENABLE_TRACING, each tick is also timed per stage (queue
+// dwell, single-symbol rules, pair loop, signal emission) into
+// stage_profiler().
 class Router {
+public:
+    static constexpr std::size_t RULE_BLOCK_ALIGNMENT = 64;
+
 private:
-    // Per-symbol signal rules
-    std::unordered_map<std::string, std::unique_ptr<ZScoreRule>> zscore_rules_;
-    std::unordered_map<std::string, std::unique_ptr<VolumeRule>> volume_rules_;
+    // Rule state (owned by arena_, destroyed in ~Router)
+    Arena arena_;
+
+    // Per-symbol rules and published stats. Blocks also form a list, newest
+    // first, that snapshot() walks from other threads.
+    struct SymbolState {
+        SymbolRulePipeline rules;
+        uint64_t ticks{0};
+        SeqLock<SymbolStats> stats;
+        const SymbolState* next;
+
+        SymbolState(SymbolRulePipeline pipeline, SymbolId symbol, const SymbolState* next_state)
+            : rules(std::move(pipeline))
+            , stats(SymbolStats{symbol})
+            , next(next_state) {}
+    };
+
+    // Indexed by SymbolId (null until created)
+    std::vector<SymbolState*> symbol_rules_;
+    std::atomic<const SymbolState*> published_symbols_{nullptr};
 
     // Cross-symbol rules (pairs trading)
-    std::unordered_map<std::string, std::unique_ptr<CorrelationBreakRule>> correlation_rules_;
-    std::unordered_map<std::string, std::unique_ptr<MeanReversionRule>> mean_reversion_rules_;
-
-    // Symbol pair mappings for correlation analysis
-    std::vector<std::pair<std::string, std::string>> watched_pairs_;
-
-    // Latest tick data for each symbol
-    std::unordered_map<std::string, Tick> latest_ticks_;
+    struct PairRule {
+        CorrelationBreakRule rule;
+        SignalGate gate;
+    };
+    struct WatchedPair {
+        SymbolId first;
+        SymbolId second;
+        PairRule* state;
+    };
+    static constexpr std::size_t PAIR_BLOCK_BYTES =
+        Arena::align_up(sizeof(PairRule), RULE_BLOCK_ALIGNMENT);
+    std::vector<WatchedPair> watched_pairs_;
+    std::unordered_map<uint64_t, std::size_t> pair_index_;  // pair key -> watched_pairs_ slot
+
+    // Adjacency index: for each SymbolId, the pairs it is a local leg of, so a
+    // tick only visits its own pairs. A remote leg is owned by another shard;
+    // its price comes from the PriceBoard.
+    struct PairLink {
+        PairRule* state;             // Owned by arena_
+        SymbolId other;              // Leg whose price is looked up
+        bool other_remote;
+        bool self_is_first;          // Rule is fed (first, second) prices
+    };
+    std::vector<std::vector<PairLink>> pair_links_;
+
+    // Latest tick data for each symbol, indexed by SymbolId
+    // (symbol_id stays INVALID_SYMBOL_ID until the symbol has ticked)
+    std::vector<Tick> latest_ticks_;
+
+    // Optional board shared with other shards (publish ours, read remote legs)
+    PriceBoard* price_board_{nullptr};
+
+    // Optional all-pairs correlation over a symbol universe, fed every tick
+    CorrelationMatrixEngine* correlation_matrix_{nullptr};
 
     // Signal generation
     SignalCallback signal_callback_;
-    std::atomic<uint64_t> signal_counter_{0};
+    SignalDispatcher* signal_dispatcher_{nullptr};
 
-    // Performance tracking
+    // Performance tracking: counters_ is the tick thread's working copy
     LatencyHistogram latency_hist_;
-    std::atomic<uint64_t> ticks_processed_{0};
+    RouterCounters counters_;
+    SeqLock<RouterCounters> published_counters_;
+    std::unique_ptr<StageProfiler> stage_profiler_{TRACING_ENABLED ? std::make_unique<StageProfiler>() : nullptr};
 
     // Configuration
     double zscore_threshold_{2.5};
     double correlation_threshold_{0.3};
     double volume_threshold_{3.0};
+    EmissionPolicies emission_policies_{};  // LEVEL for every signal type
+    std::size_t zscore_window_{ZScoreRule::DEFAULT_WINDOW};
+    std::size_t volume_window_{VolumeRule::DEFAULT_WINDOW};
 
 public:
     Router() = default;
 
+    ~Router() {
+        for (SymbolState* state : symbol_rules_) {
+            if (state) std::destroy_at(state);
+        }
+        for (auto& pair : watched_pairs_) {
+            std::destroy_at(pair.state);
+        }
+    }
+
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    // Pre-allocate rule state for up to `symbols` more symbols and `pairs`
+    // more watched pairs, beyond those already registered. Per-symbol indexes
+    // (pair-link lists included) grow to cover every id the SymbolTable has
+    // handed out plus `symbols` new ones; the lists themselves fill as pairs
+    // are added. Call after setting the rule windows: blocks are sized with
+    // the windows in effect.
+    void reserve(std::size_t symbols, std::size_t pairs) {
+        reserve_symbol_ids(std::min(SymbolTable::capacity(), SymbolTable::size() + symbols));
+        watched_pairs_.reserve(watched_pairs_.size() + pairs);
+        pair_index_.reserve(pair_index_.size() + pairs);
+        arena_.reserve(symbols * symbol_block_bytes() + pairs * PAIR_BLOCK_BYTES);
+    }
+
+    // Size the per-symbol indexes for ids below ids (no rule state)
+    void reserve_symbol_ids(std::size_t ids) {
+        grow_symbol_index(ids);
+    }
+
+    // Create a symbol's rule state now instead of on its first tick
+    void add_symbol(const std::string& symbol) {
+        add_symbol(SymbolTable::intern_id(symbol));
+    }
+
+    void add_symbol(SymbolId symbol) {
+        if (symbol == INVALID_SYMBOL_ID) {
+            throw std::invalid_argument("Router::add_symbol: invalid symbol");
+        }
+        ensure_rules_exist(symbol);
+    }
+
     // Configuration
     void set_zscore_threshold(double threshold) noexcept {
         zscore_threshold_ = threshold;
@@ -57,187 +182,443 @@ public:
         volume_threshold_ = threshold;
     }
 
+    // Lookback (in ticks) of rules created after the call
+    void set_zscore_window(std::size_t window) {
+        if (window == 0) throw std::invalid_argument("Z-score window must be positive");
+        zscore_window_ = window;
+    }
+
+    void set_volume_window(std::size_t window) {
+        if (window == 0) throw std::invalid_argument("Volume window must be positive");
+        volume_window_ = window;
+    }
+
+    // How raw rule output becomes signals, per signal (i.e. rule) type.
+    // Applies to existing rules too; LEVEL, the default, emits every tick the
+    // condition holds.
+    void set_emission_policy(SignalEvent::Type type, EmissionPolicy policy) noexcept {
+        emission_policies_[signal_type_index(type)] = policy;
+    }
+
+    [[nodiscard]] const EmissionPolicy& emission_policy(SignalEvent::Type type) const noexcept {
+        return emission_policies_[signal_type_index(type)];
+    }
+
     void set_signal_callback(SignalCallback callback) {
         signal_callback_ = std::move(callback);
     }
 
+    // Publish signals into dispatcher's ring (drained on its own thread)
+    // instead of running sinks on the tick thread. This Router must be the
+    // dispatcher's only producer.
+    void set_signal_dispatcher(SignalDispatcher* dispatcher) noexcept {
+        signal_dispatcher_ = dispatcher;
+    }
+
+    // Publish every processed price to board, and read remote pair legs from it
+    void set_price_board(PriceBoard* board) noexcept {
+        price_board_ = board;
+    }
+
+    // Feed every processed tick to matrix on the tick thread; it is then
+    // only safe to query from that thread or once the consumer has stopped.
+    // The tick that completes a sample batch also pays for the matrix update
+    // (see CorrelationMatrixConfig::batch).
+    void set_correlation_matrix(CorrelationMatrixEngine* matrix) noexcept {
+        correlation_matrix_ = matrix;
+    }
+
     void add_watched_pair(const std::string& symbol1, const std::string& symbol2) {
-        const std::string pair_key = make_pair_key(symbol1, symbol2);
-        watched_pairs_.emplace_back(symbol1, symbol2);
+        add_watched_pair(SymbolTable::intern_id(symbol1), SymbolTable::intern_id(symbol2));
+    }
 
-        // Initialize correlation rule for this pair
-        correlation_rules_[pair_key] = std::make_unique<CorrelationBreakRule>(
-            correlation_threshold_, 50);
+    void add_watched_pair(SymbolId symbol1, SymbolId symbol2) {
+        add_pair(symbol1, symbol2, false);
+    }
+
+    // Pair whose second leg is processed by another Router. It is evaluated on
+    // local_symbol's ticks against the remote leg's latest price on the board.
+    void add_cross_shard_pair(SymbolId local_symbol, SymbolId remote_symbol) {
+        add_pair(local_symbol, remote_symbol, true);
     }
 
     // Main tick processing function
     void process_tick(const Tick& tick) {
-        const auto start_time = std::chrono::steady_clock::now();
+        // The only clock read per tick that fires nothing. Signals take their
+        // event_time from the tick's stamp, but each emitted signal reads
+        // SignalClock once more for its generation_time.
+        const auto start_time = TickClock::now();
 
-        // Update latest tick data
-        const std::string symbol{tick.symbol};
-        latest_ticks_[symbol] = tick;
+        const SymbolId symbol = tick.symbol_id;
+        if (symbol == INVALID_SYMBOL_ID) return;
 
-        // Ensure rules exist for this symbol
+        // Ensure rules exist for this symbol (creates them on first sight)
         ensure_rules_exist(symbol);
 
+        // Update latest tick data
+        latest_ticks_[symbol] = tick;
+        if (price_board_) {
+            price_board_->publish(symbol, tick.last_price);
+        }
+        if (correlation_matrix_) {
+            correlation_matrix_->on_tick(tick);
+        }
+
         // Process single-symbol signals
         process_single_symbol_signals(tick);
 
-        // Process cross-symbol signals
+        // Process cross-symbol signals (the single-symbol span starts at
+        // start_time, saving a clock read)
+        const auto cross_start = trace_now();
+        trace(TraceStage::SINGLE_RULES, symbol, start_time, cross_start);
         process_cross_symbol_signals(tick);
 
         // Update latency statistics
         latency_hist_.add_sample(tick.timestamp, start_time);
-        ticks_processed_.fetch_add(1, std::memory_order_relaxed);
+        if constexpr (TRACING_ENABLED) {
+            const auto end_time = TickClock::now();
+            trace(TraceStage::CROSS_RULES, symbol, cross_start, end_time);
+            trace(TraceStage::QUEUE_DWELL, symbol, tick.timestamp, start_time);
+            trace(TraceStage::TICK_TOTAL, symbol, start_time, end_time);
+        }
+
+        const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            start_time.time_since_epoch()).count();
+        if (counters_.ticks_processed++ == 0) counters_.first_tick_ns = now_ns;
+        counters_.last_tick_ns = now_ns;
+        published_counters_.store(counters_);
     }
 
-    // Statistics and monitoring
+    // Statistics and monitoring (any thread)
     [[nodiscard]] uint64_t ticks_processed() const noexcept {
-        return ticks_processed_.load(std::memory_order_acquire);
+        return published_counters_.load().ticks_processed;
     }
 
     [[nodiscard]] uint64_t signals_generated() const noexcept {
-        return signal_counter_.load(std::memory_order_acquire);
+        return published_counters_.load().signals_generated;
+    }
+
+    [[nodiscard]] RouterCounters counters() const noexcept {
+        return published_counters_.load();
+    }
+
+    // Counters, a copy of the latency histogram and every symbol's latest stats
+    [[nodiscard]] RouterSnapshot snapshot() const {
+        RouterSnapshot snap(latency_hist_.layout());
+        snap.counters = published_counters_.load();
+        snap.latency = latency_hist_.snapshot();
+        for (const SymbolState* state = published_symbols_.load(std::memory_order_acquire);
+             state != nullptr; state = state->next) {
+            snap.symbols.push_back(state->stats.load());
+        }
+        std::sort(snap.symbols.begin(), snap.symbols.end(),
+                  [](const SymbolStats& a, const SymbolStats& b) { return a.symbol < b.symbol; });
+        return snap;
     }
 
     [[nodiscard]] const LatencyHistogram& latency_histogram() const noexcept {
         return latency_hist_;
     }
 
+    // Per-stage timings; null unless built with RT_ENABLE_TRACING
+    [[nodiscard]] const StageProfiler* stage_profiler() const noexcept {
+        return stage_profiler_.get();
+    }
+
+    // Also keep the last capacity stage spans (power of 2) for
+    // write_chrome_trace(). Returns false when tracing is compiled out.
+    bool enable_trace(std::size_t capacity) {
+        if (!stage_profiler_) return false;
+        stage_profiler_->enable_trace(capacity);
+        return true;
+    }
+
+    // Ticks per second between the first and the latest tick
     [[nodiscard]] double processing_rate() const noexcept {
-        // Returns ticks per second processed
-        return latency_hist_.sample_rate_per_second();
+        return published_counters_.load().ticks_per_second();
     }
 
-    // Reset all statistics
+    // Reset all statistics (on the tick thread, or while it is idle)
     void reset_stats() {
-        ticks_processed_.store(0, std::memory_order_release);
-        signal_counter_.store(0, std::memory_order_release);
+        counters_ = RouterCounters{};
+        published_counters_.store(counters_);
         latency_hist_.reset();
+        if (stage_profiler_) stage_profiler_->reset();
 
         // Reset all rules
-        for (auto& [symbol, rule] : zscore_rules_) {
-            rule->reset();
+        for (SymbolState* state : symbol_rules_) {
+            if (!state) continue;
+            state->rules.reset();
+            state->ticks = 0;
+            state->stats.store(SymbolStats{state->stats.load().symbol});
         }
-        for (auto& [symbol, rule] : volume_rules_) {
-            rule->reset();
+        for (auto& pair : watched_pairs_) {
+            pair.state->rule.reset();
+            pair.state->gate.reset();
         }
-        for (auto& [pair, rule] : correlation_rules_) {
-            rule->reset();
+    }
+
+    // Serialize every symbol's and watched pair's rule statistics into image
+    // (replacing its contents; keep reusing one buffer to avoid
+    // reallocating). Tick thread, or while it is idle. No I/O: hand the image
+    // to a CheckpointWriter to get it on disk off the tick thread.
+    void checkpoint(std::vector<std::byte>& image) const {
+        begin_checkpoint(image);
+        image.reserve(sizeof(CheckpointHeader) + symbol_rules_.size() * symbol_block_bytes() +
+                      watched_pairs_.size() * PAIR_BLOCK_BYTES);
+        CheckpointOut out(image);
+
+        uint32_t symbols = 0;
+        for (std::size_t id = 0; id < symbol_rules_.size(); ++id) {
+            const SymbolState* state = symbol_rules_[id];
+            if (!state) continue;
+            out.put_string(SymbolTable::name(static_cast<SymbolId>(id)));
+            out.put(state->ticks);
+            state->rules.save(out);
+            ++symbols;
         }
-        for (auto& [symbol, rule] : mean_reversion_rules_) {
-            rule->reset();
+        for (const auto& pair : watched_pairs_) {
+            out.put_string(SymbolTable::name(pair.first));
+            out.put_string(SymbolTable::name(pair.second));
+            pair.state->rule.save(out);
         }
+        finish_checkpoint(image, symbols, static_cast<uint32_t>(watched_pairs_.size()));
+    }
+
+    // Warm start from a checkpoint() image: symbols get their rule state
+    // back (created if new), watched pairs their correlation state; add the
+    // watched pairs first. Thresholds, windows and emission policies stay as
+    // configured here, a resized window keeps the newest values that fit, and
+    // emission gates start re-armed. Latest prices are not restored, so a
+    // pair waits for a fresh tick on both legs. Call before the feed starts.
+    // Throws std::runtime_error on an invalid image; state may then be partly
+    // loaded, and reset_stats() returns to a cold start.
+    CheckpointRestore restore(std::span<const std::byte> image) {
+        const CheckpointHeader header = read_checkpoint_header(image);
+        CheckpointIn in(image.subspan(sizeof(CheckpointHeader)));
+        CheckpointRestore result;
+
+        for (uint32_t i = 0; i < header.symbol_count; ++i) {
+            const SymbolId symbol = SymbolTable::intern_id(in.get_string());
+            ensure_rules_exist(symbol);
+            SymbolState& state = *symbol_rules_[symbol];
+            state.ticks = in.get<uint64_t>();
+            state.rules.load(in);
+
+            const ZScoreRule& zscore = state.rules.get<ZScoreRule>();
+            const VolumeRule& volume = state.rules.get<VolumeRule>();
+            state.stats.store(SymbolStats{
+                symbol, state.ticks, zscore.last_value(), 0.0, 0.0, volume.last_volume(),
+                zscore.stats().mean(), zscore.stats().variance(), volume.stats().mean()});
+            ++result.symbols;
+        }
+
+        for (uint32_t i = 0; i < header.pair_count; ++i) {
+            const SymbolId first = SymbolTable::intern_id(in.get_string());
+            const SymbolId second = SymbolTable::intern_id(in.get_string());
+            const auto it = pair_index_.find(make_pair_key(first, second));
+            if (it != pair_index_.end()) {
+                PairRule& pair = *watched_pairs_[it->second].state;
+                pair.rule.load(in);
+                // Watched as (second, first): same statistics, legs mirrored
+                if (watched_pairs_[it->second].first != first) pair.rule.swap_legs();
+                pair.gate.reset();
+                ++result.pairs;
+            } else {
+                CorrelationBreakRule unused;
+                unused.load(in);
+                ++result.pairs_skipped;
+            }
+        }
+
+        if (!in.done()) throw std::runtime_error("Checkpoint has trailing bytes");
+        return result;
     }
 
     // Get current correlation for a pair
     [[nodiscard]] double get_correlation(const std::string& symbol1,
                                         const std::string& symbol2) const {
-        const std::string pair_key = make_pair_key(symbol1, symbol2);
-        auto it = correlation_rules_.find(pair_key);
-        return (it != correlation_rules_.end()) ? it->second->correlation() : 0.0;
+        return get_correlation(SymbolTable::find(symbol1), SymbolTable::find(symbol2));
     }
 
-private:
-    void ensure_rules_exist(const std::string& symbol) {
-        if (zscore_rules_.find(symbol) == zscore_rules_.end()) {
-            zscore_rules_[symbol] = std::make_unique<ZScoreRule>(zscore_threshold_);
-        }
-        if (volume_rules_.find(symbol) == volume_rules_.end()) {
-            volume_rules_[symbol] = std::make_unique<VolumeRule>(volume_threshold_);
-        }
-        if (mean_reversion_rules_.find(symbol) == mean_reversion_rules_.end()) {
-            mean_reversion_rules_[symbol] = std::make_unique<MeanReversionRule>();
-        }
+    [[nodiscard]] double get_correlation(SymbolId symbol1, SymbolId symbol2) const {
+        auto it = pair_index_.find(make_pair_key(symbol1, symbol2));
+        return (it != pair_index_.end()) ? watched_pairs_[it->second].state->rule.correlation() : 0.0;
     }
 
-    void process_single_symbol_signals(const Tick& tick) {
-        const std::string symbol{tick.symbol};
+    [[nodiscard]] bool watches_pair(SymbolId symbol1, SymbolId symbol2) const {
+        return pair_index_.find(make_pair_key(symbol1, symbol2)) != pair_index_.end();
+    }
 
-        // Z-Score analysis on last price
-        auto& zscore_rule = zscore_rules_[symbol];
-        zscore_rule->add_observation(tick.last_price);
+    [[nodiscard]] bool has_symbol(SymbolId symbol) const noexcept {
+        return symbol < symbol_rules_.size() && symbol_rules_[symbol] != nullptr;
+    }
 
-        double zscore_strength;
-        if (zscore_rule->evaluate(zscore_strength)) {
-            emit_signal(SignalEvent::Type::Z_SCORE_BREAK, symbol, "",
-                       zscore_strength, 0.95);
-        }
+    // Bytes obtained for rule state, and how much of it is still unused
+    [[nodiscard]] std::size_t rule_memory_bytes() const noexcept { return arena_.bytes_reserved(); }
+    [[nodiscard]] std::size_t rule_memory_available() const noexcept { return arena_.available(); }
 
-        // Volume spike analysis
-        auto& volume_rule = volume_rules_[symbol];
-        volume_rule->add_volume(tick.last_size);
+private:
+    void add_pair(SymbolId symbol1, SymbolId symbol2, bool second_remote) {
+        const uint64_t pair_key = make_pair_key(symbol1, symbol2);
+        if (pair_index_.find(pair_key) != pair_index_.end()) return;
+
+        // Initialize correlation rule for this pair
+        pair_index_[pair_key] = watched_pairs_.size();
+        PairRule* state_ptr = ::new (arena_.allocate(PAIR_BLOCK_BYTES, RULE_BLOCK_ALIGNMENT))
+            PairRule{CorrelationBreakRule(correlation_threshold_, 50), SignalGate{}};
+        watched_pairs_.push_back({symbol1, symbol2, state_ptr});
+
+        // A remote leg never ticks here, so only local legs get a link
+        link_pair(symbol1, {state_ptr, symbol2, second_remote, true});
+        if (!second_remote && symbol2 != symbol1) {
+            link_pair(symbol2, {state_ptr, symbol1, false, false});
+        }
+    }
 
-        double volume_strength;
-        if (volume_rule->evaluate(volume_strength)) {
-            emit_signal(SignalEvent::Type::VOLUME_SPIKE, symbol, "",
-                       volume_strength, 0.90);
+    void link_pair(SymbolId symbol, const PairLink& link) {
+        if (symbol >= pair_links_.size()) {
+            pair_links_.resize(static_cast<std::size_t>(symbol) + 1);
         }
+        pair_links_[symbol].push_back(link);
+    }
 
-        // Mean reversion analysis
-        auto& mean_rev_rule = mean_reversion_rules_[symbol];
-        mean_rev_rule->add_observation(tick.last_price);
+    void grow_symbol_index(std::size_t size) {
+        if (size > latest_ticks_.size()) {
+            latest_ticks_.resize(size);
+            symbol_rules_.resize(size, nullptr);
+        }
+        if (size > pair_links_.size()) pair_links_.resize(size);
+    }
 
-        double mean_rev_strength;
-        if (mean_rev_rule->evaluate(mean_rev_strength)) {
-            emit_signal(SignalEvent::Type::PAIR_TRADE_ENTRY, symbol, "",
-                       mean_rev_strength, 0.85);
+    void ensure_rules_exist(SymbolId symbol) {
+        grow_symbol_index(static_cast<std::size_t>(symbol) + 1);
+        if (!symbol_rules_[symbol]) {
+            symbol_rules_[symbol] = create_symbol_state(symbol);
         }
     }
 
-    void process_cross_symbol_signals(const Tick& tick) {
-        const std::string current_symbol{tick.symbol};
+    // SymbolState, then the Z-score window, then the volume window
+    [[nodiscard]] std::size_t symbol_block_bytes() const noexcept {
+        return Arena::align_up(sizeof(SymbolState), RULE_BLOCK_ALIGNMENT) +
+               Arena::align_up((zscore_window_ + volume_window_) * sizeof(double), RULE_BLOCK_ALIGNMENT);
+    }
 
-        // Check all pairs involving this symbol
-        for (const auto& [symbol1, symbol2] : watched_pairs_) {
-            if (symbol1 != current_symbol && symbol2 != current_symbol) {
-                continue;
-            }
+    [[nodiscard]] SymbolState* create_symbol_state(SymbolId symbol) {
+        auto* block = static_cast<std::byte*>(arena_.allocate(symbol_block_bytes(), RULE_BLOCK_ALIGNMENT));
+        double* zscore_window = reinterpret_cast<double*>(
+            block + Arena::align_up(sizeof(SymbolState), RULE_BLOCK_ALIGNMENT));
+        double* volume_window = zscore_window + zscore_window_;
+        auto* state = ::new (block) SymbolState(
+            SymbolRulePipeline(
+                ZScoreRule(zscore_threshold_, std::span<double>(zscore_window, zscore_window_)),
+                VolumeRule(volume_threshold_, std::span<double>(volume_window, volume_window_)),
+                MeanReversionRule()),
+            symbol, published_symbols_.load(std::memory_order_relaxed));
+        published_symbols_.store(state, std::memory_order_release);
+        return state;
+    }
 
-            // Check if we have recent data for both symbols
-            auto it1 = latest_ticks_.find(symbol1);
-            auto it2 = latest_ticks_.find(symbol2);
+    [[nodiscard]] bool has_tick(SymbolId symbol) const noexcept {
+        return symbol < latest_ticks_.size() &&
+               latest_ticks_[symbol].symbol_id != INVALID_SYMBOL_ID;
+    }
 
-            if (it1 == latest_ticks_.end() || it2 == latest_ticks_.end()) {
+    [[nodiscard]] bool leg_price(SymbolId symbol, bool remote, double& price) const noexcept {
+        if (remote) {
+            return price_board_ && price_board_->latest(symbol, price);
+        }
+        if (!has_tick(symbol)) return false;
+        price = latest_ticks_[symbol].last_price;
+        return true;
+    }
+
+    void process_single_symbol_signals(const Tick& tick) {
+        const SymbolId symbol = tick.symbol_id;
+        SymbolState& state = *symbol_rules_[symbol];
+
+        // Z-score, volume spike and mean reversion, inlined into one pass
+        state.rules.process(tick, emission_policies_,
+            [&](SignalEvent::Type type, double strength, double confidence) {
+                emit_signal(type, symbol, INVALID_SYMBOL_ID, strength, confidence,
+                            tick.timestamp);
+            });
+
+        const SlidingWindowStats& prices = state.rules.get<ZScoreRule>().stats();
+        state.stats.store(SymbolStats{
+            symbol, ++state.ticks, tick.last_price, tick.bid_price, tick.ask_price, tick.last_size,
+            prices.mean(), prices.variance(), state.rules.get<VolumeRule>().stats().mean()});
+    }
+
+    void process_cross_symbol_signals(const Tick& tick) {
+        const SymbolId current_symbol = tick.symbol_id;
+        if (current_symbol >= pair_links_.size()) return;
+
+        // Only the pairs this symbol is a leg of
+        for (const PairLink& link : pair_links_[current_symbol]) {
+            // Check if we have recent data for the other leg
+            double other_price;
+            if (!leg_price(link.other, link.other_remote, other_price)) {
                 continue;
             }
 
-            const std::string pair_key = make_pair_key(symbol1, symbol2);
-            auto& corr_rule = correlation_rules_[pair_key];
+            auto& corr_rule = link.state->rule;
 
             // Add the pair observation
-            corr_rule->add_pair(it1->second.last_price, it2->second.last_price);
+            if (link.self_is_first) {
+                corr_rule.add_pair(tick.last_price, other_price);
+            } else {
+                corr_rule.add_pair(other_price, tick.last_price);
+            }
 
             // Check for correlation breakdown
             double corr_strength;
-            if (corr_rule->evaluate(corr_strength)) {
-                emit_signal(SignalEvent::Type::CORRELATION_BREAK,
-                           symbol1, symbol2, corr_strength, 0.88);
+            const bool fired = corr_rule.evaluate(corr_strength);
+            if (link.state->gate.admit(emission_policy(CorrelationBreakRule::SIGNAL_TYPE), fired,
+                                       corr_rule.trigger_margin(corr_strength), tick.timestamp)) {
+                const SymbolId first = link.self_is_first ? current_symbol : link.other;
+                const SymbolId second = link.self_is_first ? link.other : current_symbol;
+                emit_signal(CorrelationBreakRule::SIGNAL_TYPE, first, second,
+                           corr_strength, CorrelationBreakRule::CONFIDENCE, tick.timestamp);
             }
         }
     }
 
-    void emit_signal(SignalEvent::Type type, const std::string& primary,
-                    const std::string& secondary, double strength, double confidence) {
-        if (!signal_callback_) return;
+    void emit_signal(SignalEvent::Type type, SymbolId primary, SymbolId secondary,
+                    double strength, double confidence, TickClock::time_point tick_time) {
+        if (!signal_callback_ && !signal_dispatcher_) return;
 
-        SignalEvent event{
-            type,
-            SymbolTable::intern(primary),
-            secondary.empty() ? std::string_view{} : SymbolTable::intern(secondary),
-            strength,
-            confidence
-        };
+        SignalEvent event{type, primary, secondary, strength, confidence,
+                          convert_time_point<SignalClock>(tick_time)};
 
-        event.signal_id = signal_counter_.fetch_add(1, std::memory_order_acq_rel);
-        event.generation_time = std::chrono::steady_clock::now();
+        event.signal_id = counters_.signals_generated++;
+        counters_.signals_by_type[signal_type_index(type)]++;
+        event.generation_time = SignalClock::now();
 
-        signal_callback_(event);
+        if (signal_dispatcher_) signal_dispatcher_->publish(event);
+        if (signal_callback_) signal_callback_(event);
+        trace(TraceStage::SIGNAL_EMIT, primary, convert_time_point<TickClock>(event.generation_time), trace_now());
+    }
+
+    // Probe clock: a TickClock read when tracing is built in, nothing otherwise
+    [[nodiscard]] static TickClock::time_point trace_now() noexcept {
+        if constexpr (TRACING_ENABLED) {
+            return TickClock::now();
+        } else {
+            return {};
+        }
+    }
+
+    void trace(TraceStage stage, SymbolId symbol,
+               TickClock::time_point begin, TickClock::time_point end) noexcept {
+        if constexpr (TRACING_ENABLED) {
+            stage_profiler_->record(stage, symbol, begin, end);
+        }
     }
 
-    [[nodiscard]] static std::string make_pair_key(const std::string& s1,
-                                                  const std::string& s2) {
-        return s1 < s2 ? (s1 + "|" + s2) : (s2 + "|" + s1);
+    // Order-independent key for a symbol pair
+    [[nodiscard]] static constexpr uint64_t make_pair_key(SymbolId s1, SymbolId s2) noexcept {
+        return s1 < s2 ? ((static_cast<uint64_t>(s1) << 32) | s2)
+                       : ((static_cast<uint64_t>(s2) << 32) | s1);
     }
 };
\ No newline at end of file
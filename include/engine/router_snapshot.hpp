@@ -0,0 +1,85 @@
+#pragma once
+#include "engine/signal_gate.hpp"
+#include "md/tick.hpp"
+#include "util/latency.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Router counters, published together after every tick so they always agree
+// with each other (signals_by_type sums to signals_generated)
+struct RouterCounters {
+    uint64_t ticks_processed{0};
+    uint64_t signals_generated{0};
+    std::array<uint64_t, SIGNAL_TYPE_COUNT> signals_by_type{};
+    int64_t first_tick_ns{0};   // TickClock time of the first tick since reset, 0 before it
+    int64_t last_tick_ns{0};
+
+    // Processing rate from the first to the last tick
+    [[nodiscard]] double ticks_per_second() const noexcept {
+        if (ticks_processed < 2 || last_tick_ns <= first_tick_ns) return 0.0;
+        return static_cast<double>(ticks_processed - 1) * 1e9 /
+               static_cast<double>(last_tick_ns - first_tick_ns);
+    }
+};
+
+// Latest state of one symbol, published by the Router after each of its ticks
+struct SymbolStats {
+    SymbolId symbol{INVALID_SYMBOL_ID};
+    uint64_t ticks{0};
+    double last_price{0.0};
+    double bid_price{0.0};
+    double ask_price{0.0};
+    double last_size{0.0};
+    double price_mean{0.0};     // Over the Z-score window
+    double price_variance{0.0};
+    double volume_mean{0.0};    // Over the volume window
+
+    // Derived on read, keeping the tick thread's publish to plain stores
+    [[nodiscard]] double price_std_dev() const noexcept { return std::sqrt(price_variance); }
+
+    [[nodiscard]] double zscore() const noexcept {
+        const double sd = price_std_dev();
+        return sd > 0.0 ? (last_price - price_mean) / sd : 0.0;
+    }
+};
+
+// Consistent copy of a Router's metrics for dashboards and exporters
+struct RouterSnapshot {
+    RouterCounters counters;
+    HistogramSnapshot latency;
+    std::vector<SymbolStats> symbols;   // Ascending SymbolId
+    std::chrono::steady_clock::time_point taken_at;
+
+    explicit RouterSnapshot(const HdrLayout& layout)
+        : latency(layout)
+        , taken_at(std::chrono::steady_clock::now()) {}
+
+    // Tick rate between an earlier snapshot and this one
+    [[nodiscard]] double ticks_per_second_since(const RouterSnapshot& earlier) const noexcept {
+        const double seconds = std::chrono::duration<double>(taken_at - earlier.taken_at).count();
+        if (seconds <= 0.0 || counters.ticks_processed < earlier.counters.ticks_processed) return 0.0;
+        return static_cast<double>(counters.ticks_processed - earlier.counters.ticks_processed) / seconds;
+    }
+
+    // Fold in another router's snapshot (e.g. one per shard)
+    void merge(const RouterSnapshot& other) {
+        counters.ticks_processed += other.counters.ticks_processed;
+        counters.signals_generated += other.counters.signals_generated;
+        for (std::size_t i = 0; i < SIGNAL_TYPE_COUNT; ++i) {
+            counters.signals_by_type[i] += other.counters.signals_by_type[i];
+        }
+        if (other.counters.first_tick_ns != 0 &&
+            (counters.first_tick_ns == 0 || other.counters.first_tick_ns < counters.first_tick_ns)) {
+            counters.first_tick_ns = other.counters.first_tick_ns;
+        }
+        counters.last_tick_ns = std::max(counters.last_tick_ns, other.counters.last_tick_ns);
+        latency.merge(other.latency);
+        symbols.insert(symbols.end(), other.symbols.begin(), other.symbols.end());
+        std::sort(symbols.begin(), symbols.end(),
+                  [](const SymbolStats& a, const SymbolStats& b) { return a.symbol < b.symbol; });
+    }
+};
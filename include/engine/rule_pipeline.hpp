@@ -0,0 +1,110 @@
+#pragma once
+#include "engine/signal_rules.hpp"
+#include "engine/signal_gate.hpp"
+#include "md/tick.hpp"
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+// A rule that consumes ticks directly and knows which signal it raises
+template <typename R>
+concept TickRule = requires(R& rule, const R& const_rule, const Tick& tick, double& strength) {
+    rule.on_tick(tick);
+    { const_rule.evaluate(strength) } -> std::same_as<bool>;
+    { const_rule.trigger_margin(strength) } -> std::convertible_to<double>;
+    rule.reset();
+    { R::SIGNAL_TYPE } -> std::convertible_to<SignalEvent::Type>;
+    { R::CONFIDENCE } -> std::convertible_to<double>;
+};
+
+// Fixed rule set held by value in a tuple. process() expands to a straight
+// sequence of on_tick/evaluate calls on the concrete (final) rule types, so
+// the whole per-tick update inlines into one function with no virtual
+// dispatch. For rule sets chosen at runtime use CompositeSignalEngine.
+//
+// Each rule has a SignalGate; the process() overload taking EmissionPolicies
+// filters the raw rule output through it (edge, hysteresis, rate limit).
+template <TickRule... Rules>
+class StaticRulePipeline {
+private:
+    std::tuple<Rules...> rules_;
+    std::array<SignalGate, sizeof...(Rules)> gates_{};
+
+    template <typename Rule, typename OnSignal>
+    static void process_rule(Rule& rule, const Tick& tick, OnSignal& on_signal) {
+        rule.on_tick(tick);
+
+        double strength;
+        if (rule.evaluate(strength)) {
+            on_signal(Rule::SIGNAL_TYPE, strength, Rule::CONFIDENCE);
+        }
+    }
+
+    template <typename Rule, typename OnSignal>
+    static void process_gated_rule(Rule& rule, SignalGate& gate, const EmissionPolicies& policies,
+                                   const Tick& tick, OnSignal& on_signal) {
+        rule.on_tick(tick);
+
+        double strength;
+        const bool fired = rule.evaluate(strength);
+        if (gate.admit(policies[signal_type_index(Rule::SIGNAL_TYPE)], fired,
+                       rule.trigger_margin(strength), tick.timestamp)) {
+            on_signal(Rule::SIGNAL_TYPE, strength, Rule::CONFIDENCE);
+        }
+    }
+
+    template <typename OnSignal, std::size_t... I>
+    void process_gated(const Tick& tick, const EmissionPolicies& policies, OnSignal& on_signal,
+                       std::index_sequence<I...>) {
+        (process_gated_rule(std::get<I>(rules_), gates_[I], policies, tick, on_signal), ...);
+    }
+
+public:
+    StaticRulePipeline() = default;
+
+    explicit StaticRulePipeline(Rules... rules)
+        : rules_(std::move(rules)...) {}
+
+    // Feed tick to every rule in order; on_signal(type, strength, confidence)
+    // runs for each rule that fires
+    template <typename OnSignal>
+    void process(const Tick& tick, OnSignal&& on_signal) {
+        std::apply([&](Rules&... rule) {
+            (process_rule(rule, tick, on_signal), ...);
+        }, rules_);
+    }
+
+    // Same, emitting only what each rule type's policy admits
+    template <typename OnSignal>
+    void process(const Tick& tick, const EmissionPolicies& policies, OnSignal&& on_signal) {
+        process_gated(tick, policies, on_signal, std::index_sequence_for<Rules...>{});
+    }
+
+    void reset() {
+        std::apply([](Rules&... rule) { (rule.reset(), ...); }, rules_);
+        for (auto& gate : gates_) gate.reset();
+    }
+
+    // Checkpoint every rule in order. Gates are not saved: their state is
+    // TickClock time, meaningless in another process, so load() re-arms them.
+    template <typename Out>
+    void save(Out& out) const {
+        std::apply([&out](const Rules&... rule) { (rule.save(out), ...); }, rules_);
+    }
+
+    template <typename In>
+    void load(In& in) {
+        std::apply([&in](Rules&... rule) { (rule.load(in), ...); }, rules_);
+        for (auto& gate : gates_) gate.reset();
+    }
+
+    template <typename Rule>
+    [[nodiscard]] Rule& get() noexcept { return std::get<Rule>(rules_); }
+
+    template <typename Rule>
+    [[nodiscard]] const Rule& get() const noexcept { return std::get<Rule>(rules_); }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return sizeof...(Rules); }
+};
@@ -0,0 +1,310 @@
+#pragma once
+#include "engine/router.hpp"
+#include "engine/price_board.hpp"
+#include "md/spsc_queue.hpp"
+#include "md/tick.hpp"
+#include "util/latency.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Multi-core router: symbols are partitioned across N shards, each with its own
+// SPSC queue, Router (rule state + LatencyHistogram) and worker thread.
+//
+// Watched pairs are placed on the shard that owns both legs whenever the
+// symbols are still unassigned. A pair whose legs already live on different
+// shards is evaluated on the first leg's shard, reading the second leg's
+// latest price from a shared PriceBoard.
+//
+// Threading: configure (thresholds, callback, pairs, assignments) before
+// start(); afterwards push()/try_push_n() must come from a single dispatcher
+// thread. The signal callback runs on the worker threads and must be
+// thread-safe. Signal ids are unique per shard, not process-wide.
+class ShardedRouter {
+public:
+    static constexpr std::size_t SHARD_QUEUE_SIZE = 16384;
+    using ShardQueue = SPSCQueue<Tick, SHARD_QUEUE_SIZE>;
+    using value_type = Tick;
+
+private:
+    static constexpr uint32_t UNASSIGNED = UINT32_MAX;
+    static constexpr std::size_t DISPATCH_BATCH = 64;
+
+    struct Shard {
+        Router router;
+        ShardQueue queue;
+        std::thread worker;
+        std::atomic<uint64_t> ticks_dropped{0};
+
+        // Dispatcher-thread only
+        std::size_t symbol_count{0};
+        std::size_t staged_count{0};
+        std::size_t room{0};            // Free queue slots not yet claimed by staged ticks
+        Tick staged[DISPATCH_BATCH];
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<uint32_t> owner_;   // SymbolId -> shard index
+    PriceBoard price_board_;
+    std::atomic<bool> running_{false};
+
+public:
+    explicit ShardedRouter(std::size_t num_shards)
+        : owner_(SymbolTable::capacity(), UNASSIGNED) {
+        if (num_shards == 0) {
+            throw std::invalid_argument("ShardedRouter needs at least one shard");
+        }
+        for (std::size_t i = 0; i < num_shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->router.set_price_board(&price_board_);
+        }
+    }
+
+    ~ShardedRouter() {
+        stop();
+    }
+
+    ShardedRouter(const ShardedRouter&) = delete;
+    ShardedRouter& operator=(const ShardedRouter&) = delete;
+
+    // Configuration (forwarded to every shard)
+    void set_zscore_threshold(double threshold) noexcept {
+        for (auto& shard : shards_) shard->router.set_zscore_threshold(threshold);
+    }
+
+    void set_correlation_threshold(double threshold) noexcept {
+        for (auto& shard : shards_) shard->router.set_correlation_threshold(threshold);
+    }
+
+    void set_volume_threshold(double threshold) noexcept {
+        for (auto& shard : shards_) shard->router.set_volume_threshold(threshold);
+    }
+
+    void set_emission_policy(SignalEvent::Type type, EmissionPolicy policy) noexcept {
+        for (auto& shard : shards_) shard->router.set_emission_policy(type, policy);
+    }
+
+    void set_zscore_window(std::size_t window) {
+        for (auto& shard : shards_) shard->router.set_zscore_window(window);
+    }
+
+    void set_volume_window(std::size_t window) {
+        for (auto& shard : shards_) shard->router.set_volume_window(window);
+    }
+
+    void set_signal_callback(const SignalCallback& callback) {
+        for (auto& shard : shards_) shard->router.set_signal_callback(callback);
+    }
+
+    // Pin a symbol to a shard (before start)
+    void assign_symbol(SymbolId symbol, std::size_t shard) {
+        if (shard >= shards_.size()) {
+            throw std::out_of_range("ShardedRouter shard index out of range");
+        }
+        if (symbol >= owner_.size() || owner_[symbol] != UNASSIGNED) return;
+        owner_[symbol] = static_cast<uint32_t>(shard);
+        shards_[shard]->symbol_count++;
+    }
+
+    // Assign a symbol (to the least loaded shard unless already placed) and
+    // create its rule state there
+    void add_symbol(SymbolId symbol) {
+        if (symbol >= owner_.size()) {
+            throw std::out_of_range("ShardedRouter symbol id out of range");
+        }
+        shards_[shard_for(symbol)]->router.add_symbol(symbol);
+    }
+
+    // Pre-allocate rule state for symbols and pairs spread evenly over the
+    // shards; every shard indexes all ids, since any of them may land on it
+    void reserve(std::size_t symbols, std::size_t pairs) {
+        const std::size_t n = shards_.size();
+        const std::size_t ids = std::min(SymbolTable::capacity(), SymbolTable::size() + symbols);
+        for (auto& shard : shards_) {
+            shard->router.reserve((symbols + n - 1) / n, (pairs + n - 1) / n);
+            shard->router.reserve_symbol_ids(ids);
+        }
+    }
+
+    void add_watched_pair(const std::string& symbol1, const std::string& symbol2) {
+        add_watched_pair(SymbolTable::intern_id(symbol1), SymbolTable::intern_id(symbol2));
+    }
+
+    void add_watched_pair(SymbolId symbol1, SymbolId symbol2) {
+        // Co-locate the legs whenever one side is still free
+        if (owner_[symbol1] == UNASSIGNED && owner_[symbol2] == UNASSIGNED) {
+            const std::size_t shard = least_loaded_shard();
+            assign_symbol(symbol1, shard);
+            assign_symbol(symbol2, shard);
+        } else if (owner_[symbol1] == UNASSIGNED) {
+            assign_symbol(symbol1, owner_[symbol2]);
+        } else if (owner_[symbol2] == UNASSIGNED) {
+            assign_symbol(symbol2, owner_[symbol1]);
+        }
+
+        auto& router = shards_[owner_[symbol1]]->router;
+        if (owner_[symbol1] == owner_[symbol2]) {
+            router.add_watched_pair(symbol1, symbol2);
+        } else {
+            router.add_cross_shard_pair(symbol1, symbol2);
+        }
+    }
+
+    void start() {
+        if (running_.exchange(true, std::memory_order_acq_rel)) return;
+        for (auto& shard : shards_) {
+            shard->worker = std::thread([this, s = shard.get()]() { run_shard(*s); });
+        }
+    }
+
+    // Stops the workers after they drain whatever is already queued
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+        for (auto& shard : shards_) {
+            if (shard->worker.joinable()) shard->worker.join();
+        }
+    }
+
+    // Queue-style ingest, so FeedSimulator::run/generate_ticks can feed the shards
+    // directly. Dispatcher thread only.
+    [[nodiscard]] bool push(const Tick& tick) {
+        auto& shard = *shards_[shard_for(tick.symbol_id)];
+        if (!shard.queue.push(tick)) {
+            shard.ticks_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // Groups the batch by shard and publishes each group with one index store.
+    // Like SPSCQueue::try_push_n, accepts a prefix: it stops at the first tick
+    // whose shard queue is full (counted as a drop there) and returns the
+    // number taken, so callers can retry or park ticks + accepted.
+    [[nodiscard]] std::size_t try_push_n(const Tick* ticks, std::size_t count) {
+        for (auto& shard : shards_) shard->room = 0;
+
+        std::size_t accepted = 0;
+        for (; accepted < count; ++accepted) {
+            auto& shard = *shards_[shard_for(ticks[accepted].symbol_id)];
+            if (shard.room == 0) {
+                flush(shard);
+                shard.room = shard.queue.free_space();
+                if (shard.room == 0) {
+                    shard.ticks_dropped.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            shard.room--;
+            shard.staged[shard.staged_count++] = ticks[accepted];
+            if (shard.staged_count == DISPATCH_BATCH) flush(shard);
+        }
+        for (auto& shard : shards_) flush(*shard);
+        return accepted;
+    }
+
+    // Process-wide view, merged from the shards
+    [[nodiscard]] uint64_t ticks_processed() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards_) total += shard->router.ticks_processed();
+        return total;
+    }
+
+    [[nodiscard]] uint64_t signals_generated() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards_) total += shard->router.signals_generated();
+        return total;
+    }
+
+    [[nodiscard]] uint64_t ticks_dropped() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard->ticks_dropped.load(std::memory_order_acquire);
+        }
+        return total;
+    }
+
+    void merge_latency(LatencyHistogram& out) const {
+        for (const auto& shard : shards_) out.merge_from(shard->router.latency_histogram());
+    }
+
+    // Every shard's snapshot merged (each shard's part is self-consistent)
+    [[nodiscard]] RouterSnapshot snapshot() const {
+        RouterSnapshot merged = shards_.front()->router.snapshot();
+        for (std::size_t i = 1; i < shards_.size(); ++i) {
+            merged.merge(shards_[i]->router.snapshot());
+        }
+        return merged;
+    }
+
+    [[nodiscard]] double get_correlation(SymbolId symbol1, SymbolId symbol2) const {
+        for (const auto& shard : shards_) {
+            if (shard->router.watches_pair(symbol1, symbol2)) {
+                return shard->router.get_correlation(symbol1, symbol2);
+            }
+        }
+        return 0.0;
+    }
+
+    // Per-shard access
+    [[nodiscard]] std::size_t num_shards() const noexcept { return shards_.size(); }
+
+    [[nodiscard]] const Router& shard_router(std::size_t shard) const {
+        return shards_.at(shard)->router;
+    }
+
+    [[nodiscard]] double shard_fill_ratio(std::size_t shard) const {
+        return shards_.at(shard)->queue.fill_ratio();
+    }
+
+    // Owning shard, or num_shards() if the symbol has not been seen yet
+    [[nodiscard]] std::size_t shard_of(SymbolId symbol) const noexcept {
+        return symbol < owner_.size() && owner_[symbol] != UNASSIGNED
+            ? owner_[symbol] : shards_.size();
+    }
+
+private:
+    [[nodiscard]] std::size_t least_loaded_shard() const noexcept {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < shards_.size(); ++i) {
+            if (shards_[i]->symbol_count < shards_[best]->symbol_count) best = i;
+        }
+        return best;
+    }
+
+    // Unseen symbols go to the shard with the fewest symbols
+    std::size_t shard_for(SymbolId symbol) {
+        if (symbol >= owner_.size()) return 0;
+        if (owner_[symbol] == UNASSIGNED) {
+            assign_symbol(symbol, least_loaded_shard());
+        }
+        return owner_[symbol];
+    }
+
+    // Staged ticks never exceed the room measured for them, so this cannot fail
+    void flush(Shard& shard) noexcept {
+        const std::size_t count = shard.staged_count;
+        if (count == 0) return;
+        shard.staged_count = 0;
+        [[maybe_unused]] const std::size_t pushed = shard.queue.try_push_n(shard.staged, count);
+        assert(pushed == count);
+    }
+
+    void run_shard(Shard& shard) {
+        auto handler = [&shard](const Tick& tick) { shard.router.process_tick(tick); };
+
+        while (running_.load(std::memory_order_acquire)) {
+            if (shard.queue.consume_all(handler) == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        // Drain what was dispatched before stop()
+        while (shard.queue.consume_all(handler) > 0) {}
+    }
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include "md/spsc_queue.hpp"
+#include "md/tick.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Takes signals off the tick thread. The producer (one Router) publishes into
+// preallocated SPSC rings without allocating or blocking. Every registered
+// sink (logger, CSV writer, gateway...) gets its own ring and drain thread,
+// so a slow journal or logger never delays the gateway: it only backs up its
+// own ring, and once that is full it misses new signals (counted per sink)
+// while the other sinks keep receiving them. process_tick never waits; it
+// pays one ring push per sink.
+//
+// Threading: add sinks before start(). publish() from a single producer
+// thread. Each sink runs on its own drain thread only, so it needs no locking
+// against itself; sinks sharing state must synchronise with each other.
+class SignalDispatcher {
+public:
+    static constexpr std::size_t RING_SIZE = 16384;
+    using Ring = SPSCQueue<SignalEvent, RING_SIZE>;
+    using SignalSink = std::function<void(const SignalEvent&)>;
+
+private:
+    static constexpr auto IDLE_SLEEP = std::chrono::microseconds(50);
+
+    struct Consumer {
+        SignalSink sink;
+        Ring ring;
+        std::thread drain_thread;
+        alignas(64) std::atomic<uint64_t> dropped{0};    // Producer side
+        alignas(64) std::atomic<uint64_t> delivered{0};  // Drain side
+
+        explicit Consumer(SignalSink s) : sink(std::move(s)) {}
+
+        std::size_t drain() {
+            const std::size_t n = ring.consume_all(sink);
+            delivered.fetch_add(n, std::memory_order_relaxed);
+            return n;
+        }
+    };
+
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+    std::atomic<bool> running_{false};
+
+    alignas(64) std::atomic<uint64_t> published_{0};  // Producer side
+    std::atomic<uint64_t> dropped_{0};
+
+public:
+    SignalDispatcher() = default;
+    ~SignalDispatcher() { stop(); }
+
+    SignalDispatcher(const SignalDispatcher&) = delete;
+    SignalDispatcher& operator=(const SignalDispatcher&) = delete;
+
+    void add_sink(SignalSink sink) {
+        if (running_.load(std::memory_order_acquire)) {
+            throw std::logic_error("SignalDispatcher sinks must be added before start()");
+        }
+        consumers_.push_back(std::make_unique<Consumer>(std::move(sink)));
+    }
+
+    void start() {
+        if (running_.exchange(true, std::memory_order_acq_rel)) return;
+        for (auto& consumer : consumers_) {
+            consumer->drain_thread = std::thread([this, c = consumer.get()]() { run(*c); });
+        }
+    }
+
+    // Stops the drain threads after each delivers everything already published
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+        for (auto& consumer : consumers_) {
+            if (consumer->drain_thread.joinable()) consumer->drain_thread.join();
+        }
+    }
+
+    // Producer thread only; false (and counted) when any sink's ring is
+    // full. The sinks with room still get the signal.
+    bool publish(const SignalEvent& event) noexcept {
+        bool all = true;
+        for (auto& consumer : consumers_) {
+            if (!consumer->ring.push(event)) {
+                consumer->dropped.fetch_add(1, std::memory_order_relaxed);
+                all = false;
+            }
+        }
+        (all ? published_ : dropped_).fetch_add(1, std::memory_order_relaxed);
+        return all;
+    }
+
+    // Deliver pending signals on the calling thread; for use without start()
+    // (tests, single-threaded replay). Returns the number of sink calls made.
+    std::size_t drain() {
+        std::size_t n = 0;
+        for (auto& consumer : consumers_) n += consumer->drain();
+        return n;
+    }
+
+    // Statistics. Signals every sink received, and signals at least one missed.
+    [[nodiscard]] uint64_t published() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_acquire);
+    }
+
+    // Delivered by the furthest-behind sink
+    [[nodiscard]] uint64_t delivered() const noexcept {
+        if (consumers_.empty()) return 0;
+        uint64_t least = UINT64_MAX;
+        for (std::size_t i = 0; i < consumers_.size(); ++i) least = std::min(least, sink_delivered(i));
+        return least;
+    }
+
+    // Fullest sink ring
+    [[nodiscard]] double fill_ratio() const noexcept {
+        double fullest = 0.0;
+        for (const auto& consumer : consumers_) fullest = std::max(fullest, consumer->ring.fill_ratio());
+        return fullest;
+    }
+
+    // Per sink, in add_sink() order
+    [[nodiscard]] std::size_t sink_count() const noexcept { return consumers_.size(); }
+
+    [[nodiscard]] uint64_t sink_delivered(std::size_t sink) const {
+        return consumers_.at(sink)->delivered.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t sink_dropped(std::size_t sink) const {
+        return consumers_.at(sink)->dropped.load(std::memory_order_acquire);
+    }
+
+private:
+    void run(Consumer& consumer) {
+        while (running_.load(std::memory_order_acquire)) {
+            if (consumer.drain() == 0) {
+                std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+        }
+
+        // Deliver what was published before stop()
+        while (consumer.drain() > 0) {}
+    }
+};
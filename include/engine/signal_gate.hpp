@@ -0,0 +1,94 @@
+#pragma once
+#include "md/tick.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// How a rule's raw trigger condition turns into emitted signals
+enum class EmissionMode : uint8_t {
+    LEVEL,          // Every tick the condition holds (the raw rule output)
+    EDGE,           // Once per transition into the condition
+    HYSTERESIS,     // Once per excursion; re-arms only after clearing by a band
+    RATE_LIMITED    // While the condition holds, at most once per interval
+};
+
+struct EmissionPolicy {
+    EmissionMode mode{EmissionMode::LEVEL};
+    double rearm_band{0.0};                        // HYSTERESIS, in strength units
+    std::chrono::nanoseconds min_interval{0};      // RATE_LIMITED
+
+    [[nodiscard]] static constexpr EmissionPolicy level() noexcept { return {}; }
+
+    [[nodiscard]] static constexpr EmissionPolicy edge() noexcept {
+        return {EmissionMode::EDGE, 0.0, std::chrono::nanoseconds{0}};
+    }
+
+    [[nodiscard]] static constexpr EmissionPolicy hysteresis(double band) noexcept {
+        return {EmissionMode::HYSTERESIS, band, std::chrono::nanoseconds{0}};
+    }
+
+    [[nodiscard]] static constexpr EmissionPolicy rate_limited(std::chrono::nanoseconds interval) noexcept {
+        return {EmissionMode::RATE_LIMITED, 0.0, interval};
+    }
+};
+
+// One policy per signal type, indexed by SignalEvent::Type
+inline constexpr std::size_t SIGNAL_TYPE_COUNT = 5;
+static_assert(static_cast<std::size_t>(SignalEvent::Type::VOLUME_SPIKE) + 1 == SIGNAL_TYPE_COUNT,
+              "SIGNAL_TYPE_COUNT must cover every SignalEvent::Type");
+using EmissionPolicies = std::array<EmissionPolicy, SIGNAL_TYPE_COUNT>;
+
+[[nodiscard]] constexpr std::size_t signal_type_index(SignalEvent::Type type) noexcept {
+    return static_cast<std::size_t>(type);
+}
+
+// Per-rule-instance emission state. admit() is called after every evaluation:
+// fired is the rule's raw output and margin its signed distance into the
+// trigger region (>= 0 while triggered, negative once clear), which is what
+// the hysteresis band is measured against.
+class SignalGate {
+private:
+    TickClock::time_point last_emit_{};
+    bool armed_{true};
+    bool emitted_{false};
+
+public:
+    [[nodiscard]] bool admit(const EmissionPolicy& policy, bool fired, double margin,
+                             TickClock::time_point now) noexcept {
+        switch (policy.mode) {
+            case EmissionMode::LEVEL:
+                return fired;
+
+            case EmissionMode::EDGE: {
+                const bool emit = fired && armed_;
+                armed_ = !fired;
+                return emit;
+            }
+
+            case EmissionMode::HYSTERESIS:
+                if (fired && armed_) {
+                    armed_ = false;
+                    return true;
+                }
+                if (!armed_ && margin < -policy.rearm_band) {
+                    armed_ = true;
+                }
+                return false;
+
+            case EmissionMode::RATE_LIMITED:
+                if (!fired) return false;
+                if (emitted_ && now - last_emit_ < policy.min_interval) return false;
+                last_emit_ = now;
+                emitted_ = true;
+                return true;
+        }
+        return fired;
+    }
+
+    void reset() noexcept {
+        last_emit_ = {};
+        armed_ = true;
+        emitted_ = false;
+    }
+};
@@ -5,6 +5,9 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <memory>
+#include <span>
+#include <vector>
 
 // Base interface for signal rules
 class SignalRule {
@@ -16,16 +19,28 @@ public:
 };
 
 // Z-Score breakout rule - classic momentum strategy
-class ZScoreRule : public SignalRule {
+// Scores each price against the last window prices only
+class ZScoreRule final : public SignalRule {
+public:
+    static constexpr std::size_t DEFAULT_WINDOW = 256;
+    static constexpr SignalEvent::Type SIGNAL_TYPE = SignalEvent::Type::Z_SCORE_BREAK;
+    static constexpr double CONFIDENCE = 0.95;
+
 private:
-    RollingStats stats_;
+    SlidingWindowStats stats_;
     double threshold_;
     double last_value_{0.0};
     bool has_value_{false};
 
 public:
-    explicit ZScoreRule(double threshold = 2.0) noexcept
-        : threshold_(threshold) {}
+    explicit ZScoreRule(double threshold = 2.0, std::size_t window = DEFAULT_WINDOW)
+        : stats_(window)
+        , threshold_(threshold) {}
+
+    // Window kept in caller-owned storage (one slot per observation)
+    ZScoreRule(double threshold, std::span<double> window_storage)
+        : stats_(window_storage)
+        , threshold_(threshold) {}
 
     void add_observation(double value) noexcept {
         stats_.add(value);
@@ -33,8 +48,10 @@ public:
         has_value_ = true;
     }
 
+    void on_tick(const Tick& tick) noexcept { add_observation(tick.last_price); }
+
     bool evaluate(double& signal_strength) const override {
-        if (!has_value_ || stats_.count() < 10) {
+        if (!has_value_ || stats_.count() < std::min<std::size_t>(10, stats_.window())) {
             signal_strength = 0.0;
             return false;
         }
@@ -43,6 +60,11 @@ public:
         return std::abs(signal_strength) >= threshold_;
     }
 
+    // Signed distance of an evaluated strength into the trigger region
+    [[nodiscard]] double trigger_margin(double signal_strength) const noexcept {
+        return std::abs(signal_strength) - threshold_;
+    }
+
     void reset() override {
         stats_.reset();
         last_value_ = 0.0;
@@ -53,15 +75,36 @@ public:
 
     [[nodiscard]] double threshold() const noexcept { return threshold_; }
     void set_threshold(double thresh) noexcept { threshold_ = thresh; }
+    [[nodiscard]] std::size_t window() const noexcept { return stats_.window(); }
+    [[nodiscard]] const SlidingWindowStats& stats() const noexcept { return stats_; }
+    [[nodiscard]] double last_value() const noexcept { return last_value_; }
+
+    // Checkpoint the window and last observation; the threshold stays as configured
+    template <typename Out>
+    void save(Out& out) const {
+        stats_.save(out);
+        out.put(last_value_);
+        out.put(static_cast<uint8_t>(has_value_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        stats_.load(in);
+        last_value_ = in.template get<double>();
+        has_value_ = in.template get<uint8_t>() != 0;
+    }
 };
 
 // Correlation breakdown rule - pairs trading signal
-class CorrelationBreakRule : public SignalRule {
+class CorrelationBreakRule final : public SignalRule {
+public:
+    static constexpr SignalEvent::Type SIGNAL_TYPE = SignalEvent::Type::CORRELATION_BREAK;
+    static constexpr double CONFIDENCE = 0.88;
+
 private:
     RollingCovar covar_;
     double correlation_threshold_;
     double min_observations_;
-    bool below_threshold_{false};
 
 public:
     explicit CorrelationBreakRule(double corr_threshold = 0.3,
@@ -86,9 +129,12 @@ public:
         return std::abs(corr) < correlation_threshold_;
     }
 
+    [[nodiscard]] double trigger_margin(double signal_strength) const noexcept {
+        return correlation_threshold_ - std::abs(signal_strength);
+    }
+
     void reset() override {
         covar_.reset();
-        below_threshold_ = false;
     }
 
     const char* name() const noexcept override { return "CorrBreak"; }
@@ -100,10 +146,23 @@ public:
     [[nodiscard]] double beta() const noexcept {
         return covar_.beta();
     }
+
+    // For a pair watched with its legs in the other order
+    void swap_legs() noexcept { covar_.swap_legs(); }
+
+    template <typename Out>
+    void save(Out& out) const { covar_.save(out); }
+
+    template <typename In>
+    void load(In& in) { covar_.load(in); }
 };
 
 // Mean reversion rule - classic reversion strategy
-class MeanReversionRule : public SignalRule {
+class MeanReversionRule final : public SignalRule {
+public:
+    static constexpr SignalEvent::Type SIGNAL_TYPE = SignalEvent::Type::PAIR_TRADE_ENTRY;
+    static constexpr double CONFIDENCE = 0.85;
+
 private:
     EMAStats fast_ema_;
     EMAStats slow_ema_;
@@ -126,6 +185,8 @@ public:
         has_value_ = true;
     }
 
+    void on_tick(const Tick& tick) noexcept { add_observation(tick.last_price); }
+
     bool evaluate(double& signal_strength) const override {
         if (!has_value_ || !fast_ema_.is_initialized() || !slow_ema_.is_initialized()) {
             signal_strength = 0.0;
@@ -146,6 +207,10 @@ public:
         return std::abs(signal_strength) >= threshold_;
     }
 
+    [[nodiscard]] double trigger_margin(double signal_strength) const noexcept {
+        return std::abs(signal_strength) - threshold_;
+    }
+
     void reset() override {
         fast_ema_.reset();
         slow_ema_.reset();
@@ -154,19 +219,45 @@ public:
     }
 
     const char* name() const noexcept override { return "MeanRev"; }
+
+    template <typename Out>
+    void save(Out& out) const {
+        fast_ema_.save(out);
+        slow_ema_.save(out);
+        out.put(last_value_);
+        out.put(static_cast<uint8_t>(has_value_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        fast_ema_.load(in);
+        slow_ema_.load(in);
+        last_value_ = in.template get<double>();
+        has_value_ = in.template get<uint8_t>() != 0;
+    }
 };
 
-// Volume spike detection
-class VolumeRule : public SignalRule {
+// Volume spike detection against the last window sizes
+class VolumeRule final : public SignalRule {
+public:
+    static constexpr std::size_t DEFAULT_WINDOW = 256;
+    static constexpr SignalEvent::Type SIGNAL_TYPE = SignalEvent::Type::VOLUME_SPIKE;
+    static constexpr double CONFIDENCE = 0.90;
+
 private:
-    RollingStats volume_stats_;
+    SlidingWindowStats volume_stats_;
     double threshold_;
     double last_volume_{0.0};
     bool has_volume_{false};
 
 public:
-    explicit VolumeRule(double threshold = 3.0) noexcept
-        : threshold_(threshold) {}
+    explicit VolumeRule(double threshold = 3.0, std::size_t window = DEFAULT_WINDOW)
+        : volume_stats_(window)
+        , threshold_(threshold) {}
+
+    VolumeRule(double threshold, std::span<double> window_storage)
+        : volume_stats_(window_storage)
+        , threshold_(threshold) {}
 
     void add_volume(double volume) noexcept {
         volume_stats_.add(volume);
@@ -174,8 +265,10 @@ public:
         has_volume_ = true;
     }
 
+    void on_tick(const Tick& tick) noexcept { add_volume(tick.last_size); }
+
     bool evaluate(double& signal_strength) const override {
-        if (!has_volume_ || volume_stats_.count() < 20) {
+        if (!has_volume_ || volume_stats_.count() < std::min<std::size_t>(20, volume_stats_.window())) {
             signal_strength = 0.0;
             return false;
         }
@@ -184,6 +277,10 @@ public:
         return signal_strength >= threshold_; // Only positive spikes
     }
 
+    [[nodiscard]] double trigger_margin(double signal_strength) const noexcept {
+        return signal_strength - threshold_;
+    }
+
     void reset() override {
         volume_stats_.reset();
         last_volume_ = 0.0;
@@ -191,9 +288,29 @@ public:
     }
 
     const char* name() const noexcept override { return "Volume"; }
+
+    [[nodiscard]] std::size_t window() const noexcept { return volume_stats_.window(); }
+    [[nodiscard]] const SlidingWindowStats& stats() const noexcept { return volume_stats_; }
+    [[nodiscard]] double last_volume() const noexcept { return last_volume_; }
+
+    template <typename Out>
+    void save(Out& out) const {
+        volume_stats_.save(out);
+        out.put(last_volume_);
+        out.put(static_cast<uint8_t>(has_volume_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        volume_stats_.load(in);
+        last_volume_ = in.template get<double>();
+        has_volume_ = in.template get<uint8_t>() != 0;
+    }
 };
 
 // Composite rule engine - combines multiple signals
+// Runtime-configured rule sets; a fixed set is cheaper as a StaticRulePipeline
+// (engine/rule_pipeline.hpp)
 class CompositeSignalEngine {
 private:
     std::vector<std::unique_ptr<SignalRule>> rules_;
@@ -0,0 +1,155 @@
+#pragma once
+#include "md/tick.hpp"
+#include "util/clock.hpp"
+#include "util/latency.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Per-stage timing of Router::process_tick. Probes are compiled in only with
+// -DRT_ENABLE_TRACING (CMake option RT_ENABLE_TRACING); otherwise the Router
+// holds no profiler and the probes fold away entirely.
+#if defined(RT_ENABLE_TRACING)
+inline constexpr bool TRACING_ENABLED = true;
+#else
+inline constexpr bool TRACING_ENABLED = false;
+#endif
+
+// Stages of one tick. SIGNAL_EMIT (dispatcher publish and callback) runs inside
+// the rule stage that fired it, so that stage's time includes it.
+enum class TraceStage : uint8_t {
+    QUEUE_DWELL,    // Tick timestamp to process_tick() start
+    SINGLE_RULES,   // Rule lookup plus the Z-score, volume and mean reversion pipeline
+    CROSS_RULES,    // Pair correlation loop
+    SIGNAL_EMIT,
+    TICK_TOTAL,     // process_tick() start to end
+};
+
+inline constexpr std::size_t TRACE_STAGE_COUNT = 5;
+
+[[nodiscard]] constexpr const char* trace_stage_name(TraceStage stage) noexcept {
+    switch (stage) {
+        case TraceStage::QUEUE_DWELL: return "queue_dwell";
+        case TraceStage::SINGLE_RULES: return "single_rules";
+        case TraceStage::CROSS_RULES: return "cross_rules";
+        case TraceStage::SIGNAL_EMIT: return "signal_emit";
+        case TraceStage::TICK_TOTAL: return "tick_total";
+    }
+    return "unknown";
+}
+
+// One timed span, 16 bytes so a ring of them stays cache-friendly
+struct TraceEvent {
+    int64_t begin_ns{0};        // TickClock time since epoch
+    uint32_t duration_ns{0};    // Saturates at ~4.3 s
+    SymbolId symbol{INVALID_SYMBOL_ID};
+    TraceStage stage{TraceStage::TICK_TOTAL};
+};
+
+// Fixed-size ring of the most recent events, overwritten oldest first.
+// Single writer; read it only while the writer is idle.
+class TraceRing {
+private:
+    std::unique_ptr<TraceEvent[]> events_;
+    std::size_t mask_;
+    uint64_t written_{0};
+
+public:
+    // capacity: power of 2
+    explicit TraceRing(std::size_t capacity)
+        : events_(std::make_unique<TraceEvent[]>(capacity))
+        , mask_(capacity - 1) {
+        if (capacity == 0 || (capacity & mask_) != 0) {
+            throw std::invalid_argument("TraceRing capacity must be a power of 2");
+        }
+    }
+
+    void record(const TraceEvent& event) noexcept {
+        events_[written_++ & mask_] = event;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+    [[nodiscard]] uint64_t written() const noexcept { return written_; }
+    [[nodiscard]] std::size_t size() const noexcept {
+        return static_cast<std::size_t>(std::min<uint64_t>(written_, capacity()));
+    }
+
+    // Retained events, oldest first
+    [[nodiscard]] std::vector<TraceEvent> events() const {
+        std::vector<TraceEvent> out;
+        out.reserve(size());
+        for (uint64_t i = written_ - size(); i < written_; ++i) {
+            out.push_back(events_[i & mask_]);
+        }
+        return out;
+    }
+
+    void clear() noexcept { written_ = 0; }
+};
+
+// A histogram per stage plus an optional trace ring. Written by the tick
+// thread; histograms may be read from any thread, the ring only while idle.
+class StageProfiler {
+public:
+    static constexpr int SIGNIFICANT_DIGITS = 2;
+    static constexpr uint64_t HIGHEST_TRACKABLE_NS = 1'000'000'000ull;  // 1 s
+
+private:
+    std::array<LatencyHistogram, TRACE_STAGE_COUNT> histograms_;
+    std::unique_ptr<TraceRing> trace_;
+
+public:
+    StageProfiler()
+        : histograms_(make_histograms(std::make_index_sequence<TRACE_STAGE_COUNT>{})) {}
+
+    // Keep the last capacity spans (power of 2) for write_chrome_trace().
+    // Call before ticks flow.
+    void enable_trace(std::size_t capacity) {
+        trace_ = std::make_unique<TraceRing>(capacity);
+    }
+
+    void record(TraceStage stage, SymbolId symbol,
+                TickClock::time_point begin, TickClock::time_point end) noexcept {
+        const int64_t begin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            begin.time_since_epoch()).count();
+        const int64_t duration_ns = std::max<int64_t>(
+            0, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        histograms_[static_cast<std::size_t>(stage)].add_sample_ns_exclusive(
+            static_cast<uint64_t>(duration_ns));
+        if (trace_) {
+            trace_->record(TraceEvent{begin_ns,
+                                      static_cast<uint32_t>(std::min<int64_t>(duration_ns, UINT32_MAX)),
+                                      symbol, stage});
+        }
+    }
+
+    [[nodiscard]] const LatencyHistogram& histogram(TraceStage stage) const noexcept {
+        return histograms_[static_cast<std::size_t>(stage)];
+    }
+
+    // Null unless enable_trace() was called
+    [[nodiscard]] const TraceRing* trace() const noexcept { return trace_.get(); }
+
+    void reset() noexcept {
+        for (auto& histogram : histograms_) histogram.reset();
+        if (trace_) trace_->clear();
+    }
+
+private:
+    template <std::size_t... I>
+    static std::array<LatencyHistogram, TRACE_STAGE_COUNT> make_histograms(std::index_sequence<I...>) {
+        return {((void)I, LatencyHistogram(SIGNIFICANT_DIGITS, HIGHEST_TRACKABLE_NS))...};
+    }
+};
+
+// Chrome trace event JSON ("X" complete events), loadable in chrome://tracing
+// and ui.perfetto.dev. Queue dwell goes on its own track since it overlaps the
+// previous tick's processing; timestamps are relative to the earliest event.
+void write_chrome_trace(std::ostream& out, std::span<const TraceEvent> events);
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Checkpoint images (engine/checkpoint.hpp) on disk.
+
+// Replace path with image atomically: write path.tmp, fsync, rename, so a
+// crash mid-write leaves the previous checkpoint intact. Throws
+// std::runtime_error.
+void write_checkpoint_file(const std::string& path, std::span<const std::byte> image);
+
+// Read-only memory map of a checkpoint file; pass bytes() to Router::restore()
+class CheckpointMapping {
+private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+
+public:
+    // Throws std::runtime_error if the file is missing or cannot be mapped;
+    // the image itself is validated by Router::restore()
+    explicit CheckpointMapping(const std::string& path);
+    ~CheckpointMapping();
+
+    CheckpointMapping(const CheckpointMapping&) = delete;
+    CheckpointMapping& operator=(const CheckpointMapping&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+};
+
+// Writes checkpoint images on its own thread. submit() swaps the caller's
+// image with the writer's spare buffer and returns at once, so the tick
+// thread pays for Router::checkpoint() but never for disk I/O; while the
+// previous image is still being written the new one is skipped, not queued.
+class CheckpointWriter {
+private:
+    std::string path_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<std::byte> pending_;
+    bool busy_{false};  // An image is pending or being written
+    bool stopping_{false};
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::string error_;  // Last failure, under mutex_
+    std::thread thread_;  // Last: starts once the rest is constructed
+
+public:
+    explicit CheckpointWriter(std::string path);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Hand image over (it gets back an old buffer to reuse); false, and
+    // counted as skipped, while the writer is busy. Never blocks.
+    bool submit(std::vector<std::byte>& image);
+
+    // Write any pending image, then stop the thread
+    void stop();
+
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+    [[nodiscard]] uint64_t checkpoints_written() const noexcept {
+        return written_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t checkpoints_skipped() const noexcept {
+        return skipped_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t failures() const noexcept {
+        return failures_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::string last_error();
+
+private:
+    void run();
+};
@@ -0,0 +1,387 @@
+#pragma once
+#include "md/spsc_queue.hpp"
+#include "md/tick.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Append-only binary journal of fixed-size records.
+//
+// File layout: one 64-byte JournalHeader, then records back to back. A file
+// cut short by a crash is still readable up to its last whole record. Files
+// of a session are named <prefix>-<session>-<index>.rtj and rotate once they
+// reach JournalConfig::max_file_bytes.
+
+enum class JournalKind : uint32_t {
+    SIGNALS = 1,
+    TICKS = 2
+};
+
+inline constexpr char JOURNAL_MAGIC[8] = {'R', 'T', 'J', 'R', 'N', 'L', '\0', '\0'};
+inline constexpr uint32_t JOURNAL_VERSION = 1;
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    JournalKind kind;
+    uint32_t record_size;
+    uint32_t file_index;        // Position of this file in its session
+    int64_t wall_clock_ns;      // system_clock at session start
+    int64_t steady_clock_ns;    // Record timestamps' clock at the same instant
+    char reserved[24];
+};
+static_assert(sizeof(JournalHeader) == 64);
+
+// Copy a symbol name into a fixed, NUL-terminated field (truncating)
+template <std::size_t N>
+void copy_symbol(char (&dest)[N], std::string_view name) noexcept {
+    const std::size_t n = std::min(name.size(), N - 1);
+    std::memcpy(dest, name.data(), n);
+    std::memset(dest + n, 0, N - n);
+}
+
+// One SignalEvent; names are stored so a journal reads back without the
+// process's SymbolTable
+struct SignalRecord {
+    static constexpr JournalKind KIND = JournalKind::SIGNALS;
+
+    int64_t event_time_ns;
+    int64_t generation_time_ns;
+    uint64_t signal_id;
+    double signal_strength;
+    double confidence;
+    uint32_t primary_id;
+    uint32_t secondary_id;
+    uint8_t event_type;
+    uint8_t reserved[7];
+    char primary_symbol[16];
+    char secondary_symbol[16];
+    uint8_t padding[8];
+
+    [[nodiscard]] static SignalRecord from(const SignalEvent& event) noexcept {
+        SignalRecord record{};
+        record.event_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            event.event_time.time_since_epoch()).count();
+        record.generation_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            event.generation_time.time_since_epoch()).count();
+        record.signal_id = event.signal_id;
+        record.signal_strength = event.signal_strength;
+        record.confidence = event.confidence;
+        record.primary_id = event.primary_id;
+        record.secondary_id = event.secondary_id;
+        record.event_type = static_cast<uint8_t>(event.event_type);
+        copy_symbol(record.primary_symbol, event.primary_symbol);
+        copy_symbol(record.secondary_symbol, event.secondary_symbol);
+        return record;
+    }
+};
+static_assert(sizeof(SignalRecord) == 96 && std::is_trivially_copyable_v<SignalRecord>);
+
+struct TickRecord {
+    static constexpr JournalKind KIND = JournalKind::TICKS;
+
+    int64_t timestamp_ns;
+    uint64_t sequence_id;
+    double last_price;
+    double bid_price;
+    double ask_price;
+    double last_size;
+    uint32_t symbol_id;
+    uint32_t reserved;
+    char symbol[16];
+
+    [[nodiscard]] static TickRecord from(const Tick& tick) noexcept {
+        TickRecord record{};
+        record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            tick.timestamp.time_since_epoch()).count();
+        record.sequence_id = tick.sequence_id;
+        record.last_price = tick.last_price;
+        record.bid_price = tick.bid_price;
+        record.ask_price = tick.ask_price;
+        record.last_size = tick.last_size;
+        record.symbol_id = tick.symbol_id;
+        copy_symbol(record.symbol, tick.symbol());
+        return record;
+    }
+};
+static_assert(sizeof(TickRecord) == 72 && std::is_trivially_copyable_v<TickRecord>);
+
+// Write end of one journal file (POSIX fd, no stdio buffering)
+class JournalFile {
+private:
+    int fd_{-1};
+    uint64_t bytes_written_{0};
+
+public:
+    JournalFile() = default;
+    ~JournalFile() { close(); }
+
+    JournalFile(const JournalFile&) = delete;
+    JournalFile& operator=(const JournalFile&) = delete;
+
+    // Create (truncating) path and write header; throws std::runtime_error
+    void open(const std::string& path, const JournalHeader& header);
+
+    // Write all bytes; throws std::runtime_error
+    void write(const void* data, std::size_t bytes);
+
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+    [[nodiscard]] uint64_t bytes_written() const noexcept { return bytes_written_; }
+};
+
+// Read-only memory map of a journal file
+class JournalMapping {
+private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+    JournalHeader header_{};
+
+public:
+    // Throws std::runtime_error if the file is missing or not a journal
+    explicit JournalMapping(const std::string& path);
+    ~JournalMapping();
+
+    JournalMapping(const JournalMapping&) = delete;
+    JournalMapping& operator=(const JournalMapping&) = delete;
+
+    [[nodiscard]] const JournalHeader& header() const noexcept { return header_; }
+
+    [[nodiscard]] const std::byte* records() const noexcept {
+        return data_ ? data_ + sizeof(JournalHeader) : nullptr;
+    }
+
+    // Whole records only; a torn tail is ignored
+    [[nodiscard]] std::size_t record_count() const noexcept {
+        return size_ > sizeof(JournalHeader) && header_.record_size > 0
+            ? (size_ - sizeof(JournalHeader)) / header_.record_size : 0;
+    }
+};
+
+// Typed view over one mapped file
+template <typename Record>
+class JournalReader {
+private:
+    JournalMapping mapping_;
+
+public:
+    explicit JournalReader(const std::string& path) : mapping_(path) {
+        const auto& header = mapping_.header();
+        if (header.kind != Record::KIND || header.record_size != sizeof(Record)) {
+            throw std::runtime_error("Journal " + path + " holds a different record type");
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return mapping_.record_count(); }
+
+    [[nodiscard]] const Record* begin() const noexcept {
+        return reinterpret_cast<const Record*>(mapping_.records());
+    }
+
+    [[nodiscard]] const Record* end() const noexcept { return begin() + size(); }
+
+    [[nodiscard]] const Record& operator[](std::size_t i) const noexcept { return begin()[i]; }
+
+    [[nodiscard]] const JournalHeader& header() const noexcept { return mapping_.header(); }
+};
+
+struct JournalConfig {
+    std::string directory{"data/journal"};
+    std::string prefix{"journal"};
+    uint64_t max_file_bytes{256ull << 20};                      // Rotate after this much
+    std::chrono::milliseconds flush_interval{100};              // Bound on unwritten data age
+};
+
+// Session id from the wall clock and pid, e.g. "20250101-093000-4242"
+[[nodiscard]] std::string make_journal_session_id();
+
+[[nodiscard]] JournalHeader make_journal_header(JournalKind kind, uint32_t record_size,
+                                                uint32_t file_index, int64_t wall_clock_ns,
+                                                int64_t steady_clock_ns) noexcept;
+
+// Background journal writer. append() copies the record into an SPSC ring and
+// returns; the writer thread batches records into WRITE_BUFFER_BYTES chunks
+// and writes them out, rotating files as they fill.
+//
+// Threading: append() from a single producer thread (typically a
+// SignalDispatcher sink). files() is stable after stop().
+template <typename Record>
+class JournalWriter {
+public:
+    static constexpr std::size_t RING_SIZE = 16384;
+    static constexpr std::size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+private:
+    static_assert(std::is_trivially_copyable_v<Record>);
+    static constexpr auto IDLE_SLEEP = std::chrono::microseconds(200);
+
+    using Ring = SPSCQueue<Record, RING_SIZE>;
+
+    JournalConfig config_;
+    std::string session_;
+    int64_t wall_clock_ns_{0};
+    int64_t steady_clock_ns_{0};
+
+    std::unique_ptr<Ring> ring_{std::make_unique<Ring>()};
+    std::vector<std::byte> buffer_;
+    JournalFile file_;
+    std::vector<std::string> files_;
+    std::thread writer_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> failed_{false};
+    std::string error_;  // Set by the writer thread before failed_
+
+    alignas(64) std::atomic<uint64_t> records_dropped_{0};  // Producer side
+    alignas(64) std::atomic<uint64_t> records_written_{0};  // Writer side
+
+public:
+    explicit JournalWriter(JournalConfig config)
+        : config_(std::move(config)) {
+        if (config_.max_file_bytes < sizeof(JournalHeader) + sizeof(Record)) {
+            throw std::invalid_argument("Journal max_file_bytes too small for one record");
+        }
+        buffer_.reserve(WRITE_BUFFER_BYTES);
+    }
+
+    ~JournalWriter() { stop(); }
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // Opens the session's first file (throws on I/O errors) and starts writing
+    void start() {
+        if (running_.load(std::memory_order_acquire)) return;
+        std::filesystem::create_directories(config_.directory);
+        session_ = make_journal_session_id();
+        wall_clock_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        steady_clock_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            SignalClock::now().time_since_epoch()).count();
+        open_next_file();
+        running_.store(true, std::memory_order_release);
+        writer_thread_ = std::thread([this]() { run(); });
+    }
+
+    // Writes everything appended so far, then closes the file
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+        if (writer_thread_.joinable()) writer_thread_.join();
+    }
+
+    // Producer thread only; false (and counted) when the ring is full
+    bool append(const Record& record) noexcept {
+        if (!ring_->push(record)) {
+            records_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] uint64_t records_written() const noexcept {
+        return records_written_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t records_dropped() const noexcept {
+        return records_dropped_.load(std::memory_order_acquire);
+    }
+
+    // An I/O error stops the writer; later records pile up and are dropped
+    [[nodiscard]] bool failed() const noexcept { return failed_.load(std::memory_order_acquire); }
+    [[nodiscard]] const std::string& error() const noexcept { return error_; }
+
+    [[nodiscard]] const std::vector<std::string>& files() const noexcept { return files_; }
+    [[nodiscard]] const std::string& session() const noexcept { return session_; }
+
+private:
+    void open_next_file() {
+        const auto index = static_cast<uint32_t>(files_.size());
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "-%04u.rtj", index);
+        std::string path = config_.directory + "/" + config_.prefix + "-" + session_ + suffix;
+
+        file_.close();
+        file_.open(path, make_journal_header(Record::KIND, sizeof(Record), index,
+                                             wall_clock_ns_, steady_clock_ns_));
+        files_.push_back(std::move(path));
+    }
+
+    void flush() {
+        std::size_t offset = 0;
+        while (offset < buffer_.size()) {
+            // Fill the current file up to the rotation limit, in whole records
+            const uint64_t room = config_.max_file_bytes - file_.bytes_written();
+            const std::size_t fits = static_cast<std::size_t>(room / sizeof(Record)) * sizeof(Record);
+            if (fits == 0) {
+                open_next_file();
+                continue;
+            }
+            const std::size_t chunk = std::min(fits, buffer_.size() - offset);
+            file_.write(buffer_.data() + offset, chunk);
+            offset += chunk;
+            records_written_.fetch_add(chunk / sizeof(Record), std::memory_order_relaxed);
+        }
+        buffer_.clear();
+    }
+
+    void run() {
+        try {
+            write_loop();
+        } catch (const std::exception& e) {
+            error_ = e.what();
+            failed_.store(true, std::memory_order_release);
+        }
+        file_.close();
+    }
+
+    void write_loop() {
+        auto handler = [this](const Record& record) {
+            const auto* bytes = reinterpret_cast<const std::byte*>(&record);
+            buffer_.insert(buffer_.end(), bytes, bytes + sizeof(Record));
+        };
+        constexpr std::size_t BATCH = WRITE_BUFFER_BYTES / sizeof(Record);
+        auto room = [this]() { return BATCH - buffer_.size() / sizeof(Record); };
+        auto last_flush = std::chrono::steady_clock::now();
+
+        while (running_.load(std::memory_order_acquire)) {
+            const std::size_t n = ring_->consume_all(handler, room());
+
+            const auto now = std::chrono::steady_clock::now();
+            if (room() == 0 || (!buffer_.empty() && now - last_flush >= config_.flush_interval)) {
+                flush();
+                last_flush = now;
+            }
+            if (n == 0) {
+                std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+        }
+
+        // Everything appended before stop()
+        for (;;) {
+            if (room() == 0) flush();
+            if (ring_->consume_all(handler, room()) == 0) break;
+        }
+        flush();
+    }
+};
+
+using SignalJournal = JournalWriter<SignalRecord>;
+using TickJournal = JournalWriter<TickRecord>;
+
+// Converters for the Python tooling. Signal CSV matches the demo's
+// data/signals.csv columns; both return the number of rows written.
+std::size_t write_signal_journal_csv(const std::vector<std::string>& paths, std::ostream& out);
+std::size_t write_tick_journal_csv(const std::vector<std::string>& paths, std::ostream& out);
@@ -0,0 +1,63 @@
+#pragma once
+#include "engine/router_snapshot.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Prometheus text exposition (format 0.0.4) of Router metrics, and a minimal
+// HTTP endpoint serving it. Scrapers and the Streamlit dashboards poll
+// GET /metrics instead of re-running the binary.
+
+// Counters, the tick latency summary and per-symbol gauges, names prefixed
+// with prefix (e.g. rt_ticks_processed_total)
+void write_prometheus(std::ostream& out, const RouterSnapshot& snapshot, std::string_view prefix = "rt");
+
+// One extra gauge (queue fill, drop counts, ...) in the same format
+void write_prometheus_gauge(std::ostream& out, std::string_view name, std::string_view help, double value);
+
+struct MetricsServerConfig {
+    std::string bind_address{"127.0.0.1"};
+    uint16_t port{9464};    // 0: any free port, see MetricsHttpServer::port()
+};
+
+// Single-threaded HTTP/1.0 server: one request per connection, GET /metrics
+// answered with provider()'s text. provider runs on the server thread, so it
+// must only use thread-safe reads such as Router::snapshot().
+class MetricsHttpServer {
+public:
+    using Provider = std::function<std::string()>;
+
+private:
+    Provider provider_;
+    MetricsServerConfig config_;
+    int listen_fd_{-1};
+    uint16_t port_{0};
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> requests_served_{0};
+
+public:
+    explicit MetricsHttpServer(Provider provider, MetricsServerConfig config = {});
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    // Bind and listen (throws std::runtime_error), then serve on a background thread
+    void start();
+    void stop();
+
+    [[nodiscard]] uint16_t port() const noexcept { return port_; }
+    [[nodiscard]] bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+    [[nodiscard]] uint64_t requests_served() const noexcept {
+        return requests_served_.load(std::memory_order_acquire);
+    }
+
+private:
+    void run();
+    void handle_connection(int fd);
+};
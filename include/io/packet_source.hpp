@@ -0,0 +1,39 @@
+#pragma once
+#include "util/clock.hpp"
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <thread>
+
+// One received datagram. data points into the source's own buffers and stays
+// valid until the next receive() on that source.
+struct PacketView {
+    const std::byte* data{nullptr};
+    std::size_t size{0};
+    TickClock::time_point rx_time;  // When the batch came off the socket / NIC ring
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data, size}; }
+};
+
+// Batch packet input behind FeedHandler. The kernel UDP receiver implements
+// it today; a kernel-bypass backend (ef_vi, DPDK) only has to hand out views
+// into its RX ring the same way, so one virtual call is paid per batch, not
+// per packet.
+class PacketSource {
+public:
+    virtual ~PacketSource() = default;
+
+    // Fill out with up to out.size() packets already waiting, without
+    // blocking; 0 when there are none. Invalidates the previous batch's views.
+    virtual std::size_t receive(std::span<PacketView> out) = 0;
+
+    // Largest batch one receive() can return
+    [[nodiscard]] virtual std::size_t max_batch() const noexcept = 0;
+
+    // Block until a packet may be waiting or timeout passes (idle path of
+    // WaitStrategy::BLOCKING). Polling-only backends keep the default yield.
+    virtual void wait_readable(std::chrono::milliseconds timeout) {
+        (void)timeout;
+        std::this_thread::yield();
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "io/packet_source.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct mmsghdr;
+struct iovec;
+
+struct UdpReceiverConfig {
+    std::string bind_address{"0.0.0.0"};
+    uint16_t port{0};                       // 0: any free port, see UdpReceiver::port()
+    std::string multicast_group;            // Empty: plain unicast socket
+    std::string interface_address{"0.0.0.0"};  // Interface joining the group (0.0.0.0: kernel's choice)
+    std::size_t batch_size{32};             // Datagrams per recvmmsg call
+    std::size_t max_packet_bytes{2048};     // Larger datagrams are counted as truncated and dropped
+    int receive_buffer_bytes{4 << 20};      // SO_RCVBUF; absorbs bursts while the handler is busy
+    int busy_poll_us{0};                    // SO_BUSY_POLL budget (0: off; raising it needs CAP_NET_ADMIN)
+};
+
+// Non-blocking UDP (optionally multicast) socket read with recvmmsg, so a
+// burst costs one system call per batch. The whole batch shares one
+// TickClock stamp taken right after the call returns. With busy_poll_us set,
+// the kernel polls the NIC queue from the receive call instead of waiting
+// for the interrupt; busy_poll() reports whether it was granted.
+//
+// Single consumer: receive() and the buffers it hands out belong to one thread.
+class UdpReceiver final : public PacketSource {
+private:
+    UdpReceiverConfig config_;
+    int fd_{-1};
+    uint16_t port_{0};
+    bool busy_poll_{false};
+
+    std::unique_ptr<std::byte[]> buffers_;   // batch_size slots of max_packet_bytes
+    std::unique_ptr<mmsghdr[]> messages_;
+    std::unique_ptr<iovec[]> iovecs_;
+
+    std::atomic<uint64_t> packets_received_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+    std::atomic<uint64_t> packets_truncated_{0};
+    std::atomic<uint64_t> receive_errors_{0};
+
+public:
+    // Binds, joins the group and allocates the batch buffers; throws
+    // std::invalid_argument on a bad config and std::runtime_error when the
+    // socket cannot be set up
+    explicit UdpReceiver(UdpReceiverConfig config);
+    ~UdpReceiver() override;
+
+    UdpReceiver(const UdpReceiver&) = delete;
+    UdpReceiver& operator=(const UdpReceiver&) = delete;
+
+    std::size_t receive(std::span<PacketView> out) override;
+    [[nodiscard]] std::size_t max_batch() const noexcept override { return config_.batch_size; }
+    void wait_readable(std::chrono::milliseconds timeout) override;
+
+    [[nodiscard]] uint16_t port() const noexcept { return port_; }
+    [[nodiscard]] bool busy_poll() const noexcept { return busy_poll_; }
+    [[nodiscard]] const UdpReceiverConfig& config() const noexcept { return config_; }
+
+    // Statistics (any thread)
+    [[nodiscard]] uint64_t packets_received() const noexcept {
+        return packets_received_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t bytes_received() const noexcept {
+        return bytes_received_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t packets_truncated() const noexcept {
+        return packets_truncated_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t receive_errors() const noexcept {
+        return receive_errors_.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include "md/tick.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Packed 32-byte tick for queues and storage: two per cache line, half the
+// ring memory of Tick. Prices are integers on the symbol's tick-size grid and
+// the timestamp is a nanosecond offset from the codec's epoch, so a
+// CompactTick only means something together with the TickCodec that made it.
+struct alignas(32) CompactTick {
+    int64_t last_px{0};             // last_price / tick_size
+    int64_t timestamp_delta_ns{0};  // timestamp - codec epoch
+    SymbolId symbol_id{INVALID_SYMBOL_ID};
+    uint32_t size{0};               // last_size, rounded to whole units
+    uint32_t sequence{0};           // Low 32 bits of Tick::sequence_id
+    int16_t bid_offset{0};          // (last - bid) in ticks
+    int16_t ask_offset{0};          // (ask - last) in ticks
+};
+static_assert(sizeof(CompactTick) == 32 && std::is_trivially_copyable_v<CompactTick>);
+
+// Converts between Tick and CompactTick. Tick sizes are registered per symbol
+// id; unregistered symbols use DEFAULT_TICK_SIZE. Decoding is a table load
+// and a few multiplies. Register every symbol before sharing the codec
+// between threads; encode/decode themselves are const.
+class TickCodec {
+public:
+    static constexpr double DEFAULT_TICK_SIZE = 0.01;
+
+private:
+    TickClock::time_point epoch_;
+    std::vector<double> tick_size_;      // Indexed by SymbolId
+    std::vector<double> inv_tick_size_;
+
+    [[nodiscard]] double inverse_tick_size(SymbolId symbol) const noexcept {
+        return symbol < inv_tick_size_.size() ? inv_tick_size_[symbol] : 1.0 / DEFAULT_TICK_SIZE;
+    }
+
+public:
+    explicit TickCodec(TickClock::time_point epoch = TickClock::now())
+        : epoch_(epoch) {}
+
+    void set_tick_size(SymbolId symbol, double tick_size) {
+        if (symbol == INVALID_SYMBOL_ID) {
+            throw std::invalid_argument("TickCodec needs a valid symbol id");
+        }
+        if (!(tick_size > 0.0)) {
+            throw std::invalid_argument("Tick size must be positive");
+        }
+        if (symbol >= tick_size_.size()) {
+            tick_size_.resize(symbol + 1, DEFAULT_TICK_SIZE);
+            inv_tick_size_.resize(symbol + 1, 1.0 / DEFAULT_TICK_SIZE);
+        }
+        tick_size_[symbol] = tick_size;
+        inv_tick_size_[symbol] = 1.0 / tick_size;
+    }
+
+    [[nodiscard]] double tick_size(SymbolId symbol) const noexcept {
+        return symbol < tick_size_.size() ? tick_size_[symbol] : DEFAULT_TICK_SIZE;
+    }
+
+    [[nodiscard]] TickClock::time_point epoch() const noexcept { return epoch_; }
+
+    // Prices are rounded to the grid. Returns false (out untouched) when the
+    // spread does not fit the 16-bit offsets or the size the 32-bit field.
+    [[nodiscard]] bool encode(const Tick& tick, CompactTick& out) const noexcept {
+        const double inv = inverse_tick_size(tick.symbol_id);
+        const double last = std::round(tick.last_price * inv);
+        const double bid_offset = last - std::round(tick.bid_price * inv);
+        const double ask_offset = std::round(tick.ask_price * inv) - last;
+        const double size = std::round(tick.last_size);
+
+        constexpr double OFFSET_MIN = std::numeric_limits<int16_t>::min();
+        constexpr double OFFSET_MAX = std::numeric_limits<int16_t>::max();
+        if (!(bid_offset >= OFFSET_MIN && bid_offset <= OFFSET_MAX &&
+              ask_offset >= OFFSET_MIN && ask_offset <= OFFSET_MAX &&
+              size >= 0.0 && size <= std::numeric_limits<uint32_t>::max() &&
+              std::abs(last) < 0x1p62)) {
+            return false;
+        }
+
+        out.last_px = static_cast<int64_t>(last);
+        out.timestamp_delta_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            tick.timestamp - epoch_).count();
+        out.symbol_id = tick.symbol_id;
+        out.size = static_cast<uint32_t>(size);
+        out.sequence = static_cast<uint32_t>(tick.sequence_id);
+        out.bid_offset = static_cast<int16_t>(bid_offset);
+        out.ask_offset = static_cast<int16_t>(ask_offset);
+        return true;
+    }
+
+    [[nodiscard]] Tick decode(const CompactTick& compact) const noexcept {
+        const double tick_size = this->tick_size(compact.symbol_id);
+        return Tick{
+            compact.symbol_id,
+            static_cast<double>(compact.last_px) * tick_size,
+            static_cast<double>(compact.last_px - compact.bid_offset) * tick_size,
+            static_cast<double>(compact.last_px + compact.ask_offset) * tick_size,
+            static_cast<double>(compact.size),
+            compact.sequence,
+            epoch_ + std::chrono::duration_cast<TickClock::duration>(
+                std::chrono::nanoseconds(compact.timestamp_delta_ns))
+        };
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include "io/packet_source.hpp"
+#include "md/tick.hpp"
+#include "md/wire_decoders.hpp"
+#include "util/wait_strategy.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+struct FeedHandlerConfig {
+    WaitStrategy wait{WaitStrategy::BUSY_SPIN};         // Between empty receives
+    uint32_t spin_iterations{2000};                     // Empty polls before yielding/blocking
+    std::chrono::microseconds sleep_interval{10};       // SLEEP only
+    bool drop_when_full{true};  // The wire cannot be back-pressured; false spins until the consumer frees space
+};
+
+// Network feed handler: pulls packet batches from a PacketSource, decodes
+// them with Decoder and pushes the ticks straight into the tick queue the
+// Router's consumer drains. Each tick is stamped with its batch's receive
+// time, so the Router's latency histogram starts at the wire.
+//
+// The queue is anything with push() (MPMCQueue), or a try_push_n() that
+// accepts a prefix of the batch (SPSCQueue, ShardedRouter): the rest is
+// re-pushed from where the queue stopped.
+//
+// poll()/run() belong to one thread (the queue's producer); statistics may
+// be read from any thread.
+template <PacketDecoder Decoder>
+class FeedHandler {
+public:
+    static constexpr std::size_t MAX_TICKS_PER_PACKET = 256;
+    static constexpr auto BLOCK_TIMEOUT = std::chrono::milliseconds(100);  // How often run() rechecks running
+
+private:
+    PacketSource& source_;
+    Decoder decoder_;
+    FeedHandlerConfig config_;
+    std::vector<PacketView> packets_;
+    std::vector<Tick> ticks_;
+
+    std::atomic<uint64_t> packets_decoded_{0};
+    std::atomic<uint64_t> malformed_packets_{0};
+    std::atomic<uint64_t> ticks_pushed_{0};
+    std::atomic<uint64_t> ticks_dropped_{0};
+
+public:
+    explicit FeedHandler(PacketSource& source, Decoder decoder = Decoder{}, FeedHandlerConfig config = {})
+        : source_(source)
+        , decoder_(std::move(decoder))
+        , config_(config)
+        , packets_(source.max_batch())
+        , ticks_(MAX_TICKS_PER_PACKET) {}
+
+    // One receive batch, decoded and pushed. Returns the packets received
+    // (0: nothing was waiting).
+    template <typename Queue>
+    std::size_t poll(Queue& queue) {
+        const std::size_t received = source_.receive(packets_);
+        for (std::size_t i = 0; i < received; ++i) {
+            const PacketView& packet = packets_[i];
+            const DecodeResult result = decoder_.decode(packet.bytes(), packet.rx_time, ticks_);
+            if (result.malformed) malformed_packets_.fetch_add(1, std::memory_order_relaxed);
+            push(queue, std::span<const Tick>(ticks_.data(), result.ticks));
+        }
+        if (received > 0) packets_decoded_.fetch_add(received, std::memory_order_relaxed);
+        return received;
+    }
+
+    // poll() until running turns false, idling per FeedHandlerConfig::wait
+    template <typename Queue>
+    void run(Queue& queue, const std::atomic<bool>& running) {
+        uint32_t idle = 0;
+        while (running.load(std::memory_order_acquire)) {
+            if (poll(queue) > 0) {
+                idle = 0;
+                continue;
+            }
+            idle_wait(idle);
+            if (idle < UINT32_MAX) ++idle;
+        }
+    }
+
+    [[nodiscard]] Decoder& decoder() noexcept { return decoder_; }
+    [[nodiscard]] const Decoder& decoder() const noexcept { return decoder_; }
+
+    // Statistics
+    [[nodiscard]] uint64_t packets_decoded() const noexcept {
+        return packets_decoded_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t malformed_packets() const noexcept {
+        return malformed_packets_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t ticks_pushed() const noexcept {
+        return ticks_pushed_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t ticks_dropped() const noexcept {
+        return ticks_dropped_.load(std::memory_order_acquire);
+    }
+
+private:
+    template <typename Queue>
+    void push(Queue& queue, std::span<const Tick> ticks) {
+        std::size_t offset = 0;
+        while (offset < ticks.size()) {
+            std::size_t pushed;
+            if constexpr (requires { queue.try_push_n(ticks.data(), ticks.size()); }) {
+                pushed = queue.try_push_n(ticks.data() + offset, ticks.size() - offset);
+            } else {
+                pushed = queue.push(Tick(ticks[offset])) ? 1 : 0;
+            }
+            offset += pushed;
+            ticks_pushed_.fetch_add(pushed, std::memory_order_relaxed);
+
+            if (offset < ticks.size() && pushed == 0) {
+                if (config_.drop_when_full) {
+                    ticks_dropped_.fetch_add(ticks.size() - offset, std::memory_order_relaxed);
+                    return;
+                }
+                cpu_relax();
+            }
+        }
+    }
+
+    void idle_wait(uint32_t idle) {
+        switch (config_.wait) {
+            case WaitStrategy::BUSY_SPIN:
+                cpu_relax();
+                break;
+            case WaitStrategy::SPIN_YIELD:
+                if (idle < config_.spin_iterations) {
+                    cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                }
+                break;
+            case WaitStrategy::BLOCKING:
+                if (idle < config_.spin_iterations) {
+                    cpu_relax();
+                } else {
+                    source_.wait_readable(BLOCK_TIMEOUT);
+                }
+                break;
+            case WaitStrategy::SLEEP:
+                std::this_thread::sleep_for(config_.sleep_interval);
+                break;
+        }
+    }
+};
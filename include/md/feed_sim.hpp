@@ -1,13 +1,21 @@
 #pragma once
 #include "md/tick.hpp"
+#include "md/compact_tick.hpp"
+#include "md/overload_policy.hpp"
+#include "stats/cholesky.hpp"
+#include "util/random.hpp"
 #include "md/spsc_queue.hpp"
 #include <vector>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <random>
 #include <chrono>
 #include <atomic>
 #include <thread>
 #include <algorithm>
+#include <cmath>
+#include <type_traits>
 
 enum class PriceModel {
     GEOMETRIC_BROWNIAN_MOTION,
@@ -16,6 +24,10 @@ enum class PriceModel {
     MICROSTRUCTURE_NOISE
 };
 
+// Queue whose slots hold CompactTick rather than Tick
+template <typename Queue>
+concept CompactTickQueue = std::is_same_v<typename Queue::value_type, CompactTick>;
+
 // Configuration for a single symbol
 struct SymbolConfig {
     std::string symbol;
@@ -33,19 +45,50 @@ struct SymbolConfig {
         : symbol(std::move(sym)), initial_price(price), volatility(vol) {}
 };
 
+inline constexpr double MS_PER_YEAR = 365.25 * 24 * 60 * 60 * 1000;
+
+// Per-symbol coefficients of one simulation step, computed once for a fixed
+// step length rather than on every price update
+struct PriceStepConstants {
+    double drift_dt{0.0};           // drift * dt
+    double vol_sqrt_dt{0.0};        // volatility * sqrt(dt)
+    double reversion_dt{0.0};       // mean_reversion * dt (OU)
+    double jump_probability{0.0};   // jump_intensity * dt
+    double noise_scale{0.0};        // Microstructure noise per unit normal
+
+    [[nodiscard]] static PriceStepConstants from(const SymbolConfig& config, double step_ms) noexcept {
+        const double dt = step_ms / MS_PER_YEAR;
+        return {config.drift * dt, config.volatility * std::sqrt(dt),
+                config.mean_reversion * dt, config.jump_intensity * dt, config.tick_size * 0.1};
+    }
+};
+
 // Market microstructure simulator
 class FeedSimulator {
 private:
     std::vector<SymbolConfig> symbols_;
+    std::vector<SymbolId> symbol_ids_;
     std::vector<double> current_prices_;
     std::vector<uint64_t> sequence_ids_;
-
-    // Random number generation
-    mutable std::mt19937_64 rng_;
+    std::vector<PriceStepConstants> step_constants_;
+    std::vector<double> shocks_;  // This step's normal draw per symbol
+    std::vector<double> correlation_;  // n x n, row-major; empty: independent
+    std::vector<double> cholesky_;     // Lower factor of correlation_
+    std::vector<double> iid_shocks_;   // Uncorrelated draws fed through cholesky_
+    TickCodec codec_;  // Tick sizes of every simulated symbol
+    OverloadController overload_;  // What a full queue does to a step's ticks
+
+    // Random number generation: per-step shocks come in one batch from the
+    // 4-lane generator, occasional extra draws from the scalar one
+    Xoshiro256x4 shock_rng_;
+    mutable Xoshiro256 rng_;
     mutable std::normal_distribution<double> normal_dist_{0.0, 1.0};
     mutable std::exponential_distribution<double> exp_dist_{1.0};
     mutable std::uniform_real_distribution<double> uniform_dist_{0.0, 1.0};
 
+    // Ticks staged per batched push
+    static constexpr size_t PUSH_BATCH = 64;
+
     // Simulation parameters
     PriceModel model_{PriceModel::GEOMETRIC_BROWNIAN_MOTION};
     double time_step_ms_{1.0};  // Time between ticks in milliseconds
@@ -60,31 +103,104 @@ public:
                           PriceModel model = PriceModel::GEOMETRIC_BROWNIAN_MOTION,
                           double tick_interval_ms = 1.0)
         : symbols_(std::move(symbols))
+        , symbol_ids_(symbols_.size())
         , current_prices_(symbols_.size())
         , sequence_ids_(symbols_.size(), 0)
-        , rng_(std::random_device{}())
+        , step_constants_(symbols_.size())
+        , shocks_(symbols_.size())
+        , rng_((uint64_t{std::random_device{}()} << 32) | std::random_device{}())
         , model_(model)
         , time_step_ms_(tick_interval_ms) {
 
-        // Initialize current prices
+        // Initialize current prices and intern symbols once up front
         for (size_t i = 0; i < symbols_.size(); ++i) {
             current_prices_[i] = symbols_[i].initial_price;
+            symbol_ids_[i] = SymbolTable::intern_id(symbols_[i].symbol);
+            codec_.set_tick_size(symbol_ids_[i], symbols_[i].tick_size);
+            step_constants_[i] = PriceStepConstants::from(symbols_[i], time_step_ms_);
         }
+        shock_rng_ = Xoshiro256x4(rng_);
     }
 
-    // Generate next tick for all symbols
+    // Generate next tick for all symbols. Queues of CompactTick get ticks
+    // encoded with codec(); decode them with the same codec. Ticks the queue
+    // cannot take are handled per set_overload_config().
     template<typename Queue>
     void generate_ticks(Queue& queue) {
-        const auto now = std::chrono::steady_clock::now();
+        // One stamp per step: every symbol's tick in a step is simultaneous
+        const auto now = TickClock::now();
+        draw_shocks();
+
+        // Publish PUSH_BATCH ticks at a time (one index store on batch-capable queues)
+        Tick batch[PUSH_BATCH];
+        for (size_t base = 0; base < symbols_.size(); base += PUSH_BATCH) {
+            const size_t n = std::min(PUSH_BATCH, symbols_.size() - base);
+            for (size_t i = 0; i < n; ++i) {
+                batch[i] = generate_tick(base + i, now);
+            }
+            publish(queue, batch, n);
+        }
+        overload_.sample(queue);
+    }
 
-        for (size_t i = 0; i < symbols_.size(); ++i) {
-            auto tick = generate_tick(i, now);
-            if (!queue.push(std::move(tick))) {
-                ticks_dropped_.fetch_add(1, std::memory_order_relaxed);
-            } else {
-                ticks_generated_.fetch_add(1, std::memory_order_relaxed);
+    // Overload policy, spin retries and water-mark callback for generate_ticks.
+    // Not thread-safe against generate_ticks.
+    void set_overload_config(OverloadConfig config) { overload_.set_config(std::move(config)); }
+    [[nodiscard]] const OverloadController& overload() const noexcept { return overload_; }
+
+    // Depth of the queue as seen once per step by generate_ticks
+    [[nodiscard]] const QueueDepthHistogram& queue_depth() const noexcept {
+        return overload_.queue_depth();
+    }
+
+    // Correlate the symbols' shocks: matrix is n x n row-major in symbols()
+    // order, symmetric with a unit diagonal and positive definite. Factored once
+    // here; each step then costs one triangular matrix-vector product. Throws
+    // std::invalid_argument on a malformed matrix. Not thread-safe against
+    // generate_ticks.
+    void set_correlation_matrix(const std::vector<double>& matrix) {
+        const size_t n = symbols_.size();
+        if (matrix.size() != n * n) {
+            throw std::invalid_argument("Correlation matrix must be n x n for n symbols");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (matrix[i * n + i] != 1.0) {
+                throw std::invalid_argument("Correlation matrix must have a unit diagonal");
             }
+            for (size_t j = 0; j < i; ++j) {
+                const double rho = matrix[i * n + j];
+                if (rho != matrix[j * n + i] || std::abs(rho) > 1.0) {
+                    throw std::invalid_argument("Correlation matrix must be symmetric, |rho| <= 1");
+                }
+            }
+        }
+
+        cholesky_ = cholesky_lower(matrix, n);
+        correlation_ = matrix;
+        iid_shocks_.assign(n, 0.0);
+    }
+
+    // Set one pair's correlation, keeping every other entry
+    void set_pair_correlation(std::string_view first, std::string_view second, double rho) {
+        const size_t n = symbols_.size();
+        const size_t i = symbol_index(first);
+        const size_t j = symbol_index(second);
+        if (i == j) {
+            throw std::invalid_argument("Pair correlation needs two distinct symbols");
+        }
+
+        std::vector<double> matrix = correlation_;
+        if (matrix.empty()) {
+            matrix.assign(n * n, 0.0);
+            for (size_t k = 0; k < n; ++k) matrix[k * n + k] = 1.0;
         }
+        matrix[i * n + j] = rho;
+        matrix[j * n + i] = rho;
+        set_correlation_matrix(matrix);
+    }
+
+    [[nodiscard]] const std::vector<double>& correlation_matrix() const noexcept {
+        return correlation_;
     }
 
     // Main simulation loop
@@ -135,21 +251,89 @@ public:
         return symbols_;
     }
 
+    [[nodiscard]] const TickCodec& codec() const noexcept { return codec_; }
+
     void reset_stats() noexcept {
         ticks_generated_.store(0, std::memory_order_release);
         ticks_dropped_.store(0, std::memory_order_release);
+        overload_.reset_stats();
     }
 
 private:
-    Tick generate_tick(size_t symbol_idx, std::chrono::steady_clock::time_point timestamp) {
+    // CompactTick queue seen as a Tick queue, so overload handling works on
+    // Ticks; ticks the codec cannot represent are counted in rejected
+    template <typename Queue>
+    struct EncodingQueue {
+        Queue& queue;
+        const TickCodec& codec;
+        size_t rejected{0};
+
+        size_t try_push_n(const Tick* ticks, size_t n) {
+            CompactTick batch[PUSH_BATCH];
+            size_t source[PUSH_BATCH];  // Position in ticks of each encoded entry
+            size_t done = 0;
+            while (done < n) {
+                const size_t count = std::min(PUSH_BATCH, n - done);
+                size_t encoded = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    if (codec.encode(ticks[done + i], batch[encoded])) source[encoded++] = i;
+                }
+                const size_t pushed = queue.try_push_n(batch, encoded);
+                if (pushed < encoded) {
+                    // Consumed up to the first tick that did not fit
+                    const size_t consumed = source[pushed];
+                    rejected += consumed - pushed;
+                    return done + consumed;
+                }
+                rejected += count - encoded;
+                done += count;
+            }
+            return done;
+        }
+    };
+
+    template <typename Queue>
+    void publish(Queue& queue, const Tick* batch, size_t n) {
+        PublishResult result;
+        if constexpr (CompactTickQueue<Queue>) {
+            EncodingQueue<Queue> encoding{queue, codec_};
+            result = overload_.publish(encoding, batch, n);
+            result.delivered -= encoding.rejected;
+            result.lost += encoding.rejected;
+        } else {
+            result = overload_.publish(queue, batch, n);
+        }
+        if (result.delivered > 0) ticks_generated_.fetch_add(result.delivered, std::memory_order_relaxed);
+        if (result.lost > 0) ticks_dropped_.fetch_add(result.lost, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t symbol_index(std::string_view symbol) const {
+        for (size_t i = 0; i < symbols_.size(); ++i) {
+            if (symbols_[i].symbol == symbol) return i;
+        }
+        throw std::invalid_argument("Unknown symbol: " + std::string(symbol));
+    }
+
+    void draw_shocks() noexcept {
+        if (cholesky_.empty()) {
+            shock_rng_.fill_normal(shocks_.data(), shocks_.size());
+        } else {
+            shock_rng_.fill_normal(iid_shocks_.data(), iid_shocks_.size());
+            lower_triangular_multiply(cholesky_.data(), iid_shocks_.data(), shocks_.data(),
+                                      shocks_.size());
+        }
+    }
+
+    Tick generate_tick(size_t symbol_idx, TickClock::time_point timestamp) {
         const auto& config = symbols_[symbol_idx];
 
-        // Update price based on model
-        double& price = current_prices_[symbol_idx];
-        update_price(price, config);
+        // Update the model price; it stays off-grid so moves smaller than
+        // a tick still accumulate
+        double& model_price = current_prices_[symbol_idx];
+        update_price(model_price, config, step_constants_[symbol_idx], shocks_[symbol_idx]);
 
-        // Round to tick size
-        price = round_to_tick_size(price, config.tick_size);
+        // Quote on the tick grid
+        const double price = round_to_tick_size(model_price, config.tick_size);
 
         // Generate bid/ask around mid
         const auto [bid, ask] = generate_bid_ask(price, config);
@@ -158,62 +342,41 @@ private:
         const double volume = generate_volume();
 
         return Tick{
-            SymbolTable::intern(config.symbol),
+            symbol_ids_[symbol_idx],
             price,
             bid,
             ask,
             volume,
-            ++sequence_ids_[symbol_idx]
+            ++sequence_ids_[symbol_idx],
+            timestamp
         };
     }
 
-    void update_price(double& price, const SymbolConfig& config) {
-        const double dt = time_step_ms_ / (365.25 * 24 * 60 * 60 * 1000); // Convert to years
-        const double z = normal_dist_(rng_);
-
+    void update_price(double& price, const SymbolConfig& config,
+                      const PriceStepConstants& step, double z) {
         switch (model_) {
-            case PriceModel::GEOMETRIC_BROWNIAN_MOTION: {
+            case PriceModel::GEOMETRIC_BROWNIAN_MOTION:
                 // dS = μS dt + σS dW
-                const double drift_term = config.drift * price * dt;
-                const double diffusion_term = config.volatility * price * std::sqrt(dt) * z;
-                price += drift_term + diffusion_term;
+                price += price * (step.drift_dt + step.vol_sqrt_dt * z);
                 break;
-            }
 
-            case PriceModel::ORNSTEIN_UHLENBECK: {
+            case PriceModel::ORNSTEIN_UHLENBECK:
                 // dS = θ(μ - S) dt + σ dW
-                const double mean_rev_term = config.mean_reversion *
-                    (config.initial_price - price) * dt;
-                const double diffusion_term = config.volatility * std::sqrt(dt) * z;
-                price += mean_rev_term + diffusion_term;
+                price += step.reversion_dt * (config.initial_price - price) + step.vol_sqrt_dt * z;
                 break;
-            }
 
-            case PriceModel::JUMP_DIFFUSION: {
+            case PriceModel::JUMP_DIFFUSION:
                 // GBM + Poisson jumps
-                const double drift_term = config.drift * price * dt;
-                const double diffusion_term = config.volatility * price * std::sqrt(dt) * z;
-                price += drift_term + diffusion_term;
-
-                // Add jumps
-                if (config.jump_intensity > 0.0) {
-                    const double jump_prob = config.jump_intensity * dt;
-                    if (uniform_dist_(rng_) < jump_prob) {
-                        const double jump_size = config.jump_mean +
-                            config.jump_std * normal_dist_(rng_);
-                        price *= std::exp(jump_size);
-                    }
+                price += price * (step.drift_dt + step.vol_sqrt_dt * z);
+                if (step.jump_probability > 0.0 && uniform_dist_(rng_) < step.jump_probability) {
+                    price *= std::exp(config.jump_mean + config.jump_std * normal_dist_(rng_));
                 }
                 break;
-            }
 
-            case PriceModel::MICROSTRUCTURE_NOISE: {
+            case PriceModel::MICROSTRUCTURE_NOISE:
                 // High-frequency noise model
-                const double base_move = config.volatility * std::sqrt(dt) * z * price;
-                const double noise = config.tick_size * normal_dist_(rng_) * 0.1;
-                price += base_move + noise;
+                price += step.vol_sqrt_dt * z * price + step.noise_scale * normal_dist_(rng_);
                 break;
-            }
         }
 
         // Ensure price stays positive
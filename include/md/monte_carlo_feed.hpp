@@ -0,0 +1,223 @@
+#pragma once
+#include "md/feed_sim.hpp"
+#include "md/tick.hpp"
+#include "util/aligned_buffer.hpp"
+#include "util/random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct MonteCarloConfig {
+    PriceModel model{PriceModel::GEOMETRIC_BROWNIAN_MOTION};
+    double step_ms{1.0};        // Simulated time per step
+    uint64_t seed{0x5eed};
+    unsigned threads{0};        // 0: one per hardware thread
+};
+
+// High-throughput generator of independent price paths for load tests and
+// strategy research. Paths are split into fixed blocks of BLOCK_PATHS, each
+// with its own RNG stream, and every step of a block is one pass of batched
+// normal draws and a vectorizable update over structure-of-arrays state.
+// Worker threads own disjoint sets of blocks, so paths never share state and
+// the generated prices depend only on the seed, not on the thread count.
+//
+// run() hands each block's ticks to sink(worker, ticks, n) from the worker
+// thread; give each worker its own queue (e.g. one ShardedRouter shard or
+// SPSCQueue per worker) to keep the sink lock-free.
+class MonteCarloFeed {
+public:
+    static constexpr std::size_t BLOCK_PATHS = 256;
+
+private:
+    struct Block {
+        std::size_t begin;
+        std::size_t end;
+        Xoshiro256x4 rng;
+        Xoshiro256 rare_rng;  // Jump sizes only
+        AlignedBuffer<double> shocks{BLOCK_PATHS};
+        AlignedBuffer<double> uniforms{BLOCK_PATHS};
+        AlignedBuffer<double> noise{BLOCK_PATHS};
+
+        Block(std::size_t b, std::size_t e, Xoshiro256& parent)
+            : begin(b), end(e), rng(parent), rare_rng(parent.split()) {}
+    };
+
+    std::vector<SymbolConfig> paths_;
+    std::vector<SymbolId> symbol_ids_;
+    MonteCarloConfig config_;
+    unsigned threads_;
+    uint64_t steps_done_{0};
+
+    // Per-path state and step constants, structure-of-arrays
+    AlignedBuffer<double> prices_;
+    AlignedBuffer<double> initial_;
+    AlignedBuffer<double> drift_dt_;
+    AlignedBuffer<double> vol_sqrt_dt_;
+    AlignedBuffer<double> reversion_dt_;
+    AlignedBuffer<double> jump_probability_;
+    AlignedBuffer<double> noise_scale_;
+    AlignedBuffer<double> tick_size_;
+    AlignedBuffer<double> half_spread_;    // Relative, bid_ask_spread / 2
+
+    std::vector<Block> blocks_;
+
+public:
+    explicit MonteCarloFeed(std::vector<SymbolConfig> paths, MonteCarloConfig config = {})
+        : paths_(std::move(paths))
+        , symbol_ids_(paths_.size())
+        , config_(config)
+        , threads_(config.threads > 0 ? config.threads
+                                      : std::max(1u, std::thread::hardware_concurrency()))
+        , prices_(paths_.size())
+        , initial_(paths_.size())
+        , drift_dt_(paths_.size())
+        , vol_sqrt_dt_(paths_.size())
+        , reversion_dt_(paths_.size())
+        , jump_probability_(paths_.size())
+        , noise_scale_(paths_.size())
+        , tick_size_(paths_.size())
+        , half_spread_(paths_.size()) {
+
+        for (std::size_t i = 0; i < paths_.size(); ++i) {
+            const auto& path = paths_[i];
+            const auto step = PriceStepConstants::from(path, config_.step_ms);
+            symbol_ids_[i] = SymbolTable::intern_id(path.symbol);
+            prices_[i] = path.initial_price;
+            initial_[i] = path.initial_price;
+            drift_dt_[i] = step.drift_dt;
+            vol_sqrt_dt_[i] = step.vol_sqrt_dt;
+            reversion_dt_[i] = step.reversion_dt;
+            jump_probability_[i] = step.jump_probability;
+            noise_scale_[i] = step.noise_scale;
+            tick_size_[i] = path.tick_size;
+            half_spread_[i] = path.bid_ask_spread * 0.5;
+        }
+
+        Xoshiro256 parent(config_.seed);
+        for (std::size_t begin = 0; begin < paths_.size(); begin += BLOCK_PATHS) {
+            blocks_.emplace_back(begin, std::min(begin + BLOCK_PATHS, paths_.size()), parent);
+        }
+        threads_ = static_cast<unsigned>(std::min<std::size_t>(threads_, std::max<std::size_t>(1, blocks_.size())));
+    }
+
+    // Advance every path by steps, emitting one tick per path per step.
+    // Returns the number of ticks generated.
+    template <typename Sink>
+    uint64_t run(std::size_t steps, Sink&& sink) {
+        auto work = [this, steps, &sink](unsigned worker) {
+            std::vector<Tick> ticks(BLOCK_PATHS);
+            for (std::size_t step = 0; step < steps; ++step) {
+                const uint64_t sequence = steps_done_ + step + 1;
+                const auto now = TickClock::now();
+                for (std::size_t b = worker; b < blocks_.size(); b += threads_) {
+                    const std::size_t n = advance(blocks_[b], sequence, now, ticks.data());
+                    sink(worker, static_cast<const Tick*>(ticks.data()), n);
+                }
+            }
+        };
+
+        if (threads_ == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(threads_);
+            for (unsigned w = 0; w < threads_; ++w) {
+                workers.emplace_back(work, w);
+            }
+            for (auto& worker : workers) worker.join();
+        }
+
+        steps_done_ += steps;
+        return static_cast<uint64_t>(steps) * paths_.size();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return paths_.size(); }
+    [[nodiscard]] unsigned threads() const noexcept { return threads_; }
+    [[nodiscard]] uint64_t steps_done() const noexcept { return steps_done_; }
+    // Model price (before rounding to the tick grid)
+    [[nodiscard]] double price(std::size_t path) const noexcept { return prices_[path]; }
+    [[nodiscard]] SymbolId symbol_id(std::size_t path) const noexcept { return symbol_ids_[path]; }
+
+private:
+    // One step for one block; writes its ticks to out and returns how many
+    std::size_t advance(Block& block, uint64_t sequence, TickClock::time_point now, Tick* out) {
+        const std::size_t begin = block.begin;
+        const std::size_t n = block.end - begin;
+
+        double* price = prices_.data() + begin;
+        const double* z = block.shocks.data();
+        const double* drift = drift_dt_.data() + begin;
+        const double* vol = vol_sqrt_dt_.data() + begin;
+        const double* tick = tick_size_.data() + begin;
+
+        block.rng.fill_normal(block.shocks.data(), n);
+
+        switch (config_.model) {
+            case PriceModel::GEOMETRIC_BROWNIAN_MOTION:
+                for (std::size_t i = 0; i < n; ++i) {
+                    price[i] += price[i] * (drift[i] + vol[i] * z[i]);
+                }
+                break;
+
+            case PriceModel::ORNSTEIN_UHLENBECK: {
+                const double* reversion = reversion_dt_.data() + begin;
+                const double* initial = initial_.data() + begin;
+                for (std::size_t i = 0; i < n; ++i) {
+                    price[i] += reversion[i] * (initial[i] - price[i]) + vol[i] * z[i];
+                }
+                break;
+            }
+
+            case PriceModel::JUMP_DIFFUSION: {
+                for (std::size_t i = 0; i < n; ++i) {
+                    price[i] += price[i] * (drift[i] + vol[i] * z[i]);
+                }
+                // Jumps are rare: one uniform per path, a scalar draw per jump
+                const double* jump_probability = jump_probability_.data() + begin;
+                const double* u = block.uniforms.data();
+                block.rng.fill_uniform(block.uniforms.data(), n);
+                std::normal_distribution<double> normal{0.0, 1.0};
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (u[i] < jump_probability[i]) {
+                        const auto& path = paths_[begin + i];
+                        price[i] *= std::exp(path.jump_mean + path.jump_std * normal(block.rare_rng));
+                    }
+                }
+                break;
+            }
+
+            case PriceModel::MICROSTRUCTURE_NOISE: {
+                const double* noise_scale = noise_scale_.data() + begin;
+                const double* noise = block.noise.data();
+                block.rng.fill_normal(block.noise.data(), n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    price[i] += vol[i] * z[i] * price[i] + noise_scale[i] * noise[i];
+                }
+                break;
+            }
+        }
+
+        // Model prices stay positive but off-grid (sub-tick moves accumulate);
+        // quotes are rounded to the grid
+        for (std::size_t i = 0; i < n; ++i) {
+            price[i] = std::max(price[i], tick[i]);
+        }
+
+        const double* half_spread = half_spread_.data() + begin;
+        const double* u = block.uniforms.data();
+        block.rng.fill_uniform(block.uniforms.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double last = std::round(price[i] / tick[i]) * tick[i];
+            const double half = last * half_spread[i];
+            const double bid = std::round((last - half) / tick[i]) * tick[i];
+            const double ask = std::round((last + half) / tick[i]) * tick[i];
+            const double volume = std::max(1.0, -std::log(u[i]) * 100.0);
+            out[i] = Tick{symbol_ids_[begin + i], last, bid, ask, volume, sequence, now};
+        }
+        return n;
+    }
+};
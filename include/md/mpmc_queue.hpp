@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Bounded multi-producer/multi-consumer ring (Vyukov). Each cell carries a
+// sequence number that tells producers and consumers whose turn the cell is,
+// so the only contended operation is one CAS on the enqueue or dequeue index.
+// Same push/pop/fill_ratio interface as SPSCQueue, so FeedSimulator and the
+// consumer loop work with either one.
+template <typename T, std::size_t N>
+class MPMCQueue {
+    static_assert((N & (N - 1)) == 0, "N must be power of two for efficient modulo");
+    static_assert(N >= 2, "Queue size must be at least 2");
+    static_assert(std::is_move_constructible_v<T>, "T must be move constructible");
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static constexpr size_t MASK = N - 1;
+
+    // Cache line alignment to prevent false sharing
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+
+    // Ring buffer storage
+    alignas(64) Cell buffer_[N];
+
+    template <typename U>
+    [[nodiscard]] bool emplace(U&& item) noexcept {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &buffer_[pos & MASK];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                // Cell is free for this position - try to claim it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Queue full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::forward<U>(item);
+
+        // Hand the cell to the consumer that will dequeue position pos
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+public:
+    using value_type = T;
+
+    MPMCQueue() noexcept {
+        for (size_t i = 0; i < N; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Non-copyable, non-movable for thread safety
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    MPMCQueue(MPMCQueue&&) = delete;
+    MPMCQueue& operator=(MPMCQueue&&) = delete;
+
+    // Producer side - any number of threads
+    [[nodiscard]] bool push(const T& item) noexcept { return emplace(item); }
+    [[nodiscard]] bool push(T&& item) noexcept { return emplace(std::move(item)); }
+
+    // Consumer side - any number of threads
+    [[nodiscard]] bool pop(T& item) noexcept {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &buffer_[pos & MASK];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Queue empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(cell->data);
+
+        // Recycle the cell for the producer one lap ahead
+        cell->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    // Pop up to max_items into out; returns how many were taken
+    [[nodiscard]] size_t try_pop_n(T* out, size_t max_items) noexcept {
+        size_t n = 0;
+        while (n < max_items && pop(out[n])) {
+            ++n;
+        }
+        return n;
+    }
+
+    // Drain up to max_items, handing each to handler. Items are claimed one
+    // at a time, since other consumers may be racing for the same cells.
+    template <typename Handler>
+    size_t consume_all(Handler&& handler, size_t max_items = N) {
+        size_t n = 0;
+        T item;
+        while (n < max_items && pop(item)) {
+            handler(item);
+            ++n;
+        }
+        return n;
+    }
+
+    // Utility functions (approximate, not thread-safe)
+    [[nodiscard]] size_t size() const noexcept {
+        const size_t dequeue = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t enqueue = enqueue_pos_.load(std::memory_order_acquire);
+        if (enqueue <= dequeue) return 0;
+        const size_t used = enqueue - dequeue;
+        return used < N ? used : N;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]] constexpr size_t capacity() const noexcept {
+        return N; // Sequence numbers distinguish full from empty, no slot reserved
+    }
+
+    // Get fill percentage (0.0 to 1.0)
+    [[nodiscard]] double fill_ratio() const noexcept {
+        return static_cast<double>(size()) / capacity();
+    }
+};
+
+// Fan-in from several feed-handler threads into one Router
+template <typename T, std::size_t N>
+using MPSCQueue = MPMCQueue<T, N>;
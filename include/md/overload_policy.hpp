@@ -0,0 +1,250 @@
+#pragma once
+#include "md/tick.hpp"
+#include "util/wait_strategy.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// What a producer does with ticks the queue cannot take
+enum class OverloadPolicy : uint8_t {
+    DROP,       // Lose them (after any spin_retries)
+    CONFLATE    // Park the newest tick per symbol beside the ring; a newer one replaces it
+};
+
+struct OverloadConfig {
+    OverloadPolicy policy{OverloadPolicy::DROP};
+    uint32_t spin_retries{0};       // Bounded re-pushes of a full batch before the policy applies
+    double high_water_mark{0.0};    // Fill ratio that fires on_pressure(true, depth) (0: off)
+    double low_water_mark{0.0};     // Fill ratio at or below which on_pressure(false, depth) fires
+    std::function<void(bool high, std::size_t depth)> on_pressure;  // Producer thread, on each crossing
+};
+
+// Distribution of queue depth as sampled by the producer. Bucket 0 counts
+// empty samples, bucket b > 0 depths in [2^(b-1), 2^b). Single writer;
+// readable from any thread.
+class QueueDepthHistogram {
+public:
+    static constexpr std::size_t BUCKETS = 33;  // Depths below 2^32
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+    std::atomic<uint64_t> max_{0};
+
+public:
+    void record(std::size_t depth) noexcept {
+        const std::size_t bucket = std::min<std::size_t>(std::bit_width(depth), BUCKETS - 1);
+        counts_[bucket].store(counts_[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (depth > max_.load(std::memory_order_relaxed)) max_.store(depth, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t count(std::size_t bucket) const noexcept {
+        return counts_[bucket].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t samples() const noexcept {
+        uint64_t total = 0;
+        for (const auto& count : counts_) total += count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // Largest depth bucket holds
+    [[nodiscard]] static constexpr std::size_t bucket_upper(std::size_t bucket) noexcept {
+        return bucket == 0 ? 0 : (std::size_t{1} << bucket) - 1;
+    }
+
+    // Upper bound of the depth at quantile q (0 when empty)
+    [[nodiscard]] std::size_t quantile(double q) const noexcept {
+        const uint64_t total = samples();
+        if (total == 0) return 0;
+        const auto rank = static_cast<uint64_t>(q * static_cast<double>(total - 1));
+        uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += count(bucket);
+            if (seen > rank) return std::min(bucket_upper(bucket), max());
+        }
+        return max();
+    }
+
+    [[nodiscard]] std::size_t max() const noexcept {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    void reset() noexcept {
+        for (auto& count : counts_) count.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct PublishResult {
+    std::size_t delivered{0};   // Entered the queue (including parked ticks flushed now)
+    std::size_t lost{0};        // Dropped, or replaced while parked
+};
+
+// Producer-side overload handling in front of a tick queue (SPSCQueue,
+// MPMCQueue or anything with push()/try_push_n()). With the default config a
+// full queue loses the remainder of the batch, as before. CONFLATE keeps a
+// slot per SymbolId next to the ring: overflow parks there, a newer tick for
+// the same symbol replaces the parked one, and the next publish() flushes
+// parked ticks (oldest symbol first) ahead of fresh ones, so the consumer
+// gets the latest price per symbol instead of a backlog of stale ones.
+//
+// publish()/flush()/sample() belong to the producer thread; the statistics
+// and depth histogram may be read from any thread.
+class OverloadController {
+private:
+    static constexpr std::size_t FLUSH_BATCH = 64;  // Bounds the copy wasted when the ring is still full
+
+    OverloadConfig config_;
+    std::vector<Tick> slots_;         // Indexed by SymbolId
+    std::vector<uint8_t> parked_;     // slots_[id] holds an unsent tick
+    std::vector<SymbolId> order_;     // Parked symbols, oldest first
+    bool high_{false};
+
+    QueueDepthHistogram depth_;
+    std::atomic<uint64_t> conflated_{0};
+    std::atomic<uint64_t> retries_{0};
+
+public:
+    explicit OverloadController(OverloadConfig config = {}) : config_(std::move(config)) {
+        size_slots();
+    }
+
+    // Not thread-safe against publish(); parked ticks are kept
+    void set_config(OverloadConfig config) {
+        config_ = std::move(config);
+        size_slots();
+    }
+    [[nodiscard]] const OverloadConfig& config() const noexcept { return config_; }
+
+    template <typename Queue>
+    PublishResult publish(Queue& queue, const Tick* ticks, std::size_t n) {
+        PublishResult result;
+        if (!order_.empty()) result.delivered += flush(queue);
+
+        // While anything is still parked the ring is full: fresh ticks park too
+        std::size_t offset = 0;
+        if (order_.empty()) {
+            offset = push_some(queue, ticks, n);
+            for (uint32_t spin = 0; offset < n && spin < config_.spin_retries; ++spin) {
+                cpu_relax();
+                offset += push_some(queue, ticks + offset, n - offset);
+                retries_.store(retries_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+        result.delivered += offset;
+
+        if (offset < n) {
+            result.lost += config_.policy == OverloadPolicy::CONFLATE ? park(ticks + offset, n - offset)
+                                                                      : n - offset;
+        }
+        return result;
+    }
+
+    // Push parked ticks, oldest symbol first; returns how many went in
+    template <typename Queue>
+    std::size_t flush(Queue& queue) {
+        std::size_t flushed = 0;
+        Tick batch[FLUSH_BATCH];
+        while (flushed < order_.size()) {
+            const std::size_t n = std::min(FLUSH_BATCH, order_.size() - flushed);
+            for (std::size_t i = 0; i < n; ++i) batch[i] = slots_[order_[flushed + i]];
+            const std::size_t pushed = push_some(queue, batch, n);
+            for (std::size_t i = 0; i < pushed; ++i) parked_[order_[flushed + i]] = 0;
+            flushed += pushed;
+            if (pushed < n) break;
+        }
+        order_.erase(order_.begin(), order_.begin() + static_cast<std::ptrdiff_t>(flushed));
+        return flushed;
+    }
+
+    // Record the queue's depth and fire on_pressure on a water-mark crossing;
+    // once per producer step is enough
+    template <typename Queue>
+    void sample(const Queue& queue) {
+        if constexpr (requires { queue.size(); queue.capacity(); }) {
+            const std::size_t depth = queue.size();
+            depth_.record(depth);
+            if (!config_.on_pressure || !(config_.high_water_mark > 0.0)) return;
+
+            const double fill = static_cast<double>(depth) / static_cast<double>(queue.capacity());
+            if (!high_ && fill >= config_.high_water_mark) {
+                high_ = true;
+                config_.on_pressure(true, depth);
+            } else if (high_ && fill <= config_.low_water_mark) {
+                high_ = false;
+                config_.on_pressure(false, depth);
+            }
+        }
+    }
+
+    // Statistics
+    [[nodiscard]] std::size_t parked() const noexcept { return order_.size(); }  // Producer thread
+    [[nodiscard]] bool above_high_water() const noexcept { return high_; }       // Producer thread
+    [[nodiscard]] const QueueDepthHistogram& queue_depth() const noexcept { return depth_; }
+
+    // Parked ticks replaced by a newer one for the same symbol
+    [[nodiscard]] uint64_t ticks_conflated() const noexcept {
+        return conflated_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t spin_retries() const noexcept {
+        return retries_.load(std::memory_order_relaxed);
+    }
+
+    void reset_stats() noexcept {
+        depth_.reset();
+        conflated_.store(0, std::memory_order_relaxed);
+        retries_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    template <typename Queue>
+    static std::size_t push_some(Queue& queue, const Tick* ticks, std::size_t n) {
+        if constexpr (requires { queue.try_push_n(ticks, n); }) {
+            return queue.try_push_n(ticks, n);
+        } else {
+            std::size_t pushed = 0;
+            while (pushed < n && queue.push(Tick(ticks[pushed]))) ++pushed;
+            return pushed;
+        }
+    }
+
+    // CONFLATE gets a slot for every possible SymbolId up front, so park()
+    // never allocates on the producer thread in the middle of a burst
+    void size_slots() {
+        if (config_.policy != OverloadPolicy::CONFLATE || slots_.size() >= SymbolTable::capacity()) return;
+        slots_.resize(SymbolTable::capacity());
+        parked_.resize(SymbolTable::capacity(), 0);
+        order_.reserve(SymbolTable::capacity());
+    }
+
+    // Returns the ticks lost to replacement
+    std::size_t park(const Tick* ticks, std::size_t n) {
+        std::size_t lost = 0;
+        uint64_t replaced = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const SymbolId symbol = ticks[i].symbol_id;
+            if (symbol >= slots_.size()) {  // INVALID_SYMBOL_ID, or beyond the table
+                ++lost;
+                continue;
+            }
+            slots_[symbol] = ticks[i];
+            if (parked_[symbol]) {
+                ++replaced;
+            } else {
+                parked_[symbol] = 1;
+                order_.push_back(symbol);
+            }
+        }
+        if (replaced > 0) {
+            conflated_.store(conflated_.load(std::memory_order_relaxed) + replaced, std::memory_order_relaxed);
+        }
+        return lost + replaced;
+    }
+};
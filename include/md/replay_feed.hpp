@@ -0,0 +1,194 @@
+#pragma once
+#include "io/journal.hpp"
+#include "md/tick.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ReplayMode {
+    AS_FAST_AS_POSSIBLE,    // Push as quickly as the queue accepts (throughput runs)
+    PACED                   // Release each tick at its recorded offset / speed
+};
+
+enum class ReplayTimestamps {
+    RESTAMP,                // Stamp with TickClock::now() when pushed (live latency)
+    RECORDED                // Keep the recorded timestamps (backtests, rate limits)
+};
+
+struct ReplayConfig {
+    ReplayMode mode{ReplayMode::AS_FAST_AS_POSSIBLE};
+    double speed{1.0};                      // PACED: 2.0 replays twice as fast
+    ReplayTimestamps timestamps{ReplayTimestamps::RESTAMP};
+    bool drop_when_full{false};             // Default waits for the consumer
+};
+
+// Tick source that replays recorded TickJournal files into the same queues
+// FeedSimulator feeds. Files are memory-mapped and played back in the order
+// given (one session's rotated files, oldest first). Symbols are re-interned
+// by name, so recordings from another process map onto this SymbolTable.
+class ReplayFeed {
+private:
+    static constexpr std::size_t PUSH_BATCH = 64;
+    static constexpr std::size_t MAX_MAPPED_ID = 1 << 20;  // Larger ids resolve by name each time
+    static constexpr auto SPIN_WINDOW = std::chrono::microseconds(100);
+
+    std::vector<std::unique_ptr<JournalReader<TickRecord>>> files_;
+    std::vector<SymbolId> symbol_map_;  // Recorded id -> local id
+    ReplayConfig config_;
+    uint64_t total_ticks_{0};
+
+    std::atomic<uint64_t> ticks_replayed_{0};
+    std::atomic<uint64_t> ticks_dropped_{0};
+
+public:
+    // Throws std::runtime_error if a file is missing or not a tick journal
+    explicit ReplayFeed(const std::vector<std::string>& paths, ReplayConfig config = {})
+        : config_(config) {
+        if (!(config_.speed > 0.0)) {
+            throw std::invalid_argument("Replay speed must be positive");
+        }
+        files_.reserve(paths.size());
+        for (const auto& path : paths) {
+            files_.push_back(std::make_unique<JournalReader<TickRecord>>(path));
+            total_ticks_ += files_.back()->size();
+        }
+    }
+
+    // Replay every file once, or until running turns false. Returns the
+    // number of ticks pushed.
+    template<typename Queue>
+    uint64_t run(Queue& queue, const std::atomic<bool>& running) {
+        const uint64_t start_count = ticks_replayed();
+        const auto start_time = std::chrono::steady_clock::now();
+        int64_t origin_ns = 0;
+        bool have_origin = false;
+
+        Tick batch[PUSH_BATCH];
+        for (const auto& file : files_) {
+            const TickRecord* record = file->begin();
+            const TickRecord* const end = file->end();
+
+            while (record != end) {
+                if (!running.load(std::memory_order_acquire)) {
+                    return ticks_replayed() - start_count;
+                }
+
+                std::chrono::steady_clock::time_point batch_due{};
+                if (config_.mode == ReplayMode::PACED) {
+                    if (!have_origin) {
+                        origin_ns = record->timestamp_ns;
+                        have_origin = true;
+                    }
+                    wait_until(due_time(start_time, origin_ns, record->timestamp_ns));
+                    batch_due = std::chrono::steady_clock::now();
+                }
+
+                // Everything already due goes out in one push
+                const auto stamp = TickClock::now();
+                std::size_t n = 0;
+                while (record != end && n < PUSH_BATCH) {
+                    if (config_.mode == ReplayMode::PACED && n > 0 &&
+                        due_time(start_time, origin_ns, record->timestamp_ns) > batch_due) {
+                        break;
+                    }
+                    batch[n++] = to_tick(*record, stamp);
+                    ++record;
+                }
+
+                push_batch(queue, batch, n, running);
+            }
+        }
+        return ticks_replayed() - start_count;
+    }
+
+    // Statistics
+    [[nodiscard]] uint64_t total_ticks() const noexcept { return total_ticks_; }
+    [[nodiscard]] std::size_t file_count() const noexcept { return files_.size(); }
+
+    [[nodiscard]] uint64_t ticks_replayed() const noexcept {
+        return ticks_replayed_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t ticks_dropped() const noexcept {
+        return ticks_dropped_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] double drop_rate() const noexcept {
+        const auto attempted = ticks_replayed() + ticks_dropped();
+        return attempted > 0 ? static_cast<double>(ticks_dropped()) / attempted : 0.0;
+    }
+
+    void reset_stats() noexcept {
+        ticks_replayed_.store(0, std::memory_order_release);
+        ticks_dropped_.store(0, std::memory_order_release);
+    }
+
+private:
+    [[nodiscard]] std::chrono::steady_clock::time_point due_time(
+        std::chrono::steady_clock::time_point start, int64_t origin_ns, int64_t timestamp_ns) const noexcept {
+        const double offset_ns = static_cast<double>(timestamp_ns - origin_ns) / config_.speed;
+        return start + std::chrono::nanoseconds(static_cast<int64_t>(offset_ns));
+    }
+
+    // Sleep for the bulk of the gap, then spin so bursts keep their spacing
+    static void wait_until(std::chrono::steady_clock::time_point due) noexcept {
+        if (due - std::chrono::steady_clock::now() > SPIN_WINDOW) {
+            std::this_thread::sleep_until(due - SPIN_WINDOW);
+        }
+        while (std::chrono::steady_clock::now() < due) {}
+    }
+
+    SymbolId resolve_symbol(const TickRecord& record) {
+        const std::size_t recorded = record.symbol_id;
+        if (recorded >= MAX_MAPPED_ID) {
+            return SymbolTable::intern_id(record.symbol);
+        }
+        if (recorded >= symbol_map_.size()) {
+            symbol_map_.resize(recorded + 1, INVALID_SYMBOL_ID);
+        }
+        SymbolId& local = symbol_map_[recorded];
+        if (local == INVALID_SYMBOL_ID) {
+            local = SymbolTable::intern_id(record.symbol);
+        }
+        return local;
+    }
+
+    Tick to_tick(const TickRecord& record, TickClock::time_point stamp) {
+        const auto timestamp = config_.timestamps == ReplayTimestamps::RECORDED
+            ? TickClock::time_point(std::chrono::duration_cast<TickClock::duration>(
+                  std::chrono::nanoseconds(record.timestamp_ns)))
+            : stamp;
+        return Tick{resolve_symbol(record), record.last_price, record.bid_price,
+                    record.ask_price, record.last_size, record.sequence_id, timestamp};
+    }
+
+    template<typename Queue>
+    void push_batch(Queue& queue, const Tick* batch, std::size_t n, const std::atomic<bool>& running) {
+        std::size_t offset = 0;
+        while (offset < n) {
+            std::size_t pushed;
+            if constexpr (requires { queue.try_push_n(batch, n); }) {
+                pushed = queue.try_push_n(batch + offset, n - offset);
+            } else {
+                pushed = queue.push(Tick(batch[offset])) ? 1 : 0;
+            }
+            offset += pushed;
+            ticks_replayed_.fetch_add(pushed, std::memory_order_relaxed);
+
+            if (offset < n && pushed == 0) {
+                if (config_.drop_when_full) {
+                    ticks_dropped_.fetch_add(n - offset, std::memory_order_relaxed);
+                    return;
+                }
+                if (!running.load(std::memory_order_acquire)) return;
+                std::this_thread::yield();
+            }
+        }
+    }
+};
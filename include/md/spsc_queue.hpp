@@ -11,16 +11,43 @@ class SPSCQueue {
     static_assert(std::is_move_constructible_v<T>, "T must be move constructible");
 
 private:
-    // Cache line alignment to prevent false sharing
-    alignas(64) std::atomic<size_t> head_{0};
-    alignas(64) std::atomic<size_t> tail_{0};
+    // Cache line alignment to prevent false sharing. Each side keeps a private
+    // copy of the other side's index next to its own, and only reloads the
+    // shared atomic when the cached value says the ring is full/empty.
+    alignas(64) std::atomic<size_t> head_{0};   // Written by producer
+    size_t tail_cache_{0};                      // Producer's view of tail_
+    alignas(64) std::atomic<size_t> tail_{0};   // Written by consumer
+    size_t head_cache_{0};                      // Consumer's view of head_
 
     // Ring buffer storage
     alignas(64) T buffer_[N];
 
     static constexpr size_t MASK = N - 1;
+    static constexpr size_t CAPACITY = N - 1; // One slot reserved to distinguish full from empty
+
+    // Producer side: free slots, refreshing the cached tail only when needed
+    [[nodiscard]] size_t free_slots(size_t head, size_t wanted) noexcept {
+        size_t free = CAPACITY - (head - tail_cache_);
+        if (free < wanted) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            free = CAPACITY - (head - tail_cache_);
+        }
+        return free;
+    }
+
+    // Consumer side: readable slots, refreshing the cached head only when needed
+    [[nodiscard]] size_t readable_slots(size_t tail, size_t wanted) noexcept {
+        size_t available = head_cache_ - tail;
+        if (available < wanted) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            available = head_cache_ - tail;
+        }
+        return available;
+    }
 
 public:
+    using value_type = T;
+
     SPSCQueue() = default;
 
     // Non-copyable, non-movable for thread safety
@@ -32,11 +59,7 @@ public:
     // Producer side - single thread only
     [[nodiscard]] bool push(const T& item) noexcept {
         const size_t head = head_.load(std::memory_order_relaxed);
-        const size_t tail = tail_.load(std::memory_order_acquire);
-        const size_t next_head = head + 1;
-
-        // Check if queue is full (need to leave one slot empty to distinguish full from empty)
-        if ((next_head & MASK) == (tail & MASK)) {
+        if (free_slots(head, 1) == 0) {
             return false; // Queue full
         }
 
@@ -44,32 +67,46 @@ public:
         buffer_[head & MASK] = item;
 
         // Publish the new head (release semantics ensure all writes are visible)
-        head_.store(next_head, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
         return true;
     }
 
     // Move version for better performance
     [[nodiscard]] bool push(T&& item) noexcept {
         const size_t head = head_.load(std::memory_order_relaxed);
-        const size_t tail = tail_.load(std::memory_order_acquire);
-        const size_t next_head = head + 1;
-
-        if ((next_head & MASK) == (tail & MASK)) {
+        if (free_slots(head, 1) == 0) {
             return false;
         }
 
         buffer_[head & MASK] = std::move(item);
-        head_.store(next_head, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
         return true;
     }
 
+    // Push up to count items with a single publish; returns how many were accepted
+    [[nodiscard]] size_t try_push_n(const T* items, size_t count) noexcept {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t free = free_slots(head, count);
+        const size_t n = count < free ? count : free;
+        if (n == 0) return 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(head + i) & MASK] = items[i];
+        }
+
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Slots the next pushes are sure to fill; the consumer may free more meanwhile
+    [[nodiscard]] size_t free_space() noexcept {
+        return free_slots(head_.load(std::memory_order_relaxed), CAPACITY);
+    }
+
     // Consumer side - single thread only
     [[nodiscard]] bool pop(T& item) noexcept {
         const size_t tail = tail_.load(std::memory_order_relaxed);
-        const size_t head = head_.load(std::memory_order_acquire);
-
-        // Check if queue is empty (compare masked indices)
-        if ((tail & MASK) == (head & MASK)) {
+        if (readable_slots(tail, 1) == 0) {
             return false; // Queue empty
         }
 
@@ -81,11 +118,45 @@ public:
         return true;
     }
 
+    // Pop up to max_items into out with a single publish; returns how many were taken
+    [[nodiscard]] size_t try_pop_n(T* out, size_t max_items) noexcept {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t available = readable_slots(tail, max_items);
+        const size_t n = max_items < available ? max_items : available;
+        if (n == 0) return 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(buffer_[(tail + i) & MASK]);
+        }
+
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Hand every currently readable item to handler in place, then release the
+    // whole span with one store. Returns the number of items consumed.
+    template <typename Handler>
+    size_t consume_all(Handler&& handler, size_t max_items = CAPACITY) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t available = readable_slots(tail, max_items);
+        const size_t n = max_items < available ? max_items : available;
+        if (n == 0) return 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            handler(buffer_[(tail + i) & MASK]);
+        }
+
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
     // Utility functions (approximate, not thread-safe)
     [[nodiscard]] size_t size() const noexcept {
-        const size_t head = head_.load(std::memory_order_acquire);
+        // Read tail first so head >= tail even while both sides are moving
         const size_t tail = tail_.load(std::memory_order_acquire);
-        return (head - tail) & MASK;
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t used = head - tail;
+        return used < CAPACITY ? used : CAPACITY;
     }
 
     [[nodiscard]] bool empty() const noexcept {
@@ -93,7 +164,7 @@ public:
     }
 
     [[nodiscard]] constexpr size_t capacity() const noexcept {
-        return N - 1; // One slot reserved to distinguish full from empty
+        return CAPACITY;
     }
 
     // Get fill percentage (0.0 to 1.0)
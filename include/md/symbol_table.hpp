@@ -0,0 +1,194 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+// Dense integer handle for an interned symbol
+using SymbolId = uint32_t;
+inline constexpr SymbolId INVALID_SYMBOL_ID = UINT32_MAX;
+
+// Symbol interning for zero-allocation string handling
+//
+// Each distinct symbol gets a dense id, so hot-path state can live in flat arrays.
+// The table is an append-only, open-addressed hash of atomic slots: lookups never
+// lock, and concurrent interns of new symbols race only on a single slot CAS.
+// Ids and the returned string_views stay valid for the life of the process.
+class SymbolTable {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+    struct Entry {
+        SymbolId id{INVALID_SYMBOL_ID};
+        std::string_view name;
+    };
+
+    // Size the table for max_symbols. Must run before the first intern/find;
+    // afterwards it only succeeds if the live table is already large enough.
+    static bool reserve(std::size_t max_symbols) {
+        if (created().load(std::memory_order_acquire)) {
+            return max_symbols <= instance().capacity;
+        }
+        requested_capacity().store(max_symbols, std::memory_order_release);
+        return true;
+    }
+
+    // Returns the id for sym, assigning the next free id on first sight
+    static SymbolId intern_id(std::string_view sym) {
+        return instance().intern(sym);
+    }
+
+    // Returns the id and stable view for sym
+    static Entry intern_entry(std::string_view sym) {
+        auto& table = instance();
+        const SymbolId id = table.intern(sym);
+        return {id, table.names[id]};
+    }
+
+    static std::string_view intern(std::string_view sym) {
+        return intern_entry(sym).name;
+    }
+
+    // Returns the id for sym, or INVALID_SYMBOL_ID if it was never interned
+    [[nodiscard]] static SymbolId find(std::string_view sym) noexcept {
+        return instance().find(sym);
+    }
+
+    // Id -> name is a plain array index. Valid for any id handed out by
+    // intern_id/find (or carried in a Tick that crossed a queue).
+    [[nodiscard]] static std::string_view name(SymbolId id) noexcept {
+        auto& table = instance();
+        return id < table.capacity ? table.names[id] : std::string_view{};
+    }
+
+    // Number of ids handed out so far (approximate under concurrent interning)
+    [[nodiscard]] static std::size_t size() noexcept {
+        auto& table = instance();
+        const std::size_t n = table.next_id.load(std::memory_order_acquire);
+        return n < table.capacity ? n : table.capacity;
+    }
+
+    [[nodiscard]] static std::size_t capacity() noexcept {
+        return instance().capacity;
+    }
+
+private:
+    // Slot states: EMPTY, BUSY (claimed, id being published), or id + 1
+    static constexpr uint32_t EMPTY_SLOT = 0;
+    static constexpr uint32_t BUSY_SLOT = UINT32_MAX;
+
+    struct Table {
+        std::size_t capacity;
+        std::size_t slot_mask;
+        std::unique_ptr<std::atomic<uint32_t>[]> slots;
+        std::unique_ptr<std::size_t[]> hashes;           // By id
+        std::unique_ptr<std::string_view[]> names;       // By id
+        std::unique_ptr<std::unique_ptr<char[]>[]> storage;
+        std::atomic<std::size_t> next_id{0};
+
+        explicit Table(std::size_t max_symbols)
+            : capacity(max_symbols > 0 ? max_symbols : 1)
+            , slot_mask(slot_count_for(capacity) - 1)
+            , slots(std::make_unique<std::atomic<uint32_t>[]>(slot_mask + 1))
+            , hashes(std::make_unique<std::size_t[]>(capacity))
+            , names(std::make_unique<std::string_view[]>(capacity))
+            , storage(std::make_unique<std::unique_ptr<char[]>[]>(capacity)) {
+            for (std::size_t i = 0; i <= slot_mask; ++i) {
+                slots[i].store(EMPTY_SLOT, std::memory_order_relaxed);
+            }
+        }
+
+        // Keep the load factor at or below one half
+        static std::size_t slot_count_for(std::size_t n) noexcept {
+            std::size_t slots = 2;
+            while (slots < 2 * n) slots <<= 1;
+            return slots;
+        }
+
+        [[nodiscard]] SymbolId find(std::string_view sym) const noexcept {
+            const std::size_t hash = std::hash<std::string_view>{}(sym);
+            for (std::size_t i = hash & slot_mask, probes = 0; probes <= slot_mask;
+                 i = (i + 1) & slot_mask, ++probes) {
+                const uint32_t value = wait_published(i);
+                if (value == EMPTY_SLOT) return INVALID_SYMBOL_ID;
+                if (matches(value - 1, hash, sym)) return value - 1;
+            }
+            return INVALID_SYMBOL_ID;
+        }
+
+        SymbolId intern(std::string_view sym) {
+            const std::size_t hash = std::hash<std::string_view>{}(sym);
+            for (std::size_t i = hash & slot_mask, probes = 0; probes <= slot_mask;
+                 i = (i + 1) & slot_mask, ++probes) {
+                uint32_t value = wait_published(i);
+                while (value == EMPTY_SLOT) {
+                    if (slots[i].compare_exchange_weak(value, BUSY_SLOT,
+                                                       std::memory_order_acquire,
+                                                       std::memory_order_acquire)) {
+                        return publish(i, hash, sym);
+                    }
+                    if (value == BUSY_SLOT) value = wait_published(i);
+                }
+                if (matches(value - 1, hash, sym)) return value - 1;
+            }
+            throw std::runtime_error("Symbol table overflow - call SymbolTable::reserve() before first use");
+        }
+
+    private:
+        [[nodiscard]] uint32_t wait_published(std::size_t slot) const noexcept {
+            uint32_t value = slots[slot].load(std::memory_order_acquire);
+            while (value == BUSY_SLOT) {
+                std::this_thread::yield();
+                value = slots[slot].load(std::memory_order_acquire);
+            }
+            return value;
+        }
+
+        [[nodiscard]] bool matches(SymbolId id, std::size_t hash,
+                                   std::string_view sym) const noexcept {
+            return hashes[id] == hash && names[id] == sym;
+        }
+
+        // Called with the slot claimed as BUSY
+        SymbolId publish(std::size_t slot, std::size_t hash, std::string_view sym) {
+            const std::size_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+            if (id >= capacity) {
+                slots[slot].store(EMPTY_SLOT, std::memory_order_release);
+                throw std::runtime_error("Symbol table overflow - call SymbolTable::reserve() before first use");
+            }
+
+            storage[id] = std::make_unique<char[]>(sym.size() + 1);
+            std::memcpy(storage[id].get(), sym.data(), sym.size());
+            storage[id][sym.size()] = '\0';
+            names[id] = std::string_view{storage[id].get(), sym.size()};
+            hashes[id] = hash;
+
+            // Release makes the name visible to anyone who later sees this slot
+            slots[slot].store(static_cast<uint32_t>(id) + 1, std::memory_order_release);
+            return static_cast<SymbolId>(id);
+        }
+    };
+
+    static std::atomic<std::size_t>& requested_capacity() noexcept {
+        static std::atomic<std::size_t> requested{DEFAULT_CAPACITY};
+        return requested;
+    }
+
+    static std::atomic<bool>& created() noexcept {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+
+    static Table& instance() {
+        static Table table = [] {
+            created().store(true, std::memory_order_release);
+            return Table(requested_capacity().load(std::memory_order_acquire));
+        }();
+        return table;
+    }
+};
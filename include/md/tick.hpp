@@ -1,49 +1,9 @@
 #pragma once
+#include "md/symbol_table.hpp"
+#include "util/clock.hpp"
 #include <chrono>
 #include <string_view>
 #include <cstdint>
-#include <array>
-#include <unordered_map>
-#include <atomic>
-#include <mutex>
-#include <stdexcept>
-
-// Symbol interning for zero-allocation string handling
-struct SymbolTable {
-    static constexpr size_t MAX_SYMBOLS = 256;
-
-    static inline std::string_view intern(const std::string& sym) {
-        // Thread-safe symbol pool using static storage
-        static std::array<std::string, MAX_SYMBOLS> symbol_pool;
-        static std::unordered_map<std::string_view, size_t> symbol_index;
-        static std::atomic<size_t> next_id{0};
-        static std::mutex pool_mutex;
-
-        // Fast path: check if symbol already exists (lock-free read)
-        auto it = symbol_index.find(sym);
-        if (it != symbol_index.end()) {
-            return std::string_view{symbol_pool[it->second]};
-        }
-
-        // Slow path: add new symbol (locked write)
-        std::lock_guard<std::mutex> lock(pool_mutex);
-
-        // Double-check after acquiring lock
-        it = symbol_index.find(sym);
-        if (it != symbol_index.end()) {
-            return std::string_view{symbol_pool[it->second]};
-        }
-
-        size_t id = next_id.fetch_add(1, std::memory_order_relaxed);
-        if (id >= MAX_SYMBOLS) {
-            throw std::runtime_error("Symbol table overflow - increase MAX_SYMBOLS");
-        }
-
-        symbol_pool[id] = sym;
-        symbol_index[std::string_view{symbol_pool[id]}] = id;
-        return std::string_view{symbol_pool[id]};
-    }
-};
 
 // Optimized tick structure - carefully ordered for cache efficiency
 struct alignas(64) Tick {
@@ -54,27 +14,32 @@ struct alignas(64) Tick {
     double last_size{0.0};         // 8 bytes - Total: 32 bytes
 
     // Timestamp (critical for latency measurement)
-    std::chrono::steady_clock::time_point timestamp; // 8 bytes
-
-    // Symbol reference (zero-copy)
-    std::string_view symbol;       // 16 bytes (ptr + size)
+    TickClock::time_point timestamp; // 8 bytes
 
     // Sequence number for ordering/gap detection
-    uint64_t sequence_id{0};       // 8 bytes - Total so far: 64 bytes
+    uint64_t sequence_id{0};       // 8 bytes
+
+    // Interned symbol handle (resolve with symbol())
+    SymbolId symbol_id{INVALID_SYMBOL_ID}; // 4 bytes - Total: 52 bytes, padded to 64
 
     // Default constructor
     Tick() = default;
 
-    // Constructor with all fields
-    Tick(std::string_view sym, double last, double bid, double ask,
+    // Constructor with all fields, stamped now
+    Tick(SymbolId sym, double last, double bid, double ask,
          double size, uint64_t seq) noexcept
+        : Tick(sym, last, bid, ask, size, seq, TickClock::now()) {}
+
+    // Constructor with an explicit timestamp (one clock read shared by a batch)
+    Tick(SymbolId sym, double last, double bid, double ask,
+         double size, uint64_t seq, TickClock::time_point ts) noexcept
         : last_price(last)
         , bid_price(bid)
         , ask_price(ask)
         , last_size(size)
-        , timestamp(std::chrono::steady_clock::now())
-        , symbol(sym)
-        , sequence_id(seq) {}
+        , timestamp(ts)
+        , sequence_id(seq)
+        , symbol_id(sym) {}
 
     // Move constructor and assignment (efficient)
     Tick(Tick&&) noexcept = default;
@@ -85,6 +50,10 @@ struct alignas(64) Tick {
     Tick& operator=(const Tick&) = default;
 
     // Utility methods
+    [[nodiscard]] std::string_view symbol() const noexcept {
+        return SymbolTable::name(symbol_id);
+    }
+
     [[nodiscard]] double mid_price() const noexcept {
         return (bid_price + ask_price) * 0.5;
     }
@@ -100,7 +69,7 @@ struct alignas(64) Tick {
 
     [[nodiscard]] bool is_valid() const noexcept {
         return last_price > 0.0 && bid_price > 0.0 && ask_price > 0.0
-               && bid_price <= ask_price && !symbol.empty();
+               && bid_price <= ask_price && symbol_id != INVALID_SYMBOL_ID;
     }
 };
 
@@ -116,6 +85,8 @@ struct alignas(32) SignalEvent {
 
     // Event details
     Type event_type{Type::Z_SCORE_BREAK};
+    SymbolId primary_id{INVALID_SYMBOL_ID};
+    SymbolId secondary_id{INVALID_SYMBOL_ID}; // For pair signals
     std::string_view primary_symbol;
     std::string_view secondary_symbol; // For pair signals
 
@@ -123,33 +94,51 @@ struct alignas(32) SignalEvent {
     double signal_strength{0.0};
     double confidence{0.0};
 
-    // Timing
-    std::chrono::steady_clock::time_point event_time;
-    std::chrono::steady_clock::time_point generation_time;
+    // Timing: event_time is when the triggering data arrived,
+    // generation_time when the signal was emitted
+    SignalClock::time_point event_time;
+    SignalClock::time_point generation_time;
 
     // Sequence for ordering
     uint64_t signal_id{0};
 
     SignalEvent() = default;
 
-    SignalEvent(Type type, std::string_view primary, double strength) noexcept
+    SignalEvent(Type type, SymbolId primary, double strength) noexcept
         : event_type(type)
-        , primary_symbol(primary)
+        , primary_id(primary)
+        , primary_symbol(SymbolTable::name(primary))
         , signal_strength(strength)
         , confidence(1.0)
-        , event_time(std::chrono::steady_clock::now())
+        , event_time(SignalClock::now())
         , generation_time(event_time) {}
 
-    SignalEvent(Type type, std::string_view primary, std::string_view secondary,
+    SignalEvent(Type type, SymbolId primary, SymbolId secondary,
                 double strength, double conf = 1.0) noexcept
         : event_type(type)
-        , primary_symbol(primary)
-        , secondary_symbol(secondary)
+        , primary_id(primary)
+        , secondary_id(secondary)
+        , primary_symbol(SymbolTable::name(primary))
+        , secondary_symbol(SymbolTable::name(secondary))
         , signal_strength(strength)
         , confidence(conf)
-        , event_time(std::chrono::steady_clock::now())
+        , event_time(SignalClock::now())
         , generation_time(event_time) {}
 
+    // Signal caused by data stamped event; generation_time is left for the
+    // emitter to stamp
+    SignalEvent(Type type, SymbolId primary, SymbolId secondary,
+                double strength, double conf, SignalClock::time_point event) noexcept
+        : event_type(type)
+        , primary_id(primary)
+        , secondary_id(secondary)
+        , primary_symbol(SymbolTable::name(primary))
+        , secondary_symbol(SymbolTable::name(secondary))
+        , signal_strength(strength)
+        , confidence(conf)
+        , event_time(event)
+        , generation_time(event) {}
+
     [[nodiscard]] std::chrono::microseconds latency() const noexcept {
         return std::chrono::duration_cast<std::chrono::microseconds>(
             generation_time - event_time);
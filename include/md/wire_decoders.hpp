@@ -0,0 +1,359 @@
+#pragma once
+#include "md/tick.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// Outcome of decoding one datagram
+struct DecodeResult {
+    std::size_t ticks{0};       // Written to the front of out
+    bool malformed{false};      // The packet, or its tail, could not be used
+};
+
+// Turns one datagram into Ticks stamped with rx_time, writing at most
+// out.size() of them. Decoders hold the protocol's session state (instrument
+// maps, sequence numbers) and run on the feed handler's thread only.
+template <typename D>
+concept PacketDecoder = requires(D& decoder, std::span<const std::byte> packet,
+                                 TickClock::time_point rx_time, std::span<Tick> out) {
+    { decoder.decode(packet, rx_time, out) } -> std::same_as<DecodeResult>;
+};
+
+// RTMD, the engine's binary multicast format. A packet is a header followed
+// by message_count fixed-size messages; every message takes one sequence
+// number, the header carrying the first (as in MoldUDP64), so lost and
+// replayed packets show up as sequence gaps and duplicates. Instruments are
+// announced once with their symbol and tick size; quotes then carry prices
+// as integers on that grid, like CompactTick. All fields little-endian.
+static_assert(std::endian::native == std::endian::little, "RTMD structs are read in place on little-endian hosts");
+
+inline constexpr uint32_t RTMD_MAGIC = 0x444D5452;    // "RTMD"
+inline constexpr uint16_t RTMD_VERSION = 1;
+inline constexpr std::size_t RTMD_MAX_PACKET_BYTES = 1472;  // One Ethernet frame of UDP payload
+
+#pragma pack(push, 1)
+struct RtmdPacketHeader {
+    uint32_t magic{RTMD_MAGIC};
+    uint16_t version{RTMD_VERSION};
+    uint16_t message_count{0};
+    uint64_t sequence{0};       // Of the first message
+};
+
+enum class RtmdMessageType : uint8_t {
+    INSTRUMENT = 'I',
+    QUOTE = 'Q',
+};
+
+struct RtmdInstrument {
+    RtmdMessageType type{RtmdMessageType::INSTRUMENT};
+    uint8_t reserved[3]{};
+    uint32_t instrument_id{0};
+    double tick_size{0.01};
+    char symbol[16]{};          // NUL-padded
+};
+
+struct RtmdQuote {
+    RtmdMessageType type{RtmdMessageType::QUOTE};
+    uint8_t reserved{0};
+    int16_t bid_offset{0};      // (last - bid) in ticks
+    uint32_t instrument_id{0};
+    int64_t last_px{0};         // last_price / tick_size
+    int16_t ask_offset{0};      // (ask - last) in ticks
+    uint16_t reserved2{0};
+    uint32_t size{0};
+};
+#pragma pack(pop)
+static_assert(sizeof(RtmdPacketHeader) == 16 && sizeof(RtmdInstrument) == 32 && sizeof(RtmdQuote) == 24);
+
+// Builds RTMD packets (feed publishers, tests, load generators). Messages
+// accumulate until the packet is full; finish() writes the header and
+// clear() starts the next packet at the following sequence number.
+class RtmdPacketBuilder {
+private:
+    std::vector<std::byte> buffer_;
+    uint64_t sequence_;
+    uint16_t message_count_{0};
+
+public:
+    explicit RtmdPacketBuilder(uint64_t first_sequence = 1)
+        : sequence_(first_sequence) {
+        buffer_.reserve(RTMD_MAX_PACKET_BYTES);
+        buffer_.resize(sizeof(RtmdPacketHeader));
+    }
+
+    // False when the message no longer fits this packet
+    bool add_instrument(uint32_t instrument_id, std::string_view symbol, double tick_size) {
+        if (symbol.empty() || symbol.size() > sizeof(RtmdInstrument::symbol)) {
+            throw std::invalid_argument("RTMD symbols are 1 to 16 characters");
+        }
+        if (!(tick_size > 0.0)) throw std::invalid_argument("Tick size must be positive");
+        RtmdInstrument message;
+        message.instrument_id = instrument_id;
+        message.tick_size = tick_size;
+        std::memcpy(message.symbol, symbol.data(), symbol.size());
+        return append(message);
+    }
+
+    bool add_quote(const RtmdQuote& quote) {
+        return append(quote);
+    }
+
+    // Quote for tick on instrument_id's grid. False when the packet is full
+    // or the spread does not fit the 16-bit offsets.
+    bool add_tick(uint32_t instrument_id, const Tick& tick, double tick_size) {
+        const double inv = 1.0 / tick_size;
+        const double last = std::round(tick.last_price * inv);
+        const double bid_offset = last - std::round(tick.bid_price * inv);
+        const double ask_offset = std::round(tick.ask_price * inv) - last;
+        constexpr double OFFSET_MAX = std::numeric_limits<int16_t>::max();
+        if (!(std::abs(bid_offset) <= OFFSET_MAX && std::abs(ask_offset) <= OFFSET_MAX)) return false;
+
+        RtmdQuote quote;
+        quote.instrument_id = instrument_id;
+        quote.last_px = static_cast<int64_t>(last);
+        quote.bid_offset = static_cast<int16_t>(bid_offset);
+        quote.ask_offset = static_cast<int16_t>(ask_offset);
+        quote.size = static_cast<uint32_t>(std::clamp(std::round(tick.last_size), 0.0, 4294967295.0));
+        return append(quote);
+    }
+
+    // Complete packet, valid until the builder is modified
+    [[nodiscard]] std::span<const std::byte> finish() {
+        RtmdPacketHeader header;
+        header.message_count = message_count_;
+        header.sequence = sequence_;
+        std::memcpy(buffer_.data(), &header, sizeof(header));
+        return buffer_;
+    }
+
+    void clear() noexcept {
+        sequence_ += message_count_;
+        message_count_ = 0;
+        buffer_.resize(sizeof(RtmdPacketHeader));
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return message_count_ == 0; }
+    [[nodiscard]] uint16_t message_count() const noexcept { return message_count_; }
+    [[nodiscard]] uint64_t next_sequence() const noexcept { return sequence_ + message_count_; }
+
+private:
+    template <typename Message>
+    bool append(const Message& message) {
+        if (buffer_.size() + sizeof(Message) > RTMD_MAX_PACKET_BYTES ||
+            message_count_ == std::numeric_limits<uint16_t>::max()) {
+            return false;
+        }
+        const std::size_t offset = buffer_.size();
+        buffer_.resize(offset + sizeof(Message));
+        std::memcpy(buffer_.data() + offset, &message, sizeof(Message));
+        ++message_count_;
+        return true;
+    }
+};
+
+// Decoder for RTMD. Quotes for instruments not yet announced are skipped and
+// counted; a packet older than the expected sequence is a duplicate (e.g. the
+// other line of an A/B feed) and dropped whole.
+class RtmdDecoder {
+public:
+    static constexpr uint32_t MAX_INSTRUMENT_ID = 1 << 20;
+
+private:
+    struct Instrument {
+        SymbolId symbol{INVALID_SYMBOL_ID};
+        double tick_size{0.0};
+    };
+
+    std::vector<Instrument> instruments_;   // Indexed by instrument_id
+    uint64_t next_sequence_{0};             // 0 until the first packet
+
+    std::atomic<uint64_t> sequence_gaps_{0};        // Messages missed
+    std::atomic<uint64_t> duplicate_packets_{0};
+    std::atomic<uint64_t> unknown_instruments_{0};  // Quotes before their definition
+
+public:
+    RtmdDecoder() = default;
+    RtmdDecoder(RtmdDecoder&& other) noexcept
+        : instruments_(std::move(other.instruments_))
+        , next_sequence_(other.next_sequence_)
+        , sequence_gaps_(other.sequence_gaps())
+        , duplicate_packets_(other.duplicate_packets())
+        , unknown_instruments_(other.unknown_instruments()) {}
+
+    DecodeResult decode(std::span<const std::byte> packet, TickClock::time_point rx_time, std::span<Tick> out) {
+        RtmdPacketHeader header;
+        if (packet.size() < sizeof(header)) return {0, true};
+        std::memcpy(&header, packet.data(), sizeof(header));
+        if (header.magic != RTMD_MAGIC || header.version != RTMD_VERSION) return {0, true};
+
+        if (next_sequence_ != 0) {
+            if (header.sequence < next_sequence_) {
+                duplicate_packets_.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+            if (header.sequence > next_sequence_) {
+                sequence_gaps_.fetch_add(header.sequence - next_sequence_, std::memory_order_relaxed);
+            }
+        }
+        next_sequence_ = header.sequence + header.message_count;
+
+        DecodeResult result;
+        std::size_t offset = sizeof(header);
+        for (uint16_t i = 0; i < header.message_count; ++i) {
+            if (offset >= packet.size()) return {result.ticks, true};
+            const auto type = static_cast<RtmdMessageType>(packet[offset]);
+            if (type == RtmdMessageType::QUOTE) {
+                RtmdQuote quote;
+                if (!read(packet, offset, quote) || result.ticks == out.size()) return {result.ticks, true};
+                if (decode_quote(quote, header.sequence + i, rx_time, out[result.ticks])) ++result.ticks;
+            } else if (type == RtmdMessageType::INSTRUMENT) {
+                RtmdInstrument instrument;
+                if (!read(packet, offset, instrument)) return {result.ticks, true};
+                if (!define(instrument)) result.malformed = true;  // The rest still decodes
+            } else {
+                return {result.ticks, true};  // Unknown type: its length is unknown too
+            }
+        }
+        return result;
+    }
+
+    // Ticker an instrument was announced as, INVALID_SYMBOL_ID if never
+    [[nodiscard]] SymbolId symbol_of(uint32_t instrument_id) const noexcept {
+        return instrument_id < instruments_.size() ? instruments_[instrument_id].symbol : INVALID_SYMBOL_ID;
+    }
+
+    [[nodiscard]] uint64_t sequence_gaps() const noexcept {
+        return sequence_gaps_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t duplicate_packets() const noexcept {
+        return duplicate_packets_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint64_t unknown_instruments() const noexcept {
+        return unknown_instruments_.load(std::memory_order_acquire);
+    }
+
+private:
+    template <typename Message>
+    static bool read(std::span<const std::byte> packet, std::size_t& offset, Message& message) noexcept {
+        if (packet.size() - offset < sizeof(Message)) return false;
+        std::memcpy(&message, packet.data() + offset, sizeof(Message));
+        offset += sizeof(Message);
+        return true;
+    }
+
+    // False for a definition that cannot be used, including a full symbol table
+    bool define(const RtmdInstrument& message) {
+        if (message.instrument_id >= MAX_INSTRUMENT_ID || !(message.tick_size > 0.0)) return false;
+        const std::string_view symbol(message.symbol, strnlen(message.symbol, sizeof(message.symbol)));
+        if (symbol.empty()) return false;
+
+        SymbolId id;
+        try {
+            id = SymbolTable::intern_id(symbol);
+        } catch (const std::runtime_error&) {
+            return false;  // Table full
+        }
+        if (message.instrument_id >= instruments_.size()) {
+            instruments_.resize(static_cast<std::size_t>(message.instrument_id) + 1);
+        }
+        instruments_[message.instrument_id] = {id, message.tick_size};
+        return true;
+    }
+
+    bool decode_quote(const RtmdQuote& quote, uint64_t sequence, TickClock::time_point rx_time, Tick& out) noexcept {
+        if (quote.instrument_id >= instruments_.size() ||
+            instruments_[quote.instrument_id].symbol == INVALID_SYMBOL_ID) {
+            unknown_instruments_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const Instrument& instrument = instruments_[quote.instrument_id];
+        const double tick_size = instrument.tick_size;
+        out = Tick{instrument.symbol,
+                   static_cast<double>(quote.last_px) * tick_size,
+                   static_cast<double>(quote.last_px - quote.bid_offset) * tick_size,
+                   static_cast<double>(quote.last_px + quote.ask_offset) * tick_size,
+                   static_cast<double>(quote.size), sequence, rx_time};
+        return true;
+    }
+};
+
+// Line-oriented text ticks, "SYMBOL last bid ask size" separated by commas or
+// spaces, one per line. Slow next to RTMD; meant for `nc -u` style testing
+// and simple bridges. Ticks are numbered in arrival order.
+class TextTickDecoder {
+private:
+    uint64_t sequence_{0};
+
+public:
+    DecodeResult decode(std::span<const std::byte> packet, TickClock::time_point rx_time, std::span<Tick> out) {
+        std::string_view text(reinterpret_cast<const char*>(packet.data()), packet.size());
+        DecodeResult result;
+        while (!text.empty()) {
+            const std::size_t eol = text.find('\n');
+            std::string_view line = text.substr(0, eol);
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.find_first_not_of(" \t,") == std::string_view::npos) continue;
+
+            if (result.ticks == out.size()) return {result.ticks, true};
+            if (parse_line(line, rx_time, out[result.ticks])) {
+                ++result.ticks;
+            } else {
+                result.malformed = true;
+            }
+        }
+        return result;
+    }
+
+private:
+    static std::string_view next_field(std::string_view& line) noexcept {
+        const std::size_t begin = line.find_first_not_of(" \t,");
+        if (begin == std::string_view::npos) {
+            line = {};
+            return {};
+        }
+        line.remove_prefix(begin);
+        const std::size_t end = std::min(line.find_first_of(" \t,"), line.size());
+        const std::string_view field = line.substr(0, end);
+        line.remove_prefix(end);
+        return field;
+    }
+
+    static bool parse_number(std::string_view field, double& value) noexcept {
+        const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+        return ec == std::errc{} && end == field.data() + field.size() && std::isfinite(value);
+    }
+
+    bool parse_line(std::string_view line, TickClock::time_point rx_time, Tick& out) {
+        const std::string_view symbol = next_field(line);
+        double values[4];
+        for (double& value : values) {
+            if (!parse_number(next_field(line), value)) return false;
+        }
+        if (!next_field(line).empty()) return false;
+
+        SymbolId id;
+        try {
+            id = SymbolTable::intern_id(symbol);
+        } catch (const std::runtime_error&) {
+            return false;  // Table full
+        }
+        out = Tick{id, values[0], values[1], values[2], values[3], sequence_++, rx_time};
+        return true;
+    }
+};
+
+static_assert(PacketDecoder<RtmdDecoder> && PacketDecoder<TextTickDecoder>);
@@ -0,0 +1,63 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Lower-triangular Cholesky factor L of a symmetric positive-definite n x n
+// matrix (row-major), so that L * L^T == a. Entries above the diagonal are
+// zero. Throws std::invalid_argument if a is not n x n or not positive definite.
+[[nodiscard]] inline std::vector<double> cholesky_lower(const std::vector<double>& a, std::size_t n) {
+    if (a.size() != n * n) {
+        throw std::invalid_argument("Cholesky input must be an n x n matrix");
+    }
+
+    std::vector<double> l(n * n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            double sum = a[i * n + j];
+            for (std::size_t k = 0; k < j; ++k) {
+                sum -= l[i * n + k] * l[j * n + k];
+            }
+            if (i == j) {
+                if (!(sum > 0.0)) {
+                    throw std::invalid_argument("Matrix is not positive definite");
+                }
+                l[i * n + i] = std::sqrt(sum);
+            } else {
+                l[i * n + j] = sum / l[j * n + j];
+            }
+        }
+    }
+    return l;
+}
+
+// y = L * x for a lower-triangular row-major L. Works in column blocks so
+// the slice of x in use stays in L1 while the rows below stream past.
+inline void lower_triangular_multiply(const double* l, const double* x, double* y,
+                                      std::size_t n) noexcept {
+    constexpr std::size_t BLOCK = 256;
+    std::fill(y, y + n, 0.0);
+    for (std::size_t jb = 0; jb < n; jb += BLOCK) {
+        const std::size_t jend = std::min(jb + BLOCK, n);
+        for (std::size_t i = jb; i < n; ++i) {
+            const double* row = l + i * n;
+            const std::size_t end = std::min(jend, i + 1);
+            // Four partial sums: without them strict FP ordering keeps the
+            // dot product scalar
+            double acc[4] = {0.0, 0.0, 0.0, 0.0};
+            std::size_t j = jb;
+            for (; j + 4 <= end; j += 4) {
+                acc[0] += row[j] * x[j];
+                acc[1] += row[j + 1] * x[j + 1];
+                acc[2] += row[j + 2] * x[j + 2];
+                acc[3] += row[j + 3] * x[j + 3];
+            }
+            for (; j < end; ++j) {
+                acc[0] += row[j] * x[j];
+            }
+            y[i] += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+    }
+}
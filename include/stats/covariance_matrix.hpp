@@ -0,0 +1,216 @@
+#pragma once
+#include "util/aligned_buffer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// One entry of a top_decorrelating() result, i < j
+struct MatrixPair {
+    uint32_t i{0};
+    uint32_t j{0};
+    double correlation{0.0};
+    double reference_correlation{0.0};  // 0 without a reference matrix
+};
+
+// EMACovar for every pair of n series at once: means and the upper triangle
+// of the covariance matrix, updated from one observation per series (a
+// synchronized snapshot). Entry (i, j) follows exactly EMACovar's recurrence
+// for series i and j, so correlation(i, j) matches an EMACovar fed the same
+// two columns.
+//
+// Each snapshot is a rank-1 update, cov = (1-a) cov + a dx dx^T, whose inner
+// loop is a contiguous axpby the compiler vectorizes. update_batch() applies
+// several snapshots tile by tile, so each BLOCK x BLOCK tile stays in cache
+// for all of them instead of the whole matrix streaming from memory once per
+// snapshot.
+class EMACovarianceMatrix {
+public:
+    static constexpr std::size_t BLOCK = 64;  // 64 x 64 doubles = 32KB tile
+
+private:
+    std::size_t size_;
+    std::size_t stride_;  // Row length, padded to whole cache lines
+    double alpha_;
+    AlignedBuffer<double> mean_;
+    AlignedBuffer<double> cov_;  // Row-major, upper triangle (j >= i) maintained
+    std::vector<double> deltas_;  // Batch scratch: one row of deviations per snapshot
+    uint64_t observations_{0};
+
+    // Deviations of values from the current means, then advance the means
+    void advance_means(const double* values, double* delta) noexcept {
+        double* mean = mean_.data();
+        for (std::size_t i = 0; i < size_; ++i) {
+            const double d = values[i] - mean[i];
+            delta[i] = d;
+            mean[i] += alpha_ * d;
+        }
+    }
+
+    // Apply count rows of deviations to rows [ib, ie) x columns [jb, je).
+    // Each entry still sees the snapshots in order, as update() would.
+    void update_tile(const double* deltas, std::size_t count, std::size_t ib, std::size_t ie,
+                     std::size_t jb, std::size_t je) noexcept {
+        const double decay = 1.0 - alpha_;
+        for (std::size_t i = ib; i < ie; ++i) {
+            // The row segment stays in L1 across the whole batch
+            double* row = cov_.data() + i * stride_;
+            const std::size_t j0 = std::max(i, jb);
+            for (std::size_t s = 0; s < count; ++s) {
+                const double* delta = deltas + s * size_;
+                const double scaled = alpha_ * delta[i];
+                for (std::size_t j = j0; j < je; ++j) {
+                    row[j] = decay * row[j] + scaled * delta[j];
+                }
+            }
+        }
+    }
+
+    void update_blocked(const double* deltas, std::size_t count) noexcept {
+        for (std::size_t ib = 0; ib < size_; ib += BLOCK) {
+            const std::size_t ie = std::min(ib + BLOCK, size_);
+            for (std::size_t jb = ib; jb < size_; jb += BLOCK) {
+                update_tile(deltas, count, ib, ie, jb, std::min(jb + BLOCK, size_));
+            }
+        }
+    }
+
+public:
+    EMACovarianceMatrix(std::size_t n, double alpha)
+        : size_(n)
+        , stride_((n + 7) / 8 * 8)
+        , alpha_(alpha)
+        , mean_(n)
+        , cov_(n * stride_) {
+        if (n == 0) throw std::invalid_argument("Covariance matrix needs at least one series");
+        if (!(alpha > 0.0 && alpha <= 1.0)) throw std::invalid_argument("EMA alpha must be in (0, 1]");
+    }
+
+    // Same smoothing as EMACovar(window)
+    EMACovarianceMatrix(std::size_t n, std::size_t window)
+        : EMACovarianceMatrix(n, 2.0 / (static_cast<double>(window) + 1.0)) {}
+
+    // values[i] is the new observation of series i, for every series
+    void update(const double* values) {
+        update_batch(values, 1);
+    }
+
+    // count snapshots, row-major (snapshot s is values + s * size()), applied
+    // in order; same result as count calls to update()
+    void update_batch(const double* values, std::size_t count) {
+        if (count == 0) return;
+        if (observations_ == 0) {
+            // First snapshot seeds the means, like EMACovar
+            std::copy(values, values + size_, mean_.data());
+            cov_.fill(0.0);
+            observations_ = 1;
+            values += size_;
+            --count;
+            if (count == 0) return;
+        }
+
+        deltas_.resize(count * size_);
+        for (std::size_t s = 0; s < count; ++s) {
+            advance_means(values + s * size_, deltas_.data() + s * size_);
+        }
+        update_blocked(deltas_.data(), count);
+        observations_ += count;
+    }
+
+    void reset() noexcept {
+        mean_.fill(0.0);
+        cov_.fill(0.0);
+        observations_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] double alpha() const noexcept { return alpha_; }
+    [[nodiscard]] uint64_t observations() const noexcept { return observations_; }
+    [[nodiscard]] bool is_initialized() const noexcept { return observations_ > 0; }
+    [[nodiscard]] std::size_t pair_count() const noexcept { return size_ * (size_ - 1) / 2; }
+
+    [[nodiscard]] double mean(std::size_t i) const noexcept {
+        assert(i < size_);
+        return mean_[i];
+    }
+
+    [[nodiscard]] double covariance(std::size_t i, std::size_t j) const noexcept {
+        assert(i < size_ && j < size_);
+        return i <= j ? cov_[i * stride_ + j] : cov_[j * stride_ + i];
+    }
+
+    [[nodiscard]] double variance(std::size_t i) const noexcept { return covariance(i, i); }
+
+    [[nodiscard]] double correlation(std::size_t i, std::size_t j) const noexcept {
+        const double var_i = variance(i);
+        const double var_j = variance(j);
+        if (var_i <= 0.0 || var_j <= 0.0) return 0.0;
+        return covariance(i, j) / std::sqrt(var_i * var_j);
+    }
+
+    // The k pairs decorrelating the most. Without a reference, the k lowest
+    // |correlation|; with one (same series, typically a longer window), the k
+    // largest drops |reference| - |correlation|, so pairs that were never
+    // correlated don't crowd out ones that just broke. Series with zero
+    // variance in either matrix are skipped. Best first. O(n^2 log k).
+    [[nodiscard]] std::vector<MatrixPair> top_decorrelating(std::size_t k,
+                                                           const EMACovarianceMatrix* reference = nullptr) const {
+        if (reference && reference->size() != size_) {
+            throw std::invalid_argument("Reference matrix covers a different number of series");
+        }
+
+        // 1/sd per series, 0 where undefined
+        std::vector<double> inv_sd(size_), ref_inv_sd(reference ? size_ : 0);
+        for (std::size_t i = 0; i < size_; ++i) {
+            const double var = variance(i);
+            inv_sd[i] = var > 0.0 ? 1.0 / std::sqrt(var) : 0.0;
+            if (reference) {
+                const double ref_var = reference->variance(i);
+                ref_inv_sd[i] = ref_var > 0.0 ? 1.0 / std::sqrt(ref_var) : 0.0;
+            }
+        }
+
+        struct Scored {
+            double score;
+            MatrixPair pair;
+        };
+        // Min-heap on score holding the best k so far
+        const auto worse = [](const Scored& a, const Scored& b) { return a.score > b.score; };
+        if (k == 0) return {};
+        std::vector<Scored> heap;
+        heap.reserve(k + 1);
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (inv_sd[i] == 0.0 || (reference && ref_inv_sd[i] == 0.0)) continue;
+            const double* row = cov_.data() + i * stride_;
+            const double* ref_row = reference ? reference->cov_.data() + i * stride_ : nullptr;
+            for (std::size_t j = i + 1; j < size_; ++j) {
+                if (inv_sd[j] == 0.0) continue;
+                const double corr = row[j] * inv_sd[i] * inv_sd[j];
+                double ref_corr = 0.0;
+                double score = -std::abs(corr);
+                if (reference) {
+                    if (ref_inv_sd[j] == 0.0) continue;
+                    ref_corr = ref_row[j] * ref_inv_sd[i] * ref_inv_sd[j];
+                    score = std::abs(ref_corr) - std::abs(corr);
+                }
+                if (heap.size() == k && score <= heap.front().score) continue;
+                heap.push_back({score, {static_cast<uint32_t>(i), static_cast<uint32_t>(j), corr, ref_corr}});
+                std::push_heap(heap.begin(), heap.end(), worse);
+                if (heap.size() > k) {
+                    std::pop_heap(heap.begin(), heap.end(), worse);
+                    heap.pop_back();
+                }
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end(), worse);
+        std::vector<MatrixPair> result;
+        result.reserve(heap.size());
+        for (const Scored& scored : heap) result.push_back(scored.pair);
+        return result;
+    }
+};
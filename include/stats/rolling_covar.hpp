@@ -1,7 +1,9 @@
 #pragma once
 #include "stats/rolling_stats.hpp"
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
+#include <utility>
 
 // Online covariance computation using parallel to Welford's algorithm
 class RollingCovar {
@@ -101,6 +103,33 @@ public:
                std::isfinite(mean_x_) && std::isfinite(mean_y_) &&
                std::isfinite(c_) && std::isfinite(m2_x_) && std::isfinite(m2_y_);
     }
+
+    // State as if every pair had been added as (y, x)
+    void swap_legs() noexcept {
+        std::swap(mean_x_, mean_y_);
+        std::swap(m2_x_, m2_y_);
+    }
+
+    // Checkpoint state (engine/checkpoint.hpp)
+    template <typename Out>
+    void save(Out& out) const {
+        out.put(mean_x_);
+        out.put(mean_y_);
+        out.put(c_);
+        out.put(m2_x_);
+        out.put(m2_y_);
+        out.put(static_cast<uint64_t>(count_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        mean_x_ = in.template get<double>();
+        mean_y_ = in.template get<double>();
+        c_ = in.template get<double>();
+        m2_x_ = in.template get<double>();
+        m2_y_ = in.template get<double>();
+        count_ = static_cast<std::size_t>(in.template get<uint64_t>());
+    }
 };
 
 // EMA-based covariance for faster decay
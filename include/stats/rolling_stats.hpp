@@ -1,8 +1,13 @@
 #pragma once
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 // Numerically stable online statistics using Welford's algorithm
 class RollingStats {
@@ -68,6 +73,21 @@ public:
     [[nodiscard]] bool is_valid() const noexcept {
         return count_ > 0 && std::isfinite(mean_) && std::isfinite(m2_);
     }
+
+    // Checkpoint state (engine/checkpoint.hpp)
+    template <typename Out>
+    void save(Out& out) const {
+        out.put(mean_);
+        out.put(m2_);
+        out.put(static_cast<uint64_t>(count_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        mean_ = in.template get<double>();
+        m2_ = in.template get<double>();
+        count_ = static_cast<std::size_t>(in.template get<uint64_t>());
+    }
 };
 
 // Exponential Moving Average version for fixed-decay rolling statistics
@@ -115,6 +135,194 @@ public:
     }
 
     [[nodiscard]] bool is_initialized() const noexcept { return initialized_; }
+
+    // Checkpoint state (engine/checkpoint.hpp); alpha stays as configured
+    template <typename Out>
+    void save(Out& out) const {
+        out.put(mean_);
+        out.put(var_);
+        out.put(static_cast<uint8_t>(initialized_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        mean_ = in.template get<double>();
+        var_ = in.template get<double>();
+        initialized_ = in.template get<uint8_t>() != 0;
+    }
+};
+
+// Mean and sum of squared deviations over a window, updated in O(1) per value.
+// Filling uses Welford's update; once full, the evicted value is replaced in
+// a single step, which stays accurate where sum/sum-of-squares cancels badly
+// (e.g. prices around 1e6 with cent-level moves).
+class WindowMoments {
+private:
+    double mean_{0.0};
+    double m2_{0.0};
+    std::size_t count_{0};
+
+public:
+    void add(double value) noexcept {
+        count_++;
+        const double delta = value - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (value - mean_);
+    }
+
+    // Swap evicted for value, keeping count
+    void replace(double evicted, double value) noexcept {
+        const double delta = value - evicted;
+        const double old_mean = mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * ((value - mean_) + (evicted - old_mean));
+        if (m2_ < 0.0) m2_ = 0.0; // Rounding on a flat window
+    }
+
+    void reset() noexcept {
+        mean_ = 0.0;
+        m2_ = 0.0;
+        count_ = 0;
+    }
+
+    [[nodiscard]] double mean() const noexcept { return mean_; }
+    [[nodiscard]] double m2() const noexcept { return m2_; }
+    [[nodiscard]] std::size_t count() const noexcept { return count_; }
+
+    [[nodiscard]] double variance() const noexcept {
+        return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+    }
+
+    template <typename Out>
+    void save(Out& out) const {
+        out.put(mean_);
+        out.put(m2_);
+        out.put(static_cast<uint64_t>(count_));
+    }
+
+    template <typename In>
+    void load(In& in) {
+        mean_ = in.template get<double>();
+        m2_ = in.template get<double>();
+        count_ = static_cast<std::size_t>(in.template get<uint64_t>());
+    }
+};
+
+// Rolling statistics over the last window values, sized at runtime. The
+// window either owns its buffer or lives in caller-provided storage (e.g. an
+// Arena block next to the rest of a symbol's state), which must outlive it.
+class SlidingWindowStats {
+private:
+    std::unique_ptr<double[]> owned_;
+    double* buffer_;
+    std::size_t window_;
+    std::size_t index_{0};
+    WindowMoments moments_;
+
+public:
+    explicit SlidingWindowStats(std::size_t window)
+        : owned_(window > 0 ? std::make_unique<double[]>(window) : nullptr)
+        , buffer_(owned_.get())
+        , window_(window) {
+        if (window == 0) {
+            throw std::invalid_argument("SlidingWindowStats window must be positive");
+        }
+    }
+
+    explicit SlidingWindowStats(std::span<double> storage)
+        : buffer_(storage.data())
+        , window_(storage.size()) {
+        if (window_ == 0) {
+            throw std::invalid_argument("SlidingWindowStats window must be positive");
+        }
+        std::fill_n(buffer_, window_, 0.0);
+    }
+
+    // Copies always own their buffer; moves keep the source's storage
+    SlidingWindowStats(const SlidingWindowStats& other)
+        : owned_(std::make_unique<double[]>(other.window_))
+        , buffer_(owned_.get())
+        , window_(other.window_)
+        , index_(other.index_)
+        , moments_(other.moments_) {
+        std::copy_n(other.buffer_, window_, buffer_);
+    }
+
+    SlidingWindowStats& operator=(const SlidingWindowStats& other) {
+        if (this != &other) *this = SlidingWindowStats(other);
+        return *this;
+    }
+
+    SlidingWindowStats(SlidingWindowStats&&) noexcept = default;
+    SlidingWindowStats& operator=(SlidingWindowStats&&) noexcept = default;
+
+    void add(double value) noexcept {
+        if (moments_.count() < window_) {
+            moments_.add(value);
+        } else {
+            moments_.replace(buffer_[index_], value);
+        }
+        buffer_[index_] = value;
+        if (++index_ == window_) index_ = 0;
+    }
+
+    void reset() noexcept {
+        std::fill_n(buffer_, window_, 0.0);
+        index_ = 0;
+        moments_.reset();
+    }
+
+    [[nodiscard]] double mean() const noexcept { return moments_.mean(); }
+    [[nodiscard]] double variance() const noexcept { return moments_.variance(); }
+
+    [[nodiscard]] double std_dev() const noexcept {
+        return std::sqrt(variance());
+    }
+
+    [[nodiscard]] double z_score(double value) const noexcept {
+        const double sd = std_dev();
+        return (sd > 0.0) ? (value - mean()) / sd : 0.0;
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept { return moments_.count(); }
+    [[nodiscard]] std::size_t window() const noexcept { return window_; }
+    [[nodiscard]] bool is_full() const noexcept { return count() >= window_; }
+
+    // Checkpoint: window size, moments, then the values oldest first
+    template <typename Out>
+    void save(Out& out) const {
+        out.put(static_cast<uint64_t>(window_));
+        moments_.save(out);
+        const std::size_t n = count();
+        const std::size_t oldest = n < window_ ? 0 : index_;
+        for (std::size_t i = 0; i < n; ++i) {
+            out.put(buffer_[(oldest + i) % window_]);
+        }
+    }
+
+    // Same window: exact restore. Otherwise the newest values that fit are
+    // re-added, so a resized window starts from the recent past.
+    template <typename In>
+    void load(In& in) {
+        const auto saved_window = static_cast<std::size_t>(in.template get<uint64_t>());
+        WindowMoments saved;
+        saved.load(in);
+        const std::size_t n = saved.count();
+        if (n > saved_window) throw std::runtime_error("Checkpoint window holds more values than its size");
+
+        reset();
+        if (saved_window == window_) {
+            for (std::size_t i = 0; i < n; ++i) buffer_[i] = in.template get<double>();
+            index_ = n % window_;
+            moments_ = saved;
+            return;
+        }
+        const std::size_t skip = n > window_ ? n - window_ : 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double value = in.template get<double>();
+            if (i >= skip) add(value);
+        }
+    }
 };
 
 // Fixed-window rolling statistics with circular buffer
@@ -125,59 +333,29 @@ private:
 
     double buffer_[WindowSize];
     std::size_t index_{0};
-    std::size_t count_{0};
-    double sum_{0.0};
-    double sum_sq_{0.0};
-
-    void update_sums() noexcept {
-        sum_ = 0.0;
-        sum_sq_ = 0.0;
-        const std::size_t n = std::min(count_, WindowSize);
-        for (std::size_t i = 0; i < n; ++i) {
-            const double val = buffer_[i];
-            sum_ += val;
-            sum_sq_ += val * val;
-        }
-    }
+    WindowMoments moments_;
 
 public:
     WindowedStats() { std::fill(buffer_, buffer_ + WindowSize, 0.0); }
 
     void add(double value) noexcept {
-        if (count_ >= WindowSize) {
-            // Remove old value from sums
-            const double old_val = buffer_[index_];
-            sum_ -= old_val;
-            sum_sq_ -= old_val * old_val;
+        if (moments_.count() < WindowSize) {
+            moments_.add(value);
+        } else {
+            moments_.replace(buffer_[index_], value);
         }
-
-        // Add new value
         buffer_[index_] = value;
-        sum_ += value;
-        sum_sq_ += value * value;
-
         index_ = (index_ + 1) % WindowSize;
-        if (count_ < WindowSize) count_++;
     }
 
     void reset() noexcept {
         std::fill(buffer_, buffer_ + WindowSize, 0.0);
         index_ = 0;
-        count_ = 0;
-        sum_ = 0.0;
-        sum_sq_ = 0.0;
+        moments_.reset();
     }
 
-    [[nodiscard]] double mean() const noexcept {
-        return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0;
-    }
-
-    [[nodiscard]] double variance() const noexcept {
-        if (count_ <= 1) return 0.0;
-        const double n = static_cast<double>(count_);
-        const double mean_val = mean();
-        return (sum_sq_ - n * mean_val * mean_val) / (n - 1.0);
-    }
+    [[nodiscard]] double mean() const noexcept { return moments_.mean(); }
+    [[nodiscard]] double variance() const noexcept { return moments_.variance(); }
 
     [[nodiscard]] double std_dev() const noexcept {
         return std::sqrt(variance());
@@ -188,6 +366,6 @@ public:
         return (sd > 0.0) ? (value - mean()) / sd : 0.0;
     }
 
-    [[nodiscard]] std::size_t count() const noexcept { return count_; }
-    [[nodiscard]] bool is_full() const noexcept { return count_ >= WindowSize; }
-};
\ No newline at end of file
+    [[nodiscard]] std::size_t count() const noexcept { return moments_.count(); }
+    [[nodiscard]] bool is_full() const noexcept { return moments_.count() >= WindowSize; }
+};
@@ -0,0 +1,228 @@
+#pragma once
+#include "util/aligned_buffer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(RT_NO_SIMD) && defined(__AVX512F__)
+#include <immintrin.h>
+#define RT_SOA_AVX512 1
+#elif !defined(RT_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define RT_SOA_AVX2 1
+#elif !defined(RT_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define RT_SOA_NEON 1
+#endif
+
+// Welford statistics (same results as RollingStats) for many symbols at once,
+// stored as structure-of-arrays and indexed by symbol id.
+//
+// update_all() takes one value per symbol, the shape FeedSimulator produces
+// every step, and advances each vector register's worth of symbols together.
+// scan_zscore() then tests every symbol against the threshold in one pass.
+// The instruction set is picked at compile time (AVX-512, AVX2, NEON, or
+// scalar with RT_NO_SIMD).
+class SoAStats {
+public:
+#if defined(RT_SOA_AVX512)
+    static constexpr std::size_t LANES = 8;
+#elif defined(RT_SOA_AVX2)
+    static constexpr std::size_t LANES = 4;
+#elif defined(RT_SOA_NEON)
+    static constexpr std::size_t LANES = 2;
+#else
+    static constexpr std::size_t LANES = 1;
+#endif
+
+private:
+    std::size_t size_;
+    AlignedBuffer<double> mean_;
+    AlignedBuffer<double> m2_;
+    AlignedBuffer<double> count_; // Kept as double so it vectorizes with the rest
+
+    void update_one(std::size_t i, double value) noexcept {
+        const double n = count_[i] + 1.0;
+        const double delta = value - mean_[i];
+        const double mean = mean_[i] + delta / n;
+        count_[i] = n;
+        mean_[i] = mean;
+        m2_[i] += delta * (value - mean);
+    }
+
+public:
+    explicit SoAStats(std::size_t num_symbols)
+        : size_(num_symbols)
+        , mean_(num_symbols)
+        , m2_(num_symbols)
+        , count_(num_symbols) {}
+
+    // values[i] is the new observation for symbol i, for every symbol
+    void update_all(const double* values) noexcept {
+        std::size_t i = 0;
+        [[maybe_unused]] const std::size_t vector_end = size_ - size_ % LANES;
+        double* mean = mean_.data();
+        double* m2 = m2_.data();
+        double* count = count_.data();
+#if defined(RT_SOA_AVX512)
+        const __m512d one = _mm512_set1_pd(1.0);
+        for (; i < vector_end; i += LANES) {
+            const __m512d x = _mm512_loadu_pd(values + i);
+            const __m512d n = _mm512_add_pd(_mm512_load_pd(count + i), one);
+            const __m512d mu = _mm512_load_pd(mean + i);
+            const __m512d delta = _mm512_sub_pd(x, mu);
+            const __m512d mu_new = _mm512_add_pd(mu, _mm512_div_pd(delta, n));
+            const __m512d m2_new = _mm512_fmadd_pd(delta, _mm512_sub_pd(x, mu_new),
+                                                   _mm512_load_pd(m2 + i));
+            _mm512_store_pd(count + i, n);
+            _mm512_store_pd(mean + i, mu_new);
+            _mm512_store_pd(m2 + i, m2_new);
+        }
+#elif defined(RT_SOA_AVX2)
+        const __m256d one = _mm256_set1_pd(1.0);
+        for (; i < vector_end; i += LANES) {
+            const __m256d x = _mm256_loadu_pd(values + i);
+            const __m256d n = _mm256_add_pd(_mm256_load_pd(count + i), one);
+            const __m256d mu = _mm256_load_pd(mean + i);
+            const __m256d delta = _mm256_sub_pd(x, mu);
+            const __m256d mu_new = _mm256_add_pd(mu, _mm256_div_pd(delta, n));
+            const __m256d m2_new = _mm256_add_pd(_mm256_load_pd(m2 + i),
+                                                 _mm256_mul_pd(delta, _mm256_sub_pd(x, mu_new)));
+            _mm256_store_pd(count + i, n);
+            _mm256_store_pd(mean + i, mu_new);
+            _mm256_store_pd(m2 + i, m2_new);
+        }
+#elif defined(RT_SOA_NEON)
+        const float64x2_t one = vdupq_n_f64(1.0);
+        for (; i < vector_end; i += LANES) {
+            const float64x2_t x = vld1q_f64(values + i);
+            const float64x2_t n = vaddq_f64(vld1q_f64(count + i), one);
+            const float64x2_t mu = vld1q_f64(mean + i);
+            const float64x2_t delta = vsubq_f64(x, mu);
+            const float64x2_t mu_new = vaddq_f64(mu, vdivq_f64(delta, n));
+            const float64x2_t m2_new = vfmaq_f64(vld1q_f64(m2 + i), delta, vsubq_f64(x, mu_new));
+            vst1q_f64(count + i, n);
+            vst1q_f64(mean + i, mu_new);
+            vst1q_f64(m2 + i, m2_new);
+        }
+#endif
+        for (; i < size_; ++i) {
+            update_one(i, values[i]);
+        }
+    }
+
+    // Sparse batch: values[k] is a new observation for symbol ids[k]. Ids may
+    // repeat, so this stays scalar (a vector scatter would lose updates).
+    void update(const uint32_t* ids, const double* values, std::size_t n) noexcept {
+        for (std::size_t k = 0; k < n; ++k) {
+            assert(ids[k] < size_);
+            update_one(ids[k], values[k]);
+        }
+    }
+
+    // Write the id of every symbol whose |z-score| of values[id] reaches
+    // threshold into out (room for size() ids); returns how many were written.
+    // Symbols with fewer than min_count observations never qualify.
+    std::size_t scan_zscore(const double* values, double threshold, std::size_t min_count,
+                            uint32_t* out) const noexcept {
+        std::size_t hits = 0;
+        std::size_t i = 0;
+        [[maybe_unused]] const std::size_t vector_end = size_ - size_ % LANES;
+        const double min_n = std::max(static_cast<double>(min_count), 2.0);
+        const double* mean = mean_.data();
+        const double* m2 = m2_.data();
+        const double* count = count_.data();
+        // |x - mean| >= threshold * sd, compared squared to skip the sqrt and
+        // divide: (x - mean)^2 * (n - 1) >= threshold^2 * m2, with m2 > 0
+        const double threshold_sq = threshold * threshold;
+#if defined(RT_SOA_AVX512)
+        const __m512d t2 = _mm512_set1_pd(threshold_sq);
+        const __m512d vmin = _mm512_set1_pd(min_n);
+        const __m512d one = _mm512_set1_pd(1.0);
+        const __m512d zero = _mm512_setzero_pd();
+        for (; i < vector_end; i += LANES) {
+            const __m512d n = _mm512_load_pd(count + i);
+            const __m512d v = _mm512_load_pd(m2 + i);
+            const __m512d d = _mm512_sub_pd(_mm512_loadu_pd(values + i), _mm512_load_pd(mean + i));
+            const __m512d lhs = _mm512_mul_pd(_mm512_mul_pd(d, d), _mm512_sub_pd(n, one));
+            __mmask8 mask = _mm512_cmp_pd_mask(lhs, _mm512_mul_pd(t2, v), _CMP_GE_OQ);
+            mask &= _mm512_cmp_pd_mask(n, vmin, _CMP_GE_OQ);
+            mask &= _mm512_cmp_pd_mask(v, zero, _CMP_GT_OQ);
+            for (unsigned bits = mask; bits != 0; bits &= bits - 1) {
+                out[hits++] = static_cast<uint32_t>(i + static_cast<std::size_t>(__builtin_ctz(bits)));
+            }
+        }
+#elif defined(RT_SOA_AVX2)
+        const __m256d t2 = _mm256_set1_pd(threshold_sq);
+        const __m256d vmin = _mm256_set1_pd(min_n);
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d zero = _mm256_setzero_pd();
+        for (; i < vector_end; i += LANES) {
+            const __m256d n = _mm256_load_pd(count + i);
+            const __m256d v = _mm256_load_pd(m2 + i);
+            const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(values + i), _mm256_load_pd(mean + i));
+            const __m256d lhs = _mm256_mul_pd(_mm256_mul_pd(d, d), _mm256_sub_pd(n, one));
+            __m256d pass = _mm256_cmp_pd(lhs, _mm256_mul_pd(t2, v), _CMP_GE_OQ);
+            pass = _mm256_and_pd(pass, _mm256_cmp_pd(n, vmin, _CMP_GE_OQ));
+            pass = _mm256_and_pd(pass, _mm256_cmp_pd(v, zero, _CMP_GT_OQ));
+            for (unsigned bits = static_cast<unsigned>(_mm256_movemask_pd(pass)); bits != 0; bits &= bits - 1) {
+                out[hits++] = static_cast<uint32_t>(i + static_cast<std::size_t>(__builtin_ctz(bits)));
+            }
+        }
+#elif defined(RT_SOA_NEON)
+        const float64x2_t t2 = vdupq_n_f64(threshold_sq);
+        const float64x2_t vmin = vdupq_n_f64(min_n);
+        const float64x2_t one = vdupq_n_f64(1.0);
+        const float64x2_t zero = vdupq_n_f64(0.0);
+        for (; i < vector_end; i += LANES) {
+            const float64x2_t n = vld1q_f64(count + i);
+            const float64x2_t v = vld1q_f64(m2 + i);
+            const float64x2_t d = vsubq_f64(vld1q_f64(values + i), vld1q_f64(mean + i));
+            const float64x2_t lhs = vmulq_f64(vmulq_f64(d, d), vsubq_f64(n, one));
+            uint64x2_t pass = vcgeq_f64(lhs, vmulq_f64(t2, v));
+            pass = vandq_u64(pass, vcgeq_f64(n, vmin));
+            pass = vandq_u64(pass, vcgtq_f64(v, zero));
+            if (vgetq_lane_u64(pass, 0)) out[hits++] = static_cast<uint32_t>(i);
+            if (vgetq_lane_u64(pass, 1)) out[hits++] = static_cast<uint32_t>(i + 1);
+        }
+#endif
+        for (; i < size_; ++i) {
+            const double n = count[i];
+            const double d = values[i] - mean[i];
+            if (n >= min_n && m2[i] > 0.0 && d * d * (n - 1.0) >= threshold_sq * m2[i]) {
+                out[hits++] = static_cast<uint32_t>(i);
+            }
+        }
+        return hits;
+    }
+
+    void reset() noexcept {
+        mean_.fill(0.0);
+        m2_.fill(0.0);
+        count_.fill(0.0);
+    }
+
+    // Per-symbol accessors
+    [[nodiscard]] double mean(std::size_t i) const noexcept { return mean_[i]; }
+
+    [[nodiscard]] std::size_t count(std::size_t i) const noexcept {
+        return static_cast<std::size_t>(count_[i]);
+    }
+
+    [[nodiscard]] double variance(std::size_t i) const noexcept {
+        return count_[i] > 1.0 ? m2_[i] / (count_[i] - 1.0) : 0.0;
+    }
+
+    [[nodiscard]] double std_dev(std::size_t i) const noexcept {
+        return std::sqrt(variance(i));
+    }
+
+    [[nodiscard]] double z_score(std::size_t i, double value) const noexcept {
+        const double sd = std_dev(i);
+        return (sd > 0.0) ? (value - mean_[i]) / sd : 0.0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
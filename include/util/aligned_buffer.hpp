@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Fixed-size heap array aligned for vector loads (64 bytes = one cache line,
+// one AVX-512 register). Capacity is padded to a whole number of alignment
+// blocks so SIMD loops may read the tail without bounds checks.
+template <typename T, std::size_t Alignment = 64>
+class AlignedBuffer {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "AlignedBuffer holds plain data only");
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two no smaller than alignof(T)");
+
+    struct Deleter {
+        void operator()(T* ptr) const noexcept {
+            ::operator delete[](ptr, std::align_val_t{Alignment});
+        }
+    };
+
+    static constexpr std::size_t PER_BLOCK = std::max<std::size_t>(1, Alignment / sizeof(T));
+
+    std::size_t size_{0};
+    std::size_t padded_size_{0};
+    std::unique_ptr<T[], Deleter> data_;
+
+public:
+    AlignedBuffer() = default;
+
+    explicit AlignedBuffer(std::size_t size, T fill = T{})
+        : size_(size)
+        , padded_size_((size + PER_BLOCK - 1) / PER_BLOCK * PER_BLOCK)
+        , data_(static_cast<T*>(::operator new[](padded_size_ * sizeof(T),
+                                                 std::align_val_t{Alignment}))) {
+        std::fill_n(data_.get(), padded_size_, fill);
+    }
+
+    [[nodiscard]] T* data() noexcept { return data_.get(); }
+    [[nodiscard]] const T* data() const noexcept { return data_.get(); }
+
+    [[nodiscard]] T& operator[](std::size_t i) noexcept { return data_[i]; }
+    [[nodiscard]] const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t padded_size() const noexcept { return padded_size_; }
+
+    void fill(T value) noexcept { std::fill_n(data_.get(), padded_size_, value); }
+};
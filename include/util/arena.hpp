@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Bump allocator over large cache-line-aligned chunks. Addresses are stable
+// and nothing is returned until the arena is destroyed. The arena does not run
+// destructors: owners of non-trivial objects placed in it call std::destroy_at.
+//
+// reserve(bytes) makes the next bytes of allocation (alignment padding
+// included) come from memory already obtained, so long-lived state can be
+// sized up front and created later without touching the system allocator.
+class Arena {
+public:
+    static constexpr std::size_t CHUNK_ALIGNMENT = 64;
+    static constexpr std::size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+private:
+    struct Deleter {
+        void operator()(std::byte* ptr) const noexcept {
+            ::operator delete[](ptr, std::align_val_t{CHUNK_ALIGNMENT});
+        }
+    };
+
+    struct Chunk {
+        std::unique_ptr<std::byte[], Deleter> data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks_;
+    std::size_t chunk_bytes_;
+    std::size_t offset_{0};         // Into chunks_.back()
+    std::size_t bytes_used_{0};
+    std::size_t bytes_reserved_{0};
+
+public:
+    explicit Arena(std::size_t chunk_bytes = DEFAULT_CHUNK_BYTES)
+        : chunk_bytes_(std::max<std::size_t>(chunk_bytes, CHUNK_ALIGNMENT)) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+
+    // alignment must be a power of two no larger than CHUNK_ALIGNMENT
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::size_t aligned = align_up(offset_, alignment);
+        if (chunks_.empty() || aligned + bytes > chunks_.back().size) {
+            add_chunk(std::max(chunk_bytes_, bytes));
+            aligned = 0;
+        }
+        offset_ = aligned + bytes;
+        bytes_used_ += bytes;
+        return chunks_.back().data.get() + aligned;
+    }
+
+    template <typename T, typename... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        static_assert(alignof(T) <= CHUNK_ALIGNMENT, "Over-aligned type");
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Guarantee bytes of further allocation without a new chunk
+    void reserve(std::size_t bytes) {
+        if (available() < bytes) {
+            add_chunk(bytes);
+        }
+    }
+
+    [[nodiscard]] std::size_t available() const noexcept {
+        return chunks_.empty() ? 0 : chunks_.back().size - offset_;
+    }
+
+    [[nodiscard]] std::size_t bytes_used() const noexcept { return bytes_used_; }
+    [[nodiscard]] std::size_t bytes_reserved() const noexcept { return bytes_reserved_; }
+    [[nodiscard]] std::size_t chunk_count() const noexcept { return chunks_.size(); }
+
+    [[nodiscard]] static constexpr std::size_t align_up(std::size_t n, std::size_t alignment) noexcept {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+private:
+    void add_chunk(std::size_t bytes) {
+        bytes = align_up(bytes, CHUNK_ALIGNMENT);
+        std::unique_ptr<std::byte[], Deleter> data(
+            static_cast<std::byte*>(::operator new[](bytes, std::align_val_t{CHUNK_ALIGNMENT})));
+        chunks_.push_back({std::move(data), bytes});
+        offset_ = 0;
+        bytes_reserved_ += bytes;
+    }
+};
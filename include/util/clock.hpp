@@ -0,0 +1,193 @@
+#pragma once
+#include "util/seqlock.hpp"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RT_CYCLE_COUNTER_X86 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define RT_CYCLE_COUNTER_X86 1
+#elif defined(__aarch64__)
+#define RT_CYCLE_COUNTER_ARM64 1
+#endif
+
+// Raw cycle counter: rdtsc on x86, CNTVCT_EL0 on ARM64, steady_clock ns elsewhere.
+// Assumes an invariant TSC (constant rate, synchronized across cores), which
+// holds on every server CPU of the last decade.
+[[nodiscard]] inline uint64_t read_cycle_counter() noexcept {
+#if defined(RT_CYCLE_COUNTER_X86)
+    return __rdtsc();
+#elif defined(RT_CYCLE_COUNTER_ARM64)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Waits for earlier instructions to retire before reading, for the end of a
+// measured region
+[[nodiscard]] inline uint64_t read_cycle_counter_ordered() noexcept {
+#if defined(RT_CYCLE_COUNTER_X86)
+    unsigned int aux;
+    return __rdtscp(&aux);
+#elif defined(RT_CYCLE_COUNTER_ARM64)
+    uint64_t value;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(value) :: "memory");
+    return value;
+#else
+    return read_cycle_counter();
+#endif
+}
+
+// Chrono clock over the cycle counter. Readings are converted to nanoseconds
+// with a calibrated scale and share steady_clock's epoch, so the two clocks'
+// time points can be compared and converted (see convert_time_point) to
+// within the drift below.
+//
+// Drift: the two clocks are sampled together at each end of the calibration
+// window, each pair within READ_SKEW_NS or so, so the measured rate is off by
+// up to about 2 * READ_SKEW_NS / window. With the default 10ms window that is
+// ~4us of divergence per second since the last anchor, which a mixed
+// RT_TICK_CLOCK_STEADY / RT_SIGNAL_CLOCK_STEADY build sees directly in its
+// latencies. reanchor() re-measures the rate over the whole time since
+// calibrate() and moves the anchor to now, so calling it every second or so
+// keeps the clocks within a microsecond of each other once the process has
+// run for a few seconds. Each call may step now() by the drift it removes
+// (latency samples clamp the rare negative result to 0).
+//
+// Calibration runs once, lazily (about 10ms), on first use. Call calibrate()
+// at startup, before any latency-sensitive thread runs, to keep that cost out
+// of the hot path. calibrate() and reanchor() must come from one thread at a
+// time; readers on other threads see either the old or the new calibration.
+class CycleClock {
+public:
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<CycleClock>;
+    static constexpr bool is_steady = true;
+
+    static constexpr rep READ_SKEW_NS = 20;  // Typical gap between paired reads
+
+    [[nodiscard]] static time_point now() noexcept {
+        return from_cycles(read_cycle_counter());
+    }
+
+    [[nodiscard]] static time_point from_cycles(uint64_t cycles) noexcept {
+        const Calibration cal = calibration().load();
+        const double delta = static_cast<double>(static_cast<int64_t>(cycles - cal.base_cycles));
+        return time_point{duration{cal.base_ns + static_cast<rep>(delta * cal.ns_per_cycle)}};
+    }
+
+    [[nodiscard]] static double ns_per_cycle() noexcept {
+        return calibration().load().ns_per_cycle;
+    }
+
+    // Measure the counter rate against steady_clock over window
+    static void calibrate(std::chrono::milliseconds window = std::chrono::milliseconds(10)) {
+        calibration().store(measure(window));
+    }
+
+    // Re-measure the rate from calibrate()'s start to now and anchor the
+    // offset at now; cheap (a few clock reads), for a periodic housekeeping
+    // thread
+    static void reanchor() noexcept {
+        Calibration cal = calibration().load();
+        const Anchor now = sample();
+        if (now.cycles > cal.origin_cycles && now.ns > cal.origin_ns) {
+            cal.ns_per_cycle = static_cast<double>(now.ns - cal.origin_ns) /
+                               static_cast<double>(now.cycles - cal.origin_cycles);
+        }
+        cal.base_cycles = now.cycles;
+        cal.base_ns = now.ns;
+        calibration().store(cal);
+    }
+
+private:
+    struct Calibration {
+        uint64_t base_cycles{0};
+        rep base_ns{0};          // steady_clock ns at base_cycles
+        double ns_per_cycle{1.0};
+        uint64_t origin_cycles{0};  // Start of the first measurement, for reanchor()
+        rep origin_ns{0};
+    };
+
+    struct Anchor {
+        uint64_t cycles;
+        rep ns;
+    };
+
+    static SeqLock<Calibration>& calibration() noexcept {
+        static SeqLock<Calibration> cal(measure(std::chrono::milliseconds(10)));
+        return cal;
+    }
+
+    static rep steady_ns() noexcept {
+        return std::chrono::duration_cast<duration>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // steady_clock read bracketed by two counter reads; the tightest of a few
+    // tries, paired with the counter's midpoint
+    static Anchor sample() noexcept {
+        Anchor best{0, 0};
+        uint64_t best_gap = UINT64_MAX;
+        for (int i = 0; i < 8; ++i) {
+            const uint64_t before = read_cycle_counter();
+            const rep ns = steady_ns();
+            const uint64_t after = read_cycle_counter_ordered();
+            if (after - before < best_gap) {
+                best_gap = after - before;
+                best = {before + (after - before) / 2, ns};
+            }
+        }
+        return best;
+    }
+
+    static Calibration measure(std::chrono::milliseconds window) {
+        Calibration cal;
+        const Anchor start = sample();
+        std::this_thread::sleep_for(window);
+        const Anchor end = sample();
+
+        cal.base_cycles = end.cycles;
+        cal.base_ns = end.ns;
+        cal.origin_cycles = start.cycles;
+        cal.origin_ns = start.ns;
+        if (end.cycles > start.cycles && end.ns > start.ns) {
+            cal.ns_per_cycle = static_cast<double>(end.ns - start.ns) /
+                               static_cast<double>(end.cycles - start.cycles);
+        }
+        return cal;
+    }
+};
+
+// Re-express a time point on another clock sharing steady_clock's epoch
+// (steady_clock itself or CycleClock)
+template <typename ToClock, typename FromClock, typename Duration>
+[[nodiscard]] constexpr typename ToClock::time_point convert_time_point(
+    std::chrono::time_point<FromClock, Duration> tp) noexcept {
+    return typename ToClock::time_point{
+        std::chrono::duration_cast<typename ToClock::duration>(tp.time_since_epoch())};
+}
+
+// Clock behind each timestamp field. CycleClock is cheaper to read than
+// steady_clock (no vDSO call) and resolves below a nanosecond per cycle;
+// define RT_TICK_CLOCK_STEADY / RT_SIGNAL_CLOCK_STEADY to switch a field back.
+#if defined(RT_TICK_CLOCK_STEADY)
+using TickClock = std::chrono::steady_clock;
+#else
+using TickClock = CycleClock;
+#endif
+
+#if defined(RT_SIGNAL_CLOCK_STEADY)
+using SignalClock = std::chrono::steady_clock;
+#else
+using SignalClock = CycleClock;
+#endif
@@ -3,143 +3,410 @@
 #include <vector>
 #include <atomic>
 #include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <stdexcept>
+
+// Log-linear bucket layout (HdrHistogram-style) over nanosecond values.
+// Values are tracked with a relative error of at most 10^-significant_digits
+// from 1ns up to highest_trackable_ns; larger values clamp to the top bucket.
+class HdrLayout {
+private:
+    int significant_digits_;
+    uint64_t highest_trackable_;
+    uint32_t sub_bucket_half_count_magnitude_;
+    uint64_t sub_bucket_half_count_;
+    uint64_t sub_bucket_mask_;
+    std::size_t counts_len_;
+
+public:
+    HdrLayout(int significant_digits, uint64_t highest_trackable_ns) {
+        if (significant_digits < 1 || significant_digits > 5) {
+            throw std::invalid_argument("HdrLayout significant_digits must be in [1, 5]");
+        }
+        if (highest_trackable_ns < 2) {
+            throw std::invalid_argument("HdrLayout highest_trackable_ns must be >= 2");
+        }
+        significant_digits_ = significant_digits;
+        highest_trackable_ = highest_trackable_ns;
+
+        // Smallest power-of-two sub-bucket count giving the requested precision
+        uint64_t largest_single_unit = 2;
+        for (int i = 0; i < significant_digits; ++i) largest_single_unit *= 10;
+        const uint32_t sub_bucket_count_magnitude =
+            static_cast<uint32_t>(std::bit_width(largest_single_unit - 1));
+
+        sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude - 1;
+        const uint64_t sub_bucket_count = uint64_t{1} << sub_bucket_count_magnitude;
+        sub_bucket_half_count_ = sub_bucket_count / 2;
+        sub_bucket_mask_ = sub_bucket_count - 1;
+
+        // Each extra bucket doubles the covered range
+        uint64_t smallest_untrackable = sub_bucket_count;
+        std::size_t bucket_count = 1;
+        while (smallest_untrackable <= highest_trackable_) {
+            if (smallest_untrackable > (UINT64_MAX >> 1)) {
+                bucket_count++;
+                break;
+            }
+            smallest_untrackable <<= 1;
+            bucket_count++;
+        }
+        counts_len_ = (bucket_count + 1) * sub_bucket_half_count_;
+    }
+
+    [[nodiscard]] std::size_t counts_len() const noexcept { return counts_len_; }
+    [[nodiscard]] int significant_digits() const noexcept { return significant_digits_; }
+    [[nodiscard]] uint64_t highest_trackable() const noexcept { return highest_trackable_; }
+
+    [[nodiscard]] std::size_t index_of(uint64_t value) const noexcept {
+        if (value > highest_trackable_) value = highest_trackable_;
+        const auto pow2_ceiling = static_cast<uint32_t>(std::bit_width(value | sub_bucket_mask_));
+        const uint32_t bucket = pow2_ceiling - (sub_bucket_half_count_magnitude_ + 1);
+        const uint64_t sub_bucket = value >> bucket;
+        return (static_cast<std::size_t>(bucket + 1) << sub_bucket_half_count_magnitude_) +
+               static_cast<std::size_t>(sub_bucket - sub_bucket_half_count_);
+    }
+
+    // Lowest value that maps to counts index idx
+    [[nodiscard]] uint64_t lowest_at(std::size_t idx) const noexcept {
+        int bucket = static_cast<int>(idx >> sub_bucket_half_count_magnitude_) - 1;
+        uint64_t sub_bucket = (idx & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+        if (bucket < 0) {
+            sub_bucket -= sub_bucket_half_count_;
+            bucket = 0;
+        }
+        return sub_bucket << bucket;
+    }
+
+    // Highest value that maps to counts index idx
+    [[nodiscard]] uint64_t highest_at(std::size_t idx) const noexcept {
+        const int bucket = std::max(0, static_cast<int>(idx >> sub_bucket_half_count_magnitude_) - 1);
+        return lowest_at(idx) + (uint64_t{1} << bucket) - 1;
+    }
+
+    [[nodiscard]] bool operator==(const HdrLayout& other) const noexcept {
+        return significant_digits_ == other.significant_digits_ &&
+               highest_trackable_ == other.highest_trackable_;
+    }
+
+    // Value at percentile p (0..100) over counts read through count_at(idx).
+    // Reported as the bucket's highest equivalent value, clamped to [min, max].
+    template <typename CountAt>
+    [[nodiscard]] uint64_t percentile(CountAt&& count_at, uint64_t total,
+                                      uint64_t min_value, uint64_t max_value,
+                                      double p) const {
+        if (total == 0) return 0;
+        if (p <= 0.0) return min_value;
+        if (p >= 100.0) return max_value;
+
+        const auto target = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(total))));
+        uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < counts_len_; ++i) {
+            cumulative += count_at(i);
+            if (cumulative >= target) {
+                return std::clamp(highest_at(i), min_value, max_value);
+            }
+        }
+        return max_value;
+    }
+};
+
+// Plain copy of a histogram at one instant. Snapshots merge (across shards)
+// and subtract (interval views) without touching the live histogram.
+class HistogramSnapshot {
+private:
+    HdrLayout layout_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_samples_{0};
+    uint64_t total_latency_ns_{0};
+    uint64_t min_latency_ns_{UINT64_MAX};
+    uint64_t max_latency_ns_{0};
+
+    friend class LatencyHistogram;
+
+public:
+    explicit HistogramSnapshot(const HdrLayout& layout)
+        : layout_(layout)
+        , counts_(layout.counts_len(), 0) {}
+
+    [[nodiscard]] uint64_t total_samples() const noexcept { return total_samples_; }
+
+    [[nodiscard]] double mean_latency_ns() const noexcept {
+        return total_samples_ > 0
+            ? static_cast<double>(total_latency_ns_) / static_cast<double>(total_samples_) : 0.0;
+    }
+
+    [[nodiscard]] uint64_t min_latency_ns() const noexcept {
+        return min_latency_ns_ == UINT64_MAX ? 0 : min_latency_ns_;
+    }
+
+    [[nodiscard]] uint64_t max_latency_ns() const noexcept { return max_latency_ns_; }
+
+    [[nodiscard]] uint64_t percentile_ns(double p) const {
+        return layout_.percentile([this](std::size_t i) { return counts_[i]; },
+                                  total_samples_, min_latency_ns(), max_latency_ns_, p);
+    }
+
+    [[nodiscard]] double percentile_us(double p) const {
+        return static_cast<double>(percentile_ns(p)) / 1000.0;
+    }
+
+    [[nodiscard]] const HdrLayout& layout() const noexcept { return layout_; }
+    [[nodiscard]] const std::vector<uint64_t>& counts() const noexcept { return counts_; }
+
+    void merge(const HistogramSnapshot& other) {
+        if (!(layout_ == other.layout_)) {
+            throw std::invalid_argument("Cannot merge histogram snapshots with different layouts");
+        }
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_samples_ += other.total_samples_;
+        total_latency_ns_ += other.total_latency_ns_;
+        min_latency_ns_ = std::min(min_latency_ns_, other.min_latency_ns_);
+        max_latency_ns_ = std::max(max_latency_ns_, other.max_latency_ns_);
+    }
+
+    // Samples recorded between earlier and this snapshot. Interval min/max come
+    // from the lowest/highest non-empty bucket, so they carry bucket precision.
+    [[nodiscard]] HistogramSnapshot delta_since(const HistogramSnapshot& earlier) const {
+        if (!(layout_ == earlier.layout_)) {
+            throw std::invalid_argument("Cannot diff histogram snapshots with different layouts");
+        }
+        HistogramSnapshot delta(layout_);
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            const uint64_t count = counts_[i] - std::min(counts_[i], earlier.counts_[i]);
+            delta.counts_[i] = count;
+            if (count > 0) {
+                delta.min_latency_ns_ = std::min(delta.min_latency_ns_,
+                    std::max(layout_.lowest_at(i), min_latency_ns()));
+                delta.max_latency_ns_ = std::max(delta.max_latency_ns_,
+                    std::min(layout_.highest_at(i), max_latency_ns_));
+            }
+            delta.total_samples_ += count;
+        }
+        delta.total_latency_ns_ = total_latency_ns_ - std::min(total_latency_ns_, earlier.total_latency_ns_);
+        return delta;
+    }
+};
 
 // High-performance latency measurement and histogram
+// Nanosecond, log-linear buckets with exact min/max; safe for concurrent
+// writers and readers (all counters are relaxed atomics).
 class LatencyHistogram {
 private:
-    // Histogram buckets (in microseconds)
-    static constexpr std::size_t NUM_BUCKETS = 10;
-    static constexpr int BUCKET_EDGES[NUM_BUCKETS + 1] = {
-        0, 50, 100, 250, 500, 1000, 2000, 5000, 10000, 50000, 1000000
-    };
+    static constexpr int DEFAULT_SIGNIFICANT_DIGITS = 3;
+    static constexpr uint64_t DEFAULT_HIGHEST_TRACKABLE_NS = 60'000'000'000ull; // 60 s
 
-    std::atomic<uint64_t> buckets_[NUM_BUCKETS];
+    HdrLayout layout_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
     std::atomic<uint64_t> total_samples_{0};
-    std::atomic<uint64_t> total_latency_us_{0};
-    std::atomic<uint64_t> min_latency_us_{UINT64_MAX};
-    std::atomic<uint64_t> max_latency_us_{0};
+    std::atomic<uint64_t> total_latency_ns_{0};
+    std::atomic<uint64_t> min_latency_ns_{UINT64_MAX};
+    std::atomic<uint64_t> max_latency_ns_{0};
+
+    // For rate calculation: steady_clock nanoseconds of the first sample, 0
+    // until then. Atomic so reset() and readers on other threads don't race.
+    std::atomic<int64_t> start_ns_{0};
 
-    // For rate calculation
-    mutable std::chrono::steady_clock::time_point start_time_;
-    mutable std::atomic<bool> timing_started_{false};
+    [[nodiscard]] static int64_t steady_now_ns() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 
 public:
-    LatencyHistogram() {
+    explicit LatencyHistogram(int significant_digits = DEFAULT_SIGNIFICANT_DIGITS,
+                              uint64_t highest_trackable_ns = DEFAULT_HIGHEST_TRACKABLE_NS)
+        : layout_(significant_digits, highest_trackable_ns)
+        , counts_(std::make_unique<std::atomic<uint64_t>[]>(layout_.counts_len())) {
         reset();
     }
 
-    void add_sample(std::chrono::steady_clock::time_point start,
-                   std::chrono::steady_clock::time_point end) {
-        const auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+    template <typename Clock, typename Duration>
+    void add_sample(std::chrono::time_point<Clock, Duration> start,
+                    std::chrono::time_point<Clock, Duration> end) {
+        const auto latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
             end - start).count();
 
-        add_sample_us(static_cast<uint64_t>(latency_us));
+        add_sample_ns(latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0);
     }
 
     void add_sample_us(uint64_t latency_us) {
-        // Update timing for rate calculation
-        if (!timing_started_.exchange(true, std::memory_order_acq_rel)) {
-            start_time_ = std::chrono::steady_clock::now();
-        }
+        add_sample_ns(latency_us * 1000);
+    }
 
-        // Find appropriate bucket
-        std::size_t bucket = 0;
-        for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
-            if (latency_us < static_cast<uint64_t>(BUCKET_EDGES[i + 1])) {
-                bucket = i;
-                break;
-            }
+    void add_sample_ns(uint64_t latency_ns, uint64_t count = 1) {
+        // Update timing for rate calculation
+        if (start_ns_.load(std::memory_order_relaxed) == 0) {
+            int64_t unset = 0;
+            start_ns_.compare_exchange_strong(unset, steady_now_ns(), std::memory_order_relaxed);
         }
-        if (bucket >= NUM_BUCKETS) bucket = NUM_BUCKETS - 1;
 
         // Update atomically
-        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
-        total_samples_.fetch_add(1, std::memory_order_relaxed);
-        total_latency_us_.fetch_add(latency_us, std::memory_order_relaxed);
+        counts_[layout_.index_of(latency_ns)].fetch_add(count, std::memory_order_relaxed);
+        total_samples_.fetch_add(count, std::memory_order_relaxed);
+        total_latency_ns_.fetch_add(latency_ns * count, std::memory_order_relaxed);
 
         // Update min/max
-        uint64_t current_min = min_latency_us_.load(std::memory_order_relaxed);
-        while (latency_us < current_min &&
-               !min_latency_us_.compare_exchange_weak(current_min, latency_us,
+        uint64_t current_min = min_latency_ns_.load(std::memory_order_relaxed);
+        while (latency_ns < current_min &&
+               !min_latency_ns_.compare_exchange_weak(current_min, latency_ns,
+                                                     std::memory_order_relaxed)) {}
+
+        uint64_t current_max = max_latency_ns_.load(std::memory_order_relaxed);
+        while (latency_ns > current_max &&
+               !max_latency_ns_.compare_exchange_weak(current_max, latency_ns,
+                                                     std::memory_order_relaxed)) {}
+    }
+
+    // add_sample_ns() for a histogram with a single writing thread: relaxed
+    // load/store instead of locked read-modify-writes, readers still race-free
+    void add_sample_ns_exclusive(uint64_t latency_ns) noexcept {
+        if (start_ns_.load(std::memory_order_relaxed) == 0) {
+            start_ns_.store(steady_now_ns(), std::memory_order_relaxed);
+        }
+
+        auto& bucket = counts_[layout_.index_of(latency_ns)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_samples_.store(total_samples_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_latency_ns_.store(total_latency_ns_.load(std::memory_order_relaxed) + latency_ns,
+                                std::memory_order_relaxed);
+        if (latency_ns < min_latency_ns_.load(std::memory_order_relaxed)) {
+            min_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+        }
+        if (latency_ns > max_latency_ns_.load(std::memory_order_relaxed)) {
+            max_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+        }
+    }
+
+    // Fold another histogram's samples into this one (e.g. per-shard -> process-wide)
+    void merge_from(const LatencyHistogram& other) {
+        if (layout_ == other.layout_) {
+            for (std::size_t i = 0; i < layout_.counts_len(); ++i) {
+                const uint64_t count = other.counts_[i].load(std::memory_order_acquire);
+                if (count > 0) counts_[i].fetch_add(count, std::memory_order_relaxed);
+            }
+        } else {
+            // Re-bucket by each source bucket's highest equivalent value
+            for (std::size_t i = 0; i < other.layout_.counts_len(); ++i) {
+                const uint64_t count = other.counts_[i].load(std::memory_order_acquire);
+                if (count > 0) {
+                    counts_[layout_.index_of(other.layout_.highest_at(i))].fetch_add(
+                        count, std::memory_order_relaxed);
+                }
+            }
+        }
+        total_samples_.fetch_add(other.total_samples_.load(std::memory_order_acquire),
+                                 std::memory_order_relaxed);
+        total_latency_ns_.fetch_add(other.total_latency_ns_.load(std::memory_order_acquire),
+                                    std::memory_order_relaxed);
+
+        const uint64_t other_min = other.min_latency_ns_.load(std::memory_order_acquire);
+        uint64_t current_min = min_latency_ns_.load(std::memory_order_relaxed);
+        while (other_min < current_min &&
+               !min_latency_ns_.compare_exchange_weak(current_min, other_min,
                                                      std::memory_order_relaxed)) {}
 
-        uint64_t current_max = max_latency_us_.load(std::memory_order_relaxed);
-        while (latency_us > current_max &&
-               !max_latency_us_.compare_exchange_weak(current_max, latency_us,
+        const uint64_t other_max = other.max_latency_ns_.load(std::memory_order_acquire);
+        uint64_t current_max = max_latency_ns_.load(std::memory_order_relaxed);
+        while (other_max > current_max &&
+               !max_latency_ns_.compare_exchange_weak(current_max, other_max,
                                                      std::memory_order_relaxed)) {}
+
+        // Rate is measured from the earliest shard start
+        const int64_t other_start = other.start_ns_.load(std::memory_order_relaxed);
+        int64_t current_start = start_ns_.load(std::memory_order_relaxed);
+        while (other_start != 0 && (current_start == 0 || other_start < current_start) &&
+               !start_ns_.compare_exchange_weak(current_start, other_start, std::memory_order_relaxed)) {}
     }
 
     void reset() {
-        for (auto& bucket : buckets_) {
-            bucket.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < layout_.counts_len(); ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
         }
         total_samples_.store(0, std::memory_order_relaxed);
-        total_latency_us_.store(0, std::memory_order_relaxed);
-        min_latency_us_.store(UINT64_MAX, std::memory_order_relaxed);
-        max_latency_us_.store(0, std::memory_order_relaxed);
-        timing_started_.store(false, std::memory_order_relaxed);
+        total_latency_ns_.store(0, std::memory_order_relaxed);
+        min_latency_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+        max_latency_ns_.store(0, std::memory_order_relaxed);
+        start_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    // Consistent-enough copy for reporting; the live histogram keeps counting.
+    // Diff two snapshots for per-interval percentiles instead of calling reset().
+    [[nodiscard]] HistogramSnapshot snapshot() const {
+        HistogramSnapshot snap(layout_);
+        for (std::size_t i = 0; i < layout_.counts_len(); ++i) {
+            snap.counts_[i] = counts_[i].load(std::memory_order_acquire);
+            snap.total_samples_ += snap.counts_[i];
+        }
+        snap.total_latency_ns_ = total_latency_ns_.load(std::memory_order_acquire);
+        snap.min_latency_ns_ = min_latency_ns_.load(std::memory_order_acquire);
+        snap.max_latency_ns_ = max_latency_ns_.load(std::memory_order_acquire);
+        return snap;
     }
 
+    [[nodiscard]] const HdrLayout& layout() const noexcept { return layout_; }
+
     // Statistics
     [[nodiscard]] uint64_t total_samples() const {
         return total_samples_.load(std::memory_order_acquire);
     }
 
-    [[nodiscard]] double mean_latency_us() const {
+    [[nodiscard]] double mean_latency_ns() const {
         const uint64_t total = total_samples();
-        return total > 0 ? static_cast<double>(total_latency_us_.load(std::memory_order_acquire)) / total : 0.0;
+        return total > 0 ? static_cast<double>(total_latency_ns_.load(std::memory_order_acquire)) / total : 0.0;
     }
 
-    [[nodiscard]] uint64_t min_latency_us() const {
-        const uint64_t min_val = min_latency_us_.load(std::memory_order_acquire);
-        return min_val == UINT64_MAX ? 0 : min_val;
+    [[nodiscard]] double mean_latency_us() const {
+        return mean_latency_ns() / 1000.0;
     }
 
-    [[nodiscard]] uint64_t max_latency_us() const {
-        return max_latency_us_.load(std::memory_order_acquire);
+    [[nodiscard]] uint64_t min_latency_ns() const {
+        const uint64_t min_val = min_latency_ns_.load(std::memory_order_acquire);
+        return min_val == UINT64_MAX ? 0 : min_val;
     }
 
-    // Percentile calculation (approximate)
-    [[nodiscard]] double percentile_us(double p) const {
-        const uint64_t total = total_samples();
-        if (total == 0) return 0.0;
-
-        const uint64_t target_count = static_cast<uint64_t>(total * p / 100.0);
-        uint64_t cumulative = 0;
+    [[nodiscard]] uint64_t max_latency_ns() const {
+        return max_latency_ns_.load(std::memory_order_acquire);
+    }
 
-        for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
-            cumulative += buckets_[i].load(std::memory_order_acquire);
-            if (cumulative >= target_count) {
-                // Linear interpolation within bucket
-                const double bucket_start = BUCKET_EDGES[i];
-                const double bucket_end = BUCKET_EDGES[i + 1];
-                const uint64_t bucket_count = buckets_[i].load(std::memory_order_acquire);
+    [[nodiscard]] double min_latency_us() const {
+        return static_cast<double>(min_latency_ns()) / 1000.0;
+    }
 
-                if (bucket_count == 0) return bucket_start;
+    [[nodiscard]] double max_latency_us() const {
+        return static_cast<double>(max_latency_ns()) / 1000.0;
+    }
 
-                const uint64_t prev_cumulative = cumulative - bucket_count;
-                const double position = static_cast<double>(target_count - prev_cumulative) / bucket_count;
-                return bucket_start + position * (bucket_end - bucket_start);
-            }
-        }
+    // Percentile calculation (within the layout's relative precision)
+    [[nodiscard]] uint64_t percentile_ns(double p) const {
+        return layout_.percentile(
+            [this](std::size_t i) { return counts_[i].load(std::memory_order_acquire); },
+            total_samples(), min_latency_ns(), max_latency_ns(), p);
+    }
 
-        return BUCKET_EDGES[NUM_BUCKETS];
+    [[nodiscard]] double percentile_us(double p) const {
+        return static_cast<double>(percentile_ns(p)) / 1000.0;
     }
 
     [[nodiscard]] double p50_us() const { return percentile_us(50.0); }
     [[nodiscard]] double p95_us() const { return percentile_us(95.0); }
     [[nodiscard]] double p99_us() const { return percentile_us(99.0); }
+    [[nodiscard]] double p999_us() const { return percentile_us(99.9); }
+    [[nodiscard]] double p9999_us() const { return percentile_us(99.99); }
 
     // Throughput calculation
     [[nodiscard]] double sample_rate_per_second() const {
-        if (!timing_started_.load(std::memory_order_acquire)) return 0.0;
+        const int64_t start_ns = start_ns_.load(std::memory_order_relaxed);
+        if (start_ns == 0) return 0.0;
 
-        const auto now = std::chrono::steady_clock::now();
-        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-            now - start_time_).count();
+        const int64_t elapsed = (steady_now_ns() - start_ns) / 1000;  // Microseconds
 
         if (elapsed <= 0) return 0.0;
 
@@ -147,10 +414,10 @@ public:
         return static_cast<double>(total) * 1000000.0 / elapsed;
     }
 
-    // Histogram data for visualization
+    // Histogram data for visualization (non-empty buckets only)
     struct BucketInfo {
-        int lower_bound_us;
-        int upper_bound_us;
+        double lower_bound_us;
+        double upper_bound_us;
         uint64_t count;
         double percentage;
     };
@@ -159,13 +426,14 @@ public:
         std::vector<BucketInfo> result;
         const uint64_t total = total_samples();
 
-        for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
-            const uint64_t count = buckets_[i].load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < layout_.counts_len(); ++i) {
+            const uint64_t count = counts_[i].load(std::memory_order_acquire);
+            if (count == 0) continue;
             const double percentage = total > 0 ? static_cast<double>(count) * 100.0 / total : 0.0;
 
             result.push_back({
-                BUCKET_EDGES[i],
-                BUCKET_EDGES[i + 1],
+                static_cast<double>(layout_.lowest_at(i)) / 1000.0,
+                static_cast<double>(layout_.highest_at(i) + 1) / 1000.0,
                 count,
                 percentage
             });
@@ -174,30 +442,30 @@ public:
         return result;
     }
 
-    // Print histogram to stream
+    // Print percentile distribution to stream
     void print_histogram(std::ostream& os) const {
-        const auto histogram = get_histogram();
+        static constexpr double PERCENTILES[] = {
+            0.0, 25.0, 50.0, 75.0, 90.0, 95.0, 99.0, 99.9, 99.99, 100.0
+        };
         const uint64_t total = total_samples();
 
-        os << "Latency Histogram (total samples: " << total << ")\n";
-        os << "Range (μs)     | Count    | Percentage\n";
-        os << "---------------|----------|----------\n";
+        os << std::setfill(' ') << "Latency Histogram (total samples: " << total << ")\n";
+        os << "Percentile | Latency (μs)\n";
+        os << "-----------|-------------\n";
 
-        for (const auto& bucket : histogram) {
-            os << std::setw(6) << bucket.lower_bound_us << "-"
-               << std::setw(6) << bucket.upper_bound_us << " | "
-               << std::setw(8) << bucket.count << " | "
-               << std::setw(6) << std::fixed << std::setprecision(2)
-               << bucket.percentage << "%\n";
+        for (const double p : PERCENTILES) {
+            os << std::setw(9) << std::fixed << std::setprecision(2) << p << "% | "
+               << std::setw(12) << std::setprecision(3) << percentile_us(p) << "\n";
         }
 
         os << "\nStatistics:\n";
-        os << "  Mean: " << std::fixed << std::setprecision(1) << mean_latency_us() << " μs\n";
-        os << "  Min:  " << min_latency_us() << " μs\n";
-        os << "  Max:  " << max_latency_us() << " μs\n";
-        os << "  P50:  " << std::fixed << std::setprecision(1) << p50_us() << " μs\n";
-        os << "  P95:  " << std::fixed << std::setprecision(1) << p95_us() << " μs\n";
-        os << "  P99:  " << std::fixed << std::setprecision(1) << p99_us() << " μs\n";
+        os << "  Mean:   " << std::fixed << std::setprecision(3) << mean_latency_us() << " μs\n";
+        os << "  Min:    " << min_latency_us() << " μs\n";
+        os << "  Max:    " << max_latency_us() << " μs\n";
+        os << "  P50:    " << p50_us() << " μs\n";
+        os << "  P99:    " << p99_us() << " μs\n";
+        os << "  P99.9:  " << p999_us() << " μs\n";
+        os << "  P99.99: " << p9999_us() << " μs\n";
         os << "  Rate: " << std::fixed << std::setprecision(0) << sample_rate_per_second() << " samples/sec\n";
     }
-};
\ No newline at end of file
+};
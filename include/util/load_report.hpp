@@ -0,0 +1,160 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Results of one rt_loadtest load step, and the JSON report holding them.
+// The report is written one step per line so read_load_report() can stay a
+// line scanner rather than a JSON parser; it only reads reports it wrote.
+
+inline constexpr int LOAD_REPORT_VERSION = 1;
+
+struct LoadStepResult {
+    double offered_tps{0.0};      // Target rate
+    double achieved_tps{0.0};     // Ticks processed / (run + drain time)
+    double seconds{0.0};          // Run + drain time
+    uint64_t ticks_offered{0};
+    uint64_t ticks_processed{0};
+    uint64_t ticks_dropped{0};    // Queue full at push time
+    uint64_t signals{0};
+    uint64_t signals_dropped{0};  // Signal sink could not keep up
+    uint64_t queue_depth_p50{0};  // Upper bounds of power-of-two depth buckets
+    uint64_t queue_depth_p99{0};
+    uint64_t queue_depth_max{0};
+    uint64_t latency_p50_ns{0};   // Tick stamp at push to Router processing
+    uint64_t latency_p99_ns{0};
+    uint64_t latency_p999_ns{0};
+    uint64_t latency_max_ns{0};
+
+    [[nodiscard]] double drop_rate() const noexcept {
+        return ticks_offered > 0 ? static_cast<double>(ticks_dropped) / static_cast<double>(ticks_offered) : 0.0;
+    }
+};
+
+// How far a step may fall behind its baseline before it counts as a regression
+struct LoadTolerance {
+    double throughput{0.10};         // Achieved rate may drop by 10%
+    double latency{0.25};            // P99 may rise by 25%...
+    uint64_t latency_slack_ns{2000}; // ...plus this much, so microsecond P99s don't flap
+    double drop_rate{0.01};          // Drop rate may rise by one point
+};
+
+struct LoadRegression {
+    double offered_tps{0.0};
+    std::string metric;
+    double baseline{0.0};
+    double measured{0.0};
+};
+
+// label identifies the run (machine, commit) for whoever reads the report
+inline void write_load_report(std::ostream& out, const std::vector<LoadStepResult>& steps,
+                              const std::string& label) {
+    const auto precision = out.precision(12);
+    out << "{\n  \"report\": \"rt_loadtest\",\n  \"version\": " << LOAD_REPORT_VERSION << ",\n  \"label\": \"";
+    for (const char c : label) {
+        if (c == '"' || c == '\\') out << '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out << c;  // Control characters are dropped
+    }
+    out << "\",\n  \"steps\": [\n";
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        const LoadStepResult& s = steps[i];
+        out << "    {\"offered_tps\": " << s.offered_tps << ", \"achieved_tps\": " << s.achieved_tps
+            << ", \"seconds\": " << s.seconds << ", \"ticks_offered\": " << s.ticks_offered
+            << ", \"ticks_processed\": " << s.ticks_processed << ", \"ticks_dropped\": " << s.ticks_dropped
+            << ", \"drop_rate\": " << s.drop_rate() << ", \"signals\": " << s.signals
+            << ", \"signals_dropped\": " << s.signals_dropped << ", \"queue_depth_p50\": " << s.queue_depth_p50
+            << ", \"queue_depth_p99\": " << s.queue_depth_p99 << ", \"queue_depth_max\": " << s.queue_depth_max
+            << ", \"latency_p50_ns\": " << s.latency_p50_ns << ", \"latency_p99_ns\": " << s.latency_p99_ns
+            << ", \"latency_p999_ns\": " << s.latency_p999_ns << ", \"latency_max_ns\": " << s.latency_max_ns
+            << "}" << (i + 1 < steps.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    out.precision(precision);
+}
+
+// Value of "key": <number> in a report line; throws if missing
+inline double load_report_number(const std::string& line, const char* key) {
+    const std::string quoted = std::string("\"") + key + "\":";
+    const auto at = line.find(quoted);
+    if (at == std::string::npos) throw std::runtime_error(std::string("Load report step has no ") + key);
+    const char* begin = line.c_str() + at + quoted.size();
+    char* end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin) throw std::runtime_error(std::string("Load report has a malformed ") + key);
+    return value;
+}
+
+inline uint64_t load_report_count(const std::string& line, const char* key) {
+    return static_cast<uint64_t>(load_report_number(line, key));
+}
+
+// Steps of a report written by write_load_report(); throws std::runtime_error
+// on anything else
+inline std::vector<LoadStepResult> read_load_report(std::istream& in) {
+    std::vector<LoadStepResult> steps;
+    bool is_report = false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("\"report\": \"rt_loadtest\"") != std::string::npos) {
+            is_report = true;
+        } else if (line.find("\"version\":") != std::string::npos) {
+            if (static_cast<int>(load_report_number(line, "version")) != LOAD_REPORT_VERSION) {
+                throw std::runtime_error("Unsupported load report version");
+            }
+        } else if (line.find("\"offered_tps\":") != std::string::npos) {
+            LoadStepResult s;
+            s.offered_tps = load_report_number(line, "offered_tps");
+            s.achieved_tps = load_report_number(line, "achieved_tps");
+            s.seconds = load_report_number(line, "seconds");
+            s.ticks_offered = load_report_count(line, "ticks_offered");
+            s.ticks_processed = load_report_count(line, "ticks_processed");
+            s.ticks_dropped = load_report_count(line, "ticks_dropped");
+            s.signals = load_report_count(line, "signals");
+            s.signals_dropped = load_report_count(line, "signals_dropped");
+            s.queue_depth_p50 = load_report_count(line, "queue_depth_p50");
+            s.queue_depth_p99 = load_report_count(line, "queue_depth_p99");
+            s.queue_depth_max = load_report_count(line, "queue_depth_max");
+            s.latency_p50_ns = load_report_count(line, "latency_p50_ns");
+            s.latency_p99_ns = load_report_count(line, "latency_p99_ns");
+            s.latency_p999_ns = load_report_count(line, "latency_p999_ns");
+            s.latency_max_ns = load_report_count(line, "latency_max_ns");
+            steps.push_back(s);
+        }
+    }
+    if (!is_report) throw std::runtime_error("Not an rt_loadtest report");
+    return steps;
+}
+
+// Steps of current that fell behind the baseline step at the same offered
+// rate. Steps only one side ran are not compared.
+[[nodiscard]] inline std::vector<LoadRegression> compare_load_reports(const std::vector<LoadStepResult>& baseline,
+                                                                      const std::vector<LoadStepResult>& current,
+                                                                      const LoadTolerance& tolerance = {}) {
+    std::vector<LoadRegression> regressions;
+    for (const LoadStepResult& now : current) {
+        for (const LoadStepResult& base : baseline) {
+            if (std::abs(base.offered_tps - now.offered_tps) > 1e-3 * base.offered_tps) continue;
+
+            if (now.achieved_tps < base.achieved_tps * (1.0 - tolerance.throughput)) {
+                regressions.push_back({now.offered_tps, "achieved_tps", base.achieved_tps, now.achieved_tps});
+            }
+            const double latency_limit = static_cast<double>(base.latency_p99_ns) * (1.0 + tolerance.latency) +
+                                         static_cast<double>(tolerance.latency_slack_ns);
+            if (static_cast<double>(now.latency_p99_ns) > latency_limit) {
+                regressions.push_back({now.offered_tps, "latency_p99_ns", static_cast<double>(base.latency_p99_ns),
+                                       static_cast<double>(now.latency_p99_ns)});
+            }
+            if (now.drop_rate() > base.drop_rate() + tolerance.drop_rate) {
+                regressions.push_back({now.offered_tps, "drop_rate", base.drop_rate(), now.drop_rate()});
+            }
+            break;
+        }
+    }
+    return regressions;
+}
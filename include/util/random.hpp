@@ -0,0 +1,212 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+// SplitMix64 step; expands one seed into well-mixed state words
+[[nodiscard]] constexpr uint64_t splitmix64(uint64_t& state) noexcept {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+[[nodiscard]] constexpr uint64_t rotl64(uint64_t x, int k) noexcept {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Uniform double in (0, 1] from the top 53 bits (never 0, so log() is safe)
+[[nodiscard]] constexpr double to_unit_double(uint64_t x) noexcept {
+    return static_cast<double>((x >> 11) + 1) * 0x1.0p-53;
+}
+
+// Branch-free kernels for Xoshiro256x4::fill_normal. libm's log/sin/cos are
+// opaque calls the vectorizer has to leave scalar; these are plain arithmetic
+// and selects, so a loop over them compiles to vector code. Polynomials are
+// fdlibm's (e_log.c, k_sin.c, k_cos.c); error stays within a few ulp.
+
+// ln(x) for x in (0, 1]; no subnormals, so the exponent field is exact
+[[nodiscard]] inline double unit_log(double x) noexcept {
+    constexpr double LN2 = std::numbers::ln2;
+    constexpr double LG1 = 6.666666666666735130e-01, LG2 = 3.999999999940941908e-01,
+                     LG3 = 2.857142874366239149e-01, LG4 = 2.222219843214978396e-01,
+                     LG5 = 1.818357216161805012e-01, LG6 = 1.531383769920937332e-01,
+                     LG7 = 1.479819860511658591e-01;
+
+    // x = 2^k * m with m in [sqrt(2)/2, sqrt(2))
+    const uint64_t bits = std::bit_cast<uint64_t>(x);
+    double m = std::bit_cast<double>((bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull);
+    double k = static_cast<double>(static_cast<int32_t>(bits >> 52) - 1023);
+    const bool high = m > std::numbers::sqrt2;
+    m = high ? 0.5 * m : m;
+    k = high ? k + 1.0 : k;
+
+    // log(1 + f) = 2s + s * R(s^2) with s = f / (2 + f)
+    const double f = m - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double r = z * (LG1 + z * (LG2 + z * (LG3 + z * (LG4 + z * (LG5 + z * (LG6 + z * LG7))))));
+    return k * LN2 + (2.0 * s + s * r);
+}
+
+// sin and cos of 2*pi*u for u in [0, 1]: reduced to a quarter turn, so the
+// kernels only see |x| <= pi/4
+inline void unit_turn_sincos(double u, double& sin_out, double& cos_out) noexcept {
+    constexpr double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03,
+                     S3 = -1.98412698298579493134e-04, S4 = 2.75573137070700676789e-06,
+                     S5 = -2.50507602534068634195e-08, S6 = 1.58969099521155010221e-10;
+    constexpr double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+                     C3 = 2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07,
+                     C5 = 2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+
+    // Nearest quarter turn q; t - q is exact
+    const double t = 4.0 * u;
+    const int32_t q = static_cast<int32_t>(t + 0.5);
+    const double x = (t - static_cast<double>(q)) * (0.5 * std::numbers::pi);
+
+    const double z = x * x;
+    const double sin_x = x + x * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+    const double cos_x = 1.0 - 0.5 * z + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+
+    // Rotate by q quarter turns
+    const bool odd = (q & 1) != 0;
+    sin_out = ((q & 2) != 0 ? -1.0 : 1.0) * (odd ? cos_x : sin_x);
+    cos_out = (((q + 1) & 2) != 0 ? -1.0 : 1.0) * (odd ? sin_x : cos_x);
+}
+
+// xoshiro256++ (Blackman & Vigna). Small, fast, and splittable: jump()
+// advances 2^128 draws, so split() hands out non-overlapping streams for
+// worker threads. Satisfies UniformRandomBitGenerator for <random>.
+class Xoshiro256 {
+private:
+    uint64_t s_[4];
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0x5eed) noexcept {
+        for (auto& word : s_) word = splitmix64(seed);
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept {
+        const uint64_t result = rotl64(s_[0] + s_[3], 23) + s_[0];
+        const uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl64(s_[3], 45);
+        return result;
+    }
+
+    [[nodiscard]] double uniform() noexcept { return to_unit_double((*this)()); }
+
+    // Advance by 2^128 draws
+    void jump() noexcept {
+        constexpr uint64_t JUMP[4] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                      0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        uint64_t next[4] = {0, 0, 0, 0};
+        for (const uint64_t word : JUMP) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (uint64_t{1} << bit)) {
+                    for (int i = 0; i < 4; ++i) next[i] ^= s_[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) s_[i] = next[i];
+    }
+
+    // Returns the current stream and moves this one 2^128 draws ahead
+    [[nodiscard]] Xoshiro256 split() noexcept {
+        const Xoshiro256 stream = *this;
+        jump();
+        return stream;
+    }
+};
+
+// Four xoshiro256++ streams advanced in lockstep. State is stored word-major
+// (s_[word][lane]) so the update loop compiles to one vector register per
+// state word under AVX2/AVX-512/NEON. Used for bulk uniform and normal draws.
+class Xoshiro256x4 {
+public:
+    static constexpr std::size_t LANES = 4;
+
+private:
+    alignas(32) uint64_t s_[4][LANES];
+
+    void next(uint64_t (&out)[LANES]) noexcept {
+        for (std::size_t l = 0; l < LANES; ++l) {
+            out[l] = rotl64(s_[0][l] + s_[3][l], 23) + s_[0][l];
+            const uint64_t t = s_[1][l] << 17;
+            s_[2][l] ^= s_[0][l];
+            s_[3][l] ^= s_[1][l];
+            s_[1][l] ^= s_[2][l];
+            s_[0][l] ^= s_[3][l];
+            s_[2][l] ^= t;
+            s_[3][l] = rotl64(s_[3][l], 45);
+        }
+    }
+
+public:
+    // Lanes are seeded from four consecutive split() streams of parent
+    explicit Xoshiro256x4(Xoshiro256& parent) noexcept {
+        for (std::size_t l = 0; l < LANES; ++l) {
+            Xoshiro256 lane = parent.split();
+            for (std::size_t w = 0; w < 4; ++w) s_[w][l] = lane();
+        }
+    }
+
+    explicit Xoshiro256x4(uint64_t seed = 0x5eed) noexcept {
+        Xoshiro256 parent(seed);
+        *this = Xoshiro256x4(parent);
+    }
+
+    // out[0..n) uniform in (0, 1]
+    void fill_uniform(double* out, std::size_t n) noexcept {
+        uint64_t bits[LANES];
+        std::size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            next(bits);
+            for (std::size_t l = 0; l < LANES; ++l) out[i + l] = to_unit_double(bits[l]);
+        }
+        if (i < n) {
+            next(bits);
+            for (std::size_t l = 0; l < LANES && i < n; ++l, ++i) out[i] = to_unit_double(bits[l]);
+        }
+    }
+
+    // out[0..n) standard normal by Box-Muller. The first half of the batch
+    // holds the radius uniforms and the second half the angle uniforms, so
+    // the transform is a unit-stride loop over unit_log/unit_turn_sincos
+    // that vectorizes with the generator.
+    void fill_normal(double* out, std::size_t n) noexcept {
+        const std::size_t half = n / 2;
+        fill_uniform(out, 2 * half);
+        double* radius = out;
+        double* angle = out + half;
+        for (std::size_t i = 0; i < half; ++i) {
+            const double r = std::sqrt(-2.0 * unit_log(radius[i]));
+            double sin_theta, cos_theta;
+            unit_turn_sincos(angle[i], sin_theta, cos_theta);
+            radius[i] = r * cos_theta;
+            angle[i] = r * sin_theta;
+        }
+        if (2 * half < n) {
+            double pair[2];
+            fill_uniform(pair, 2);
+            double sin_theta, cos_theta;
+            unit_turn_sincos(pair[1], sin_theta, cos_theta);
+            out[n - 1] = std::sqrt(-2.0 * unit_log(pair[0])) * cos_theta;
+        }
+    }
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "util/wait_strategy.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer, multi-reader publication of a small plain struct. The writer
+// never waits; readers retry while a store is in progress, so every value they
+// return was published as a whole. The payload is kept in relaxed atomic words
+// (fenced per Boehm, "Can seqlocks get along with programming language memory
+// models?") so concurrent reads are race-free, not merely benign.
+template <typename T>
+class SeqLock {
+private:
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock holds plain data only");
+    static_assert(std::is_default_constructible_v<T>, "SeqLock payload needs a default value");
+
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};  // Odd while a store is in progress
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+
+public:
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer thread only
+    void store(const T& value) noexcept {
+        uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // One attempt; false if a store overlapped the read
+    [[nodiscard]] bool try_load(T& out) const noexcept {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        uint64_t buffer[WORDS];
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+
+        std::memcpy(&out, buffer, sizeof(T));
+        return true;
+    }
+
+    [[nodiscard]] T load() const noexcept {
+        T out{};
+        while (!try_load(out)) cpu_relax();
+        return out;
+    }
+
+    // Number of completed stores
+    [[nodiscard]] uint64_t version() const noexcept {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+};
@@ -0,0 +1,34 @@
+#pragma once
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Thread placement helpers. Both return false where unsupported or refused
+// (unknown CPU, no CAP_SYS_NICE), so callers can log and carry on.
+
+// Restrict the calling thread to one CPU
+inline bool pin_current_thread(unsigned cpu) noexcept {
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Run the calling thread under SCHED_FIFO at priority (1-99)
+inline bool set_current_thread_realtime(int priority) noexcept {
+#if defined(__linux__)
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+    (void)priority;
+    return false;
+#endif
+}
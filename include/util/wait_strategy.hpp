@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// What an idle thread does while it has nothing to process
+enum class WaitStrategy : uint8_t {
+    BUSY_SPIN,      // Poll with a pause hint; lowest latency, burns the core
+    SPIN_YIELD,     // Spin for a while, then yield the core between polls
+    BLOCKING,       // Spin for a while, then park on a futex until notified
+    SLEEP           // Fixed sleep between polls; cheapest, adds scheduler latency
+};
+
+[[nodiscard]] constexpr const char* wait_strategy_name(WaitStrategy strategy) noexcept {
+    switch (strategy) {
+        case WaitStrategy::BUSY_SPIN: return "spin";
+        case WaitStrategy::SPIN_YIELD: return "yield";
+        case WaitStrategy::BLOCKING: return "block";
+        case WaitStrategy::SLEEP: return "sleep";
+    }
+    return "unknown";
+}
+
+[[nodiscard]] constexpr std::optional<WaitStrategy> parse_wait_strategy(std::string_view name) noexcept {
+    if (name == "spin") return WaitStrategy::BUSY_SPIN;
+    if (name == "yield") return WaitStrategy::SPIN_YIELD;
+    if (name == "block") return WaitStrategy::BLOCKING;
+    if (name == "sleep") return WaitStrategy::SLEEP;
+    return std::nullopt;
+}
+
+// Spin-loop hint: frees pipeline resources for the sibling hyperthread
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+// Wait for deadline the way strategy allows: spin, spin with yields, or sleep
+inline void wait_until(std::chrono::steady_clock::time_point deadline, WaitStrategy strategy) noexcept {
+    switch (strategy) {
+        case WaitStrategy::BUSY_SPIN:
+            while (std::chrono::steady_clock::now() < deadline) cpu_relax();
+            break;
+        case WaitStrategy::SPIN_YIELD:
+            while (std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+            break;
+        case WaitStrategy::BLOCKING:
+        case WaitStrategy::SLEEP:
+            std::this_thread::sleep_until(deadline);
+            break;
+    }
+}
+
+// Lets a consumer park until a producer publishes. The producer calls
+// notify() after each push (or batch); that is one fence and one load unless
+// the consumer is actually parked, when it becomes a futex wake.
+class WakeSignal {
+private:
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::atomic<bool> waiting_{false};
+
+public:
+    // Producer side, after publishing
+    void notify() noexcept {
+        // Pairs with the fence in wait(): either the consumer sees the new
+        // data, or we see waiting_ and wake it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_.load(std::memory_order_relaxed)) {
+            wake();
+        }
+    }
+
+    // Unconditional wake (shutdown)
+    void wake() noexcept {
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_all();
+    }
+
+    // Consumer side: park unless ready() already holds; returns after a
+    // notify()/wake() (or spuriously), so callers re-check their condition
+    template <typename Ready>
+    void wait(Ready&& ready) noexcept {
+        const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) {
+            epoch_.wait(epoch, std::memory_order_acquire);
+        }
+        waiting_.store(false, std::memory_order_relaxed);
+    }
+};
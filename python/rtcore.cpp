@@ -0,0 +1,257 @@
+// In-process Python bindings (pybind11): Router, FeedSimulator and
+// ReplayFeed, with signals, per-symbol stats and latency counts returned as
+// NumPy arrays over the C++ buffers.
+//
+//   import rtcore
+//   feed = rtcore.FeedSimulator([("AAPL", 150.0, 0.3), ("MSFT", 300.0, 0.3)])
+//   router = rtcore.Router()
+//   router.add_watched_pair("AAPL", "MSFT")
+//   router.run(feed, steps=100_000)       # GIL released while it runs
+//   signals = router.signals()            # structured array, no copy
+//
+// Arrays share memory with the Router and keep it alive. Signals land in a
+// block reserved up front (signal_capacity rows), so a view never moves;
+// rows past the capacity are counted in signals_dropped instead.
+
+#include "engine/router.hpp"
+#include "io/journal.hpp"
+#include "md/feed_sim.hpp"
+#include "md/replay_feed.hpp"
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace py = pybind11;
+
+PYBIND11_NUMPY_DTYPE(SignalRecord, event_time_ns, generation_time_ns, signal_id, signal_strength,
+                     confidence, primary_id, secondary_id, event_type, primary_symbol, secondary_symbol);
+PYBIND11_NUMPY_DTYPE(SymbolStats, symbol, ticks, last_price, bid_price, ask_price, last_size,
+                     price_mean, price_variance, volume_mean);
+
+namespace {
+
+constexpr std::size_t DEFAULT_SIGNAL_CAPACITY = 1 << 16;  // 6 MiB of rows; pass more for long runs
+
+// Router plus the signal block its callback fills. The block is reserved, not
+// filled, so pages are only touched as signals arrive, and it never moves, so
+// arrays handed out by signals() stay valid.
+class PyRouter {
+private:
+    Router router_;
+    std::vector<SignalRecord> signals_;
+    std::size_t signal_capacity_;
+    std::atomic<std::size_t> signal_count_{0};  // Rows [0, count) are complete
+    uint64_t signals_dropped_{0};
+
+public:
+    explicit PyRouter(std::size_t signal_capacity)
+        : signal_capacity_(signal_capacity) {
+        signals_.reserve(signal_capacity_);
+        router_.set_signal_callback([this](const SignalEvent& event) {
+            if (signals_.size() == signal_capacity_) {
+                ++signals_dropped_;
+                return;
+            }
+            signals_.push_back(SignalRecord::from(event));
+            signal_count_.store(signals_.size(), std::memory_order_release);
+        });
+    }
+
+    // Sink for FeedSimulator::generate_ticks / ReplayFeed::run: every tick
+    // goes straight to the Router, no queue in between
+    class Sink {
+    private:
+        Router& router_;
+
+    public:
+        using value_type = Tick;
+
+        explicit Sink(Router& router) noexcept : router_(router) {}
+
+        bool push(Tick&& tick) {
+            router_.process_tick(tick);
+            return true;
+        }
+
+        std::size_t try_push_n(const Tick* batch, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) router_.process_tick(batch[i]);
+            return n;
+        }
+    };
+
+    [[nodiscard]] Router& router() noexcept { return router_; }
+    [[nodiscard]] const Router& router() const noexcept { return router_; }
+
+    uint64_t run(FeedSimulator& feed, std::size_t steps) {
+        const uint64_t before = router_.ticks_processed();
+        Sink sink(router_);
+        for (std::size_t step = 0; step < steps; ++step) feed.generate_ticks(sink);
+        return router_.ticks_processed() - before;
+    }
+
+    uint64_t replay(ReplayFeed& replay) {
+        Sink sink(router_);
+        const std::atomic<bool> running{true};
+        return replay.run(sink, running);
+    }
+
+    [[nodiscard]] std::size_t signal_count() const noexcept {
+        return signal_count_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::size_t signal_capacity() const noexcept { return signal_capacity_; }
+    [[nodiscard]] uint64_t signals_dropped() const noexcept { return signals_dropped_; }
+    [[nodiscard]] const SignalRecord* signal_data() const noexcept { return signals_.data(); }
+
+    // Earlier arrays keep their memory but will see the next run's rows
+    void clear_signals() noexcept {
+        signal_count_.store(0, std::memory_order_release);
+        signals_.clear();  // Keeps the reservation, so the block stays put
+        signals_dropped_ = 0;
+    }
+};
+
+// View of n elements of data owned by owner
+template <typename T>
+py::array_t<T> view(const T* data, std::size_t n, py::handle owner) {
+    py::array_t<T> array({n}, {sizeof(T)}, data, owner);
+    array.attr("flags").attr("writeable") = false;
+    return array;
+}
+
+ReplayMode parse_replay_mode(const std::string& mode) {
+    if (mode == "fast") return ReplayMode::AS_FAST_AS_POSSIBLE;
+    if (mode == "paced") return ReplayMode::PACED;
+    throw std::invalid_argument("Unknown replay mode: " + mode + " (fast|paced)");
+}
+
+PriceModel parse_price_model(const std::string& model) {
+    if (model == "gbm") return PriceModel::GEOMETRIC_BROWNIAN_MOTION;
+    if (model == "ou") return PriceModel::ORNSTEIN_UHLENBECK;
+    if (model == "jump") return PriceModel::JUMP_DIFFUSION;
+    throw std::invalid_argument("Unknown price model: " + model + " (gbm|ou|jump)");
+}
+
+} // namespace
+
+PYBIND11_MODULE(rtcore, m) {
+    m.doc() = "In-process bindings for the real-time trading engine";
+
+    py::list signal_types;
+    for (std::size_t t = 0; t < SIGNAL_TYPE_COUNT; ++t) {
+        SignalEvent event;
+        event.event_type = static_cast<SignalEvent::Type>(t);
+        signal_types.append(event.type_name());
+    }
+    m.attr("SIGNAL_TYPES") = signal_types;  // Indexed by the event_type column
+
+    py::class_<FeedSimulator>(m, "FeedSimulator")
+        .def(py::init([](const std::vector<std::tuple<std::string, double, double>>& symbols,
+                         const std::string& model, double tick_interval_ms) {
+                 std::vector<SymbolConfig> configs;
+                 for (const auto& [name, price, volatility] : symbols) {
+                     configs.emplace_back(name, price, volatility);
+                 }
+                 return std::make_unique<FeedSimulator>(std::move(configs), parse_price_model(model),
+                                                        tick_interval_ms);
+             }),
+             py::arg("symbols"), py::arg("model") = "gbm", py::arg("tick_interval_ms") = 1.0,
+             "symbols: (name, initial_price, volatility) tuples; model: gbm|ou|jump")
+        .def("set_pair_correlation", &FeedSimulator::set_pair_correlation)
+        .def_property_readonly("ticks_generated", &FeedSimulator::ticks_generated)
+        .def_property_readonly("symbols", [](const FeedSimulator& feed) {
+            std::vector<std::string> names;
+            for (const auto& config : feed.symbols()) names.push_back(config.symbol);
+            return names;
+        });
+
+    py::class_<ReplayFeed>(m, "ReplayFeed")
+        .def(py::init([](const std::vector<std::string>& paths, const std::string& mode, double speed,
+                         bool recorded_timestamps) {
+                 ReplayConfig config;
+                 config.mode = parse_replay_mode(mode);
+                 config.speed = speed;
+                 config.timestamps = recorded_timestamps ? ReplayTimestamps::RECORDED
+                                                         : ReplayTimestamps::RESTAMP;
+                 return std::make_unique<ReplayFeed>(paths, config);
+             }),
+             py::arg("paths"), py::arg("mode") = "fast", py::arg("speed") = 1.0,
+             py::arg("recorded_timestamps") = true,
+             "Tick journal files (ticks-*.rtj) in recording order")
+        .def_property_readonly("total_ticks", &ReplayFeed::total_ticks)
+        .def_property_readonly("ticks_replayed", &ReplayFeed::ticks_replayed);
+
+    py::class_<PyRouter>(m, "Router")
+        .def(py::init<std::size_t>(), py::arg("signal_capacity") = DEFAULT_SIGNAL_CAPACITY)
+        .def("set_zscore_threshold", [](PyRouter& r, double t) { r.router().set_zscore_threshold(t); })
+        .def("set_correlation_threshold", [](PyRouter& r, double t) { r.router().set_correlation_threshold(t); })
+        .def("set_volume_threshold", [](PyRouter& r, double t) { r.router().set_volume_threshold(t); })
+        .def("set_zscore_window", [](PyRouter& r, std::size_t w) { r.router().set_zscore_window(w); })
+        .def("set_volume_window", [](PyRouter& r, std::size_t w) { r.router().set_volume_window(w); })
+        .def("add_symbol", [](PyRouter& r, const std::string& s) { r.router().add_symbol(s); })
+        .def("add_watched_pair", [](PyRouter& r, const std::string& a, const std::string& b) {
+            r.router().add_watched_pair(a, b);
+        })
+        .def("get_correlation", [](const PyRouter& r, const std::string& a, const std::string& b) {
+            return r.router().get_correlation(a, b);
+        })
+        .def("run", &PyRouter::run, py::arg("feed"), py::arg("steps"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Generate steps ticks per symbol and process them; returns ticks processed")
+        .def("replay", &PyRouter::replay, py::arg("feed"), py::call_guard<py::gil_scoped_release>(),
+             "Process every tick of a ReplayFeed; returns ticks replayed")
+        .def("reset_stats", [](PyRouter& r) { r.router().reset_stats(); r.clear_signals(); })
+        .def("clear_signals", &PyRouter::clear_signals)
+        .def_property_readonly("ticks_processed", [](const PyRouter& r) { return r.router().ticks_processed(); })
+        .def_property_readonly("signal_count", &PyRouter::signal_count)
+        .def_property_readonly("signal_capacity", &PyRouter::signal_capacity)
+        .def_property_readonly("signals_dropped", &PyRouter::signals_dropped)
+        .def("signals", [](py::object self) {
+            const PyRouter& r = self.cast<const PyRouter&>();
+            return view(r.signal_data(), r.signal_count(), self);
+        }, "Signals so far as a read-only structured array over the Router's buffer")
+        .def("snapshot", [](PyRouter& r) { return r.router().snapshot(); },
+             "Counters, latency histogram and per-symbol stats, copied once from the Router");
+
+    py::class_<RouterSnapshot>(m, "RouterSnapshot")
+        .def_property_readonly("ticks_processed", [](const RouterSnapshot& s) { return s.counters.ticks_processed; })
+        .def_property_readonly("signals_generated", [](const RouterSnapshot& s) { return s.counters.signals_generated; })
+        .def_property_readonly("signals_by_type", [](const RouterSnapshot& s) {
+            py::dict by_type;
+            for (std::size_t t = 0; t < SIGNAL_TYPE_COUNT; ++t) {
+                SignalEvent event;
+                event.event_type = static_cast<SignalEvent::Type>(t);
+                by_type[event.type_name()] = s.counters.signals_by_type[t];
+            }
+            return by_type;
+        })
+        .def_property_readonly("ticks_per_second", [](const RouterSnapshot& s) { return s.counters.ticks_per_second(); })
+        .def("latency_percentile_ns", [](const RouterSnapshot& s, double p) { return s.latency.percentile_ns(p); })
+        .def_property_readonly("latency_counts", [](py::object self) {
+            const auto& counts = self.cast<const RouterSnapshot&>().latency.counts();
+            return view(counts.data(), counts.size(), self);
+        }, "HDR histogram counts (no copy); latency_bounds_ns() gives each bucket's range")
+        .def("latency_bounds_ns", [](const RouterSnapshot& s) {
+            const HdrLayout& layout = s.latency.layout();
+            py::array_t<uint64_t> bounds({layout.counts_len(), std::size_t{2}});
+            auto out = bounds.mutable_unchecked<2>();
+            for (std::size_t i = 0; i < layout.counts_len(); ++i) {
+                out(i, 0) = layout.lowest_at(i);
+                out(i, 1) = layout.highest_at(i);
+            }
+            return bounds;
+        }, "Lowest and highest latency (ns) of each latency_counts bucket")
+        .def_property_readonly("symbols", [](py::object self) {
+            const auto& symbols = self.cast<const RouterSnapshot&>().symbols;
+            return view(symbols.data(), symbols.size(), self);
+        }, "Per-symbol stats as a structured array (no copy)");
+
+    m.def("symbol_name", [](SymbolId id) { return std::string(SymbolTable::name(id)); },
+          "Name of an interned symbol id (primary_id / secondary_id / symbol columns)");
+}
@@ -0,0 +1,65 @@
+#include "engine/stage_trace.hpp"
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+
+namespace {
+
+constexpr int PROCESS_ID = 1;
+constexpr int TICK_TRACK = 1;
+constexpr int QUEUE_TRACK = 2;
+
+void write_track_name(std::ostream& out, int tid, const char* name) {
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID
+        << ",\"tid\":" << tid << ",\"args\":{\"name\":\"" << name << "\"}}";
+}
+
+// Symbol names are interned tickers, but keep the JSON valid regardless
+void write_json_string(std::ostream& out, std::string_view value) {
+    out << '"';
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+void write_chrome_trace(std::ostream& out, std::span<const TraceEvent> events) {
+    int64_t origin_ns = 0;
+    if (!events.empty()) {
+        origin_ns = std::min_element(events.begin(), events.end(),
+            [](const TraceEvent& a, const TraceEvent& b) { return a.begin_ns < b.begin_ns; })->begin_ns;
+    }
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    write_track_name(out, TICK_TRACK, "process_tick");
+    out << ',';
+    write_track_name(out, QUEUE_TRACK, "queue");
+    for (const TraceEvent& event : events) {
+        const int tid = event.stage == TraceStage::QUEUE_DWELL ? QUEUE_TRACK : TICK_TRACK;
+        out << ",\n{\"name\":\"" << trace_stage_name(event.stage) << "\",\"cat\":\"router\",\"ph\":\"X\""
+            << ",\"pid\":" << PROCESS_ID << ",\"tid\":" << tid
+            << ",\"ts\":" << static_cast<double>(event.begin_ns - origin_ns) / 1000.0
+            << ",\"dur\":" << static_cast<double>(event.duration_ns) / 1000.0
+            << ",\"args\":{\"symbol\":";
+        write_json_string(out, event.symbol == INVALID_SYMBOL_ID ? std::string_view{}
+                                                                 : SymbolTable::name(event.symbol));
+        out << "}}";
+    }
+    out << "]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
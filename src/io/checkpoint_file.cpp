@@ -0,0 +1,151 @@
+#include "io/checkpoint_file.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error io_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+void write_checkpoint_file(const std::string& path, std::span<const std::byte> image) {
+    const std::string tmp_path = path + ".tmp";
+    const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw io_error("Cannot create checkpoint", tmp_path);
+    }
+
+    const auto* p = image.data();
+    std::size_t bytes = image.size();
+    while (bytes > 0) {
+        const ssize_t n = ::write(fd, p, bytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            const auto error = io_error("Checkpoint write failed for", tmp_path);
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            throw error;
+        }
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+    }
+
+    if (::fsync(fd) != 0) {
+        const auto error = io_error("Cannot sync checkpoint", tmp_path);
+        ::close(fd);
+        ::unlink(tmp_path.c_str());
+        throw error;
+    }
+    ::close(fd);
+
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        const auto error = io_error("Cannot replace checkpoint", path);
+        ::unlink(tmp_path.c_str());
+        throw error;
+    }
+}
+
+CheckpointMapping::CheckpointMapping(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw io_error("Cannot open checkpoint", path);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        const auto error = io_error("Cannot stat checkpoint", path);
+        ::close(fd);
+        throw error;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        throw std::runtime_error("Checkpoint " + path + " is empty");
+    }
+
+    void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw io_error("Cannot map checkpoint", path);
+    }
+    data_ = static_cast<const std::byte*>(map);
+    ::madvise(map, size_, MADV_SEQUENTIAL);
+}
+
+CheckpointMapping::~CheckpointMapping() {
+    if (data_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+CheckpointWriter::CheckpointWriter(std::string path)
+    : path_(std::move(path))
+    , thread_([this] { run(); }) {}
+
+CheckpointWriter::~CheckpointWriter() {
+    stop();
+}
+
+bool CheckpointWriter::submit(std::vector<std::byte>& image) {
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || busy_ || stopping_) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pending_.swap(image);
+    busy_ = true;
+    lock.unlock();
+    wake_.notify_one();
+    return true;
+}
+
+void CheckpointWriter::stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+std::string CheckpointWriter::last_error() {
+    std::lock_guard lock(mutex_);
+    return error_;
+}
+
+void CheckpointWriter::run() {
+    std::vector<std::byte> image;
+    std::unique_lock lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return busy_ || stopping_; });
+        if (!busy_) return;
+
+        // Take the image and leave the previous buffer for the next submit();
+        // busy_ stays set until the write is done
+        image.swap(pending_);
+        lock.unlock();
+
+        std::string error;
+        try {
+            write_checkpoint_file(path_, image);
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (error.empty()) {
+            written_.fetch_add(1, std::memory_order_release);
+        } else {
+            error_ = std::move(error);
+            failures_.fetch_add(1, std::memory_order_release);
+        }
+    }
+}
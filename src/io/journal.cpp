@@ -0,0 +1,153 @@
+#include "io/journal.hpp"
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <ostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error io_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+const char* signal_type_name(uint8_t type) noexcept {
+    SignalEvent event;
+    event.event_type = static_cast<SignalEvent::Type>(type);
+    return event.type_name();
+}
+
+} // namespace
+
+void JournalFile::open(const std::string& path, const JournalHeader& header) {
+    close();
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw io_error("Cannot create journal", path);
+    }
+    bytes_written_ = 0;
+    write(&header, sizeof(header));
+}
+
+void JournalFile::write(const void* data, std::size_t bytes) {
+    const auto* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const ssize_t n = ::write(fd_, p, bytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Journal write failed: ") + std::strerror(errno));
+        }
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+        bytes_written_ += static_cast<uint64_t>(n);
+    }
+}
+
+void JournalFile::close() noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+JournalMapping::JournalMapping(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw io_error("Cannot open journal", path);
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        const auto error = io_error("Cannot stat journal", path);
+        ::close(fd);
+        throw error;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ < sizeof(JournalHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Journal " + path + " is truncated");
+    }
+
+    void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw io_error("Cannot map journal", path);
+    }
+    data_ = static_cast<const std::byte*>(map);
+    ::madvise(map, size_, MADV_SEQUENTIAL);
+
+    std::memcpy(&header_, data_, sizeof(header_));
+    if (std::memcmp(header_.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+        header_.version != JOURNAL_VERSION) {
+        ::munmap(map, size_);
+        data_ = nullptr;
+        throw std::runtime_error("Not a journal (or unsupported version): " + path);
+    }
+}
+
+JournalMapping::~JournalMapping() {
+    if (data_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+std::string make_journal_session_id() {
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+    localtime_r(&now, &local);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y%m%d-%H%M%S", &local);
+    return std::string(buf) + "-" + std::to_string(::getpid());
+}
+
+JournalHeader make_journal_header(JournalKind kind, uint32_t record_size, uint32_t file_index,
+                                  int64_t wall_clock_ns, int64_t steady_clock_ns) noexcept {
+    JournalHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    header.version = JOURNAL_VERSION;
+    header.kind = kind;
+    header.record_size = record_size;
+    header.file_index = file_index;
+    header.wall_clock_ns = wall_clock_ns;
+    header.steady_clock_ns = steady_clock_ns;
+    return header;
+}
+
+std::size_t write_signal_journal_csv(const std::vector<std::string>& paths, std::ostream& out) {
+    out << "timestamp,signal_id,type,primary_symbol,secondary_symbol,"
+        << "signal_strength,confidence,latency_us\n";
+
+    std::size_t rows = 0;
+    for (const auto& path : paths) {
+        const JournalReader<SignalRecord> reader(path);
+        for (const auto& record : reader) {
+            out << record.event_time_ns / 1'000'000 << "," << record.signal_id << ","
+                << signal_type_name(record.event_type) << "," << record.primary_symbol << ","
+                << record.secondary_symbol << "," << record.signal_strength << ","
+                << record.confidence << ","
+                << (record.generation_time_ns - record.event_time_ns) / 1000 << "\n";
+            ++rows;
+        }
+    }
+    return rows;
+}
+
+std::size_t write_tick_journal_csv(const std::vector<std::string>& paths, std::ostream& out) {
+    out << "timestamp_ns,symbol,sequence_id,last_price,bid_price,ask_price,last_size\n";
+
+    std::size_t rows = 0;
+    const auto precision = out.precision(10);
+    for (const auto& path : paths) {
+        const JournalReader<TickRecord> reader(path);
+        for (const auto& record : reader) {
+            out << record.timestamp_ns << "," << record.symbol << "," << record.sequence_id << ","
+                << record.last_price << "," << record.bid_price << "," << record.ask_price << ","
+                << record.last_size << "\n";
+            ++rows;
+        }
+    }
+    out.precision(precision);
+    return rows;
+}
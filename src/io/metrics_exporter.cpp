@@ -0,0 +1,235 @@
+#include "io/metrics_exporter.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <ostream>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int POLL_INTERVAL_MS = 100;       // How quickly stop() is noticed
+constexpr std::size_t MAX_REQUEST_BYTES = 8192;
+constexpr double LATENCY_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+const char* signal_type_name(std::size_t type) noexcept {
+    SignalEvent event;
+    event.event_type = static_cast<SignalEvent::Type>(type);
+    return event.type_name();
+}
+
+// Label values escape backslash, quote and newline
+std::string escape_label(std::string_view value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void write_header(std::ostream& out, std::string_view prefix, std::string_view name,
+                  std::string_view type, std::string_view help) {
+    out << "# HELP " << prefix << '_' << name << ' ' << help << '\n'
+        << "# TYPE " << prefix << '_' << name << ' ' << type << '\n';
+}
+
+// One gauge family with a value per symbol
+template <typename Value>
+void write_symbol_gauge(std::ostream& out, const RouterSnapshot& snapshot, std::string_view prefix,
+                        std::string_view name, std::string_view help, Value&& value) {
+    if (snapshot.symbols.empty()) return;
+    write_header(out, prefix, name, "gauge", help);
+    for (const auto& stats : snapshot.symbols) {
+        out << prefix << '_' << name << "{symbol=\"" << escape_label(SymbolTable::name(stats.symbol))
+            << "\"} " << value(stats) << '\n';
+    }
+}
+
+bool send_all(int fd, std::string_view data) noexcept {
+    while (!data.empty()) {
+        const ssize_t n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(n));
+    }
+    return true;
+}
+
+void send_response(int fd, std::string_view status, std::string_view content_type, std::string_view body) {
+    std::ostringstream head;
+    head << "HTTP/1.0 " << status << "\r\n"
+         << "Content-Type: " << content_type << "\r\n"
+         << "Content-Length: " << body.size() << "\r\n"
+         << "Connection: close\r\n\r\n";
+    if (send_all(fd, head.str())) send_all(fd, body);
+}
+
+} // namespace
+
+void write_prometheus(std::ostream& out, const RouterSnapshot& snapshot, std::string_view prefix) {
+    const auto& counters = snapshot.counters;
+
+    write_header(out, prefix, "ticks_processed_total", "counter", "Ticks processed by the router");
+    out << prefix << "_ticks_processed_total " << counters.ticks_processed << '\n';
+
+    write_header(out, prefix, "signals_total", "counter", "Signals emitted, by type");
+    for (std::size_t type = 0; type < SIGNAL_TYPE_COUNT; ++type) {
+        out << prefix << "_signals_total{type=\"" << signal_type_name(type) << "\"} "
+            << counters.signals_by_type[type] << '\n';
+    }
+
+    write_header(out, prefix, "tick_rate", "gauge", "Ticks per second from the first to the latest tick");
+    out << prefix << "_tick_rate " << counters.ticks_per_second() << '\n';
+
+    const auto& latency = snapshot.latency;
+    write_header(out, prefix, "tick_latency_seconds", "summary", "Tick timestamp to processing start");
+    for (const double q : LATENCY_QUANTILES) {
+        out << prefix << "_tick_latency_seconds{quantile=\"" << q << "\"} "
+            << static_cast<double>(latency.percentile_ns(q * 100.0)) * 1e-9 << '\n';
+    }
+    out << prefix << "_tick_latency_seconds_sum "
+        << latency.mean_latency_ns() * static_cast<double>(latency.total_samples()) * 1e-9 << '\n'
+        << prefix << "_tick_latency_seconds_count " << latency.total_samples() << '\n';
+
+    write_header(out, prefix, "tick_latency_max_seconds", "gauge", "Largest tick latency seen");
+    out << prefix << "_tick_latency_max_seconds " << static_cast<double>(latency.max_latency_ns()) * 1e-9 << '\n';
+
+    write_symbol_gauge(out, snapshot, prefix, "symbol_ticks", "Ticks processed for the symbol",
+                       [](const SymbolStats& s) { return s.ticks; });
+    write_symbol_gauge(out, snapshot, prefix, "symbol_last_price", "Last traded price",
+                       [](const SymbolStats& s) { return s.last_price; });
+    write_symbol_gauge(out, snapshot, prefix, "symbol_spread", "Ask minus bid",
+                       [](const SymbolStats& s) { return s.ask_price - s.bid_price; });
+    write_symbol_gauge(out, snapshot, prefix, "symbol_price_std_dev", "Price standard deviation over the Z-score window",
+                       [](const SymbolStats& s) { return s.price_std_dev(); });
+    write_symbol_gauge(out, snapshot, prefix, "symbol_zscore", "Z-score of the last price",
+                       [](const SymbolStats& s) { return s.zscore(); });
+    write_symbol_gauge(out, snapshot, prefix, "symbol_volume_mean", "Mean trade size over the volume window",
+                       [](const SymbolStats& s) { return s.volume_mean; });
+}
+
+void write_prometheus_gauge(std::ostream& out, std::string_view name, std::string_view help, double value) {
+    out << "# HELP " << name << ' ' << help << '\n'
+        << "# TYPE " << name << " gauge\n"
+        << name << ' ' << value << '\n';
+}
+
+MetricsHttpServer::MetricsHttpServer(Provider provider, MetricsServerConfig config)
+    : provider_(std::move(provider))
+    , config_(std::move(config)) {}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop();
+}
+
+void MetricsHttpServer::start() {
+    if (running_.load(std::memory_order_acquire)) return;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bind_address.c_str(), &addr.sin_addr) != 1) {
+        throw std::runtime_error("Invalid metrics bind address " + config_.bind_address);
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Cannot create metrics socket: ") + std::strerror(errno));
+    }
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+        const std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Cannot listen on " + config_.bind_address + ":" +
+                                 std::to_string(config_.port) + ": " + reason);
+    }
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    listen_fd_ = fd;
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this]() { run(); });
+}
+
+void MetricsHttpServer::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    if (thread_.joinable()) thread_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+}
+
+void MetricsHttpServer::run() {
+    pollfd pfd{listen_fd_, POLLIN, 0};
+    while (running_.load(std::memory_order_acquire)) {
+        pfd.revents = 0;
+        if (::poll(&pfd, 1, POLL_INTERVAL_MS) <= 0 || !(pfd.revents & POLLIN)) continue;
+
+        const int client = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) continue;
+
+        // A stalled client must not hold up the next scrape for long
+        timeval timeout{1, 0};
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        handle_connection(client);
+        ::close(client);
+    }
+}
+
+void MetricsHttpServer::handle_connection(int fd) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        request.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    // Request line: METHOD SP TARGET SP VERSION
+    const std::size_t method_end = request.find(' ');
+    const std::size_t target_end = method_end == std::string::npos
+        ? std::string::npos : request.find(' ', method_end + 1);
+    if (target_end == std::string::npos) {
+        send_response(fd, "400 Bad Request", "text/plain", "Bad request\n");
+        return;
+    }
+    const std::string_view method(request.data(), method_end);
+    std::string_view target(request.data() + method_end + 1, target_end - method_end - 1);
+    target = target.substr(0, target.find('?'));
+
+    if (method != "GET") {
+        send_response(fd, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    } else if (target == "/metrics") {
+        std::string body;
+        try {
+            body = provider_();
+        } catch (const std::exception& e) {
+            send_response(fd, "500 Internal Server Error", "text/plain", std::string(e.what()) + "\n");
+            return;
+        }
+        send_response(fd, "200 OK", "text/plain; version=0.0.4; charset=utf-8", body);
+    } else if (target == "/") {
+        send_response(fd, "200 OK", "text/plain", "Metrics at /metrics\n");
+    } else {
+        send_response(fd, "404 Not Found", "text/plain", "Not found\n");
+    }
+    requests_served_.fetch_add(1, std::memory_order_relaxed);
+}
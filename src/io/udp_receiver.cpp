@@ -0,0 +1,134 @@
+#include "io/udp_receiver.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+in_addr parse_address(const std::string& address, const char* what) {
+    in_addr parsed{};
+    if (::inet_pton(AF_INET, address.c_str(), &parsed) != 1) {
+        throw std::invalid_argument(std::string("Invalid ") + what + " address " + address);
+    }
+    return parsed;
+}
+
+[[noreturn]] void throw_socket_error(int fd, const std::string& what) {
+    const std::string reason = std::strerror(errno);
+    if (fd >= 0) ::close(fd);
+    throw std::runtime_error(what + ": " + reason);
+}
+
+} // namespace
+
+UdpReceiver::UdpReceiver(UdpReceiverConfig config)
+    : config_(std::move(config)) {
+    if (config_.batch_size == 0 || config_.max_packet_bytes == 0) {
+        throw std::invalid_argument("UdpReceiver needs a positive batch size and packet size");
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    addr.sin_addr = parse_address(config_.bind_address, "bind");
+    const bool multicast = !config_.multicast_group.empty();
+    ip_mreq membership{};
+    if (multicast) {
+        membership.imr_multiaddr = parse_address(config_.multicast_group, "multicast group");
+        membership.imr_interface = parse_address(config_.interface_address, "interface");
+        if (!IN_MULTICAST(ntohl(membership.imr_multiaddr.s_addr))) {
+            throw std::invalid_argument(config_.multicast_group + " is not a multicast address");
+        }
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) throw_socket_error(-1, "Cannot create UDP socket");
+
+    // Several handlers (e.g. A and B feed lines, or a recorder) may share a group
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    // Best effort: the kernel caps this at net.core.rmem_max
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &config_.receive_buffer_bytes, sizeof(config_.receive_buffer_bytes));
+
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw_socket_error(fd, "Cannot bind UDP " + config_.bind_address + ":" + std::to_string(config_.port));
+    }
+    if (multicast &&
+        ::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+        throw_socket_error(fd, "Cannot join multicast group " + config_.multicast_group);
+    }
+#if defined(SO_BUSY_POLL)
+    if (config_.busy_poll_us > 0) {
+        busy_poll_ = ::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+                                  &config_.busy_poll_us, sizeof(config_.busy_poll_us)) == 0;
+    }
+#endif
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    fd_ = fd;
+
+    // One buffer slot, iovec and header per datagram of a batch, wired once
+    const std::size_t n = config_.batch_size;
+    buffers_ = std::make_unique<std::byte[]>(n * config_.max_packet_bytes);
+    messages_ = std::make_unique<mmsghdr[]>(n);
+    iovecs_ = std::make_unique<iovec[]>(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        iovecs_[i].iov_base = buffers_.get() + i * config_.max_packet_bytes;
+        iovecs_[i].iov_len = config_.max_packet_bytes;
+        std::memset(&messages_[i], 0, sizeof(mmsghdr));
+        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+        messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+UdpReceiver::~UdpReceiver() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::size_t UdpReceiver::receive(std::span<PacketView> out) {
+    const auto want = static_cast<unsigned>(std::min(out.size(), config_.batch_size));
+    if (want == 0) return 0;
+
+    int got;
+    do {
+        got = ::recvmmsg(fd_, messages_.get(), want, MSG_DONTWAIT, nullptr);
+    } while (got < 0 && errno == EINTR);
+    if (got <= 0) {
+        if (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            receive_errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    const auto rx_time = TickClock::now();
+    std::size_t n = 0;
+    uint64_t bytes = 0;
+    uint64_t truncated = 0;
+    for (int i = 0; i < got; ++i) {
+        const mmsghdr& message = messages_[i];
+        bytes += message.msg_len;
+        if (message.msg_hdr.msg_flags & MSG_TRUNC) {
+            ++truncated;
+            continue;
+        }
+        out[n++] = PacketView{static_cast<const std::byte*>(iovecs_[i].iov_base), message.msg_len, rx_time};
+    }
+
+    packets_received_.fetch_add(static_cast<uint64_t>(got), std::memory_order_relaxed);
+    bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+    if (truncated > 0) packets_truncated_.fetch_add(truncated, std::memory_order_relaxed);
+    return n;
+}
+
+void UdpReceiver::wait_readable(std::chrono::milliseconds timeout) {
+    pollfd pfd{fd_, POLLIN, 0};
+    ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+}
@@ -0,0 +1,343 @@
+#include "io/checkpoint_file.hpp"
+#include "io/journal.hpp"
+#include "md/replay_feed.hpp"
+#include "md/spsc_queue.hpp"
+#include "md/symbol_table.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string make_test_dir(const char* name) {
+    const auto dir = std::filesystem::temp_directory_path() /
+        (std::string("rt_journal_") + name + "_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(dir);
+    return dir.string();
+}
+
+[[maybe_unused]] std::size_t count_lines(const std::string& text) {
+    return static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+} // namespace
+
+void test_signal_journal_rotation() {
+    std::cout << "Testing signal journal write, rotation and readback...\n";
+
+    const std::string dir = make_test_dir("signals");
+    JournalConfig config;
+    config.directory = dir;
+    config.prefix = "signals";
+    config.max_file_bytes = sizeof(JournalHeader) + 10 * sizeof(SignalRecord);  // 10 per file
+    config.flush_interval = std::chrono::milliseconds(1);
+
+    const SymbolId aapl = SymbolTable::intern_id("AAPL");
+    const SymbolId msft = SymbolTable::intern_id("MSFT");
+
+    constexpr std::size_t COUNT = 35;
+    SignalJournal journal(config);
+    journal.start();
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        const SignalEvent event(SignalEvent::Type::CORRELATION_BREAK, aapl, msft,
+                                0.1 * static_cast<double>(i), 0.88);
+        while (!journal.append(SignalRecord::from(event))) {
+            std::this_thread::yield();
+        }
+    }
+    journal.stop();
+
+    assert(!journal.failed());
+    assert(journal.records_written() == COUNT);
+    assert(journal.files().size() == 4);
+
+    std::size_t total = 0;
+    for (const auto& path : journal.files()) {
+        const JournalReader<SignalRecord> reader(path);
+        assert(reader.header().file_index == total / 10);
+        assert(reader.size() <= 10);
+        for ([[maybe_unused]] const auto& record : reader) {
+            assert(record.primary_id == aapl && record.secondary_id == msft);
+            assert(std::string_view(record.primary_symbol) == "AAPL");
+            assert(std::string_view(record.secondary_symbol) == "MSFT");
+            assert(std::abs(record.signal_strength - 0.1 * static_cast<double>(total)) < 1e-12);
+            ++total;
+        }
+    }
+    assert(total == COUNT);
+
+    // Header plus one row per record, in the demo's signals.csv layout
+    std::ostringstream csv;
+    [[maybe_unused]] const std::size_t rows = write_signal_journal_csv(journal.files(), csv);
+    assert(rows == COUNT);
+    assert(count_lines(csv.str()) == COUNT + 1);
+    assert(csv.str().find(",CorrBreak,AAPL,MSFT,") != std::string::npos);
+
+    // A tick journal cannot be read as signals
+    [[maybe_unused]] bool threw = false;
+    try {
+        const JournalReader<TickRecord> wrong(journal.files().front());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✅ Signal journal tests passed\n";
+}
+
+void test_tick_journal_torn_tail() {
+    std::cout << "Testing tick journal recovery from a torn tail...\n";
+
+    const std::string dir = make_test_dir("ticks");
+    JournalConfig config;
+    config.directory = dir;
+    config.prefix = "ticks";
+
+    const SymbolId ibm = SymbolTable::intern_id("IBM");
+
+    constexpr std::size_t COUNT = 100;
+    TickJournal journal(config);
+    journal.start();
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        const Tick tick(ibm, 150.0 + static_cast<double>(i), 149.99, 150.01, 100.0, i);
+        [[maybe_unused]] const bool appended = journal.append(TickRecord::from(tick));
+        assert(appended);
+    }
+    journal.stop();
+    assert(journal.files().size() == 1);
+
+    // Simulate a crash mid-write: half a record at the end
+    const std::string path = journal.files().front();
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        const TickRecord partial{};
+        file.write(reinterpret_cast<const char*>(&partial), sizeof(partial) / 2);
+    }
+
+    const JournalReader<TickRecord> reader(path);
+    assert(reader.size() == COUNT);
+    assert(reader[COUNT - 1].sequence_id == COUNT - 1);
+    assert(std::abs(reader[COUNT - 1].last_price - 249.0) < 1e-12);
+    assert(std::string_view(reader[0].symbol) == "IBM");
+
+    std::ostringstream csv;
+    [[maybe_unused]] const std::size_t rows = write_tick_journal_csv({path}, csv);
+    assert(rows == COUNT);
+
+    // Not a journal at all
+    {
+        std::ofstream garbage(dir + "/garbage.rtj", std::ios::binary);
+        garbage << std::string(128, 'x');
+    }
+    [[maybe_unused]] bool threw = false;
+    try {
+        const JournalMapping mapping(dir + "/garbage.rtj");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✅ Tick journal tests passed\n";
+}
+
+namespace {
+
+// n ticks alternating between two symbols, spaced step apart from base
+std::string write_tick_recording(const std::string& dir, std::size_t n,
+                                 std::chrono::nanoseconds step) {
+    JournalConfig config;
+    config.directory = dir;
+    config.prefix = "replay";
+
+    const SymbolId ids[2] = {SymbolTable::intern_id("SPY"), SymbolTable::intern_id("QQQ")};
+    const auto base = TickClock::now();
+
+    TickJournal journal(config);
+    journal.start();
+    for (std::size_t i = 0; i < n; ++i) {
+        const Tick tick(ids[i % 2], 400.0 + static_cast<double>(i), 399.99, 400.01, 10.0, i,
+                        base + step * static_cast<int64_t>(i));
+        while (!journal.append(TickRecord::from(tick))) {
+            std::this_thread::yield();
+        }
+    }
+    journal.stop();
+    return journal.files().front();
+}
+
+} // namespace
+
+void test_replay_feed() {
+    std::cout << "Testing ReplayFeed fast, paced and lossy modes...\n";
+
+    const std::string dir = make_test_dir("replay");
+    const std::atomic<bool> running{true};
+
+    // Fast replay keeps order, prices, symbols and (optionally) timestamps
+    {
+        const std::string path = write_tick_recording(dir + "/fast", 200, std::chrono::microseconds(50));
+        ReplayConfig config;
+        config.timestamps = ReplayTimestamps::RECORDED;
+        ReplayFeed feed({path}, config);
+        assert(feed.total_ticks() == 200);
+
+        SPSCQueue<Tick, 256> queue;
+        [[maybe_unused]] const uint64_t pushed = feed.run(queue, running);
+        assert(pushed == 200 && feed.ticks_dropped() == 0);
+
+        Tick tick;
+        TickClock::time_point previous{};
+        for (uint64_t i = 0; i < 200; ++i) {
+            [[maybe_unused]] const bool popped = queue.pop(tick);
+            assert(popped);
+            assert(tick.sequence_id == i);
+            assert(std::abs(tick.last_price - (400.0 + static_cast<double>(i))) < 1e-12);
+            assert(tick.symbol() == (i % 2 == 0 ? "SPY" : "QQQ"));
+            assert(i == 0 || tick.timestamp - previous == std::chrono::microseconds(50));
+            previous = tick.timestamp;
+        }
+        assert(queue.empty());
+    }
+
+    // A small queue with a live consumer: back-pressure, nothing lost
+    {
+        const std::string path = write_tick_recording(dir + "/backpressure", 5000, std::chrono::nanoseconds(1));
+        ReplayFeed feed({path});
+        SPSCQueue<Tick, 64> queue;
+        std::atomic<bool> done{false};
+        uint64_t consumed = 0;
+        uint64_t last_sequence = 0;
+        bool in_order = true;
+
+        std::thread consumer([&]() {
+            Tick tick;
+            for (;;) {
+                if (queue.pop(tick)) {
+                    in_order &= consumed == 0 || tick.sequence_id == last_sequence + 1;
+                    last_sequence = tick.sequence_id;
+                    ++consumed;
+                } else if (done.load(std::memory_order_acquire)) {
+                    if (queue.empty()) break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        feed.run(queue, running);
+        done.store(true, std::memory_order_release);
+        consumer.join();
+
+        assert(consumed == 5000 && in_order);
+        assert(feed.ticks_dropped() == 0);
+    }
+
+    // drop_when_full never blocks
+    {
+        const std::string path = write_tick_recording(dir + "/lossy", 100, std::chrono::nanoseconds(1));
+        ReplayConfig config;
+        config.drop_when_full = true;
+        ReplayFeed feed({path}, config);
+        SPSCQueue<Tick, 16> queue;
+        feed.run(queue, running);
+        assert(feed.ticks_replayed() == queue.capacity());
+        assert(feed.ticks_replayed() + feed.ticks_dropped() == 100);
+    }
+
+    // Paced replay honours the recorded spacing, scaled by speed
+    {
+        const std::string path = write_tick_recording(dir + "/paced", 21, std::chrono::milliseconds(2));
+        ReplayConfig config;
+        config.mode = ReplayMode::PACED;
+        config.speed = 2.0;
+        ReplayFeed feed({path}, config);
+        SPSCQueue<Tick, 64> queue;
+
+        const auto start = std::chrono::steady_clock::now();
+        feed.run(queue, running);
+        [[maybe_unused]] const auto elapsed = std::chrono::steady_clock::now() - start;
+        assert(elapsed >= std::chrono::milliseconds(20));  // 40ms recorded at 2x
+        assert(feed.ticks_replayed() == 21);
+    }
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✅ ReplayFeed tests passed\n";
+}
+
+void test_checkpoint_file() {
+    std::cout << "Testing checkpoint files and CheckpointWriter...\n";
+
+    const std::string dir = make_test_dir("checkpoint");
+    std::filesystem::create_directories(dir);
+    const std::string path = dir + "/router.ckpt";
+
+    std::vector<std::byte> image(4096);
+    for (std::size_t i = 0; i < image.size(); ++i) image[i] = static_cast<std::byte>(i * 7);
+
+    // Atomic replace: no temporary left behind, mapping sees the whole image
+    write_checkpoint_file(path, image);
+    assert(!std::filesystem::exists(path + ".tmp"));
+    {
+        const CheckpointMapping mapping(path);
+        assert(std::equal(mapping.bytes().begin(), mapping.bytes().end(), image.begin(), image.end()));
+    }
+
+    // The writer takes the image and hands back its spare buffer
+    {
+        CheckpointWriter writer(path);
+        std::vector<std::byte> next(image.size(), std::byte{0x5a});
+        while (!writer.submit(next)) std::this_thread::yield();
+        for (int i = 0; i < 100 && writer.checkpoints_written() == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        writer.stop();
+        assert(writer.checkpoints_written() == 1 && writer.failures() == 0);
+        // Stopped: further images are refused, not written
+        assert(!writer.submit(next));
+        assert(writer.checkpoints_skipped() >= 1);
+
+        const CheckpointMapping mapping(path);
+        assert(mapping.bytes().size() == image.size() && mapping.bytes()[17] == std::byte{0x5a});
+    }
+
+    // Failures are counted, not thrown at the submitter
+    {
+        CheckpointWriter writer(dir + "/missing/router.ckpt");
+        std::vector<std::byte> next(16);
+        while (!writer.submit(next)) std::this_thread::yield();
+        writer.stop();
+        assert(writer.failures() == 1 && writer.checkpoints_written() == 0);
+        assert(!writer.last_error().empty());
+    }
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        const CheckpointMapping mapping(dir + "/absent.ckpt");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✅ Checkpoint file tests passed\n";
+}
+
+void run_journal_tests() {
+    std::cout << "🧪 Running Journal Tests\n";
+    std::cout << "========================\n";
+
+    test_signal_journal_rotation();
+    test_tick_journal_torn_tail();
+    test_replay_feed();
+    test_checkpoint_file();
+
+    std::cout << "\n✅ All journal tests passed!\n\n";
+}
@@ -0,0 +1,390 @@
+#include "util/latency.hpp"
+#include "util/clock.hpp"
+#include "engine/router.hpp"
+#include "engine/stage_trace.hpp"
+#include "util/load_report.hpp"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+[[maybe_unused]] bool within_relative(double actual, double expected, double tolerance) {
+    return std::abs(actual - expected) <= tolerance * expected;
+}
+
+} // namespace
+
+void test_hdr_layout_precision() {
+    std::cout << "Testing HdrLayout bucket precision...\n";
+
+    const HdrLayout layout(3, 60'000'000'000ull);
+
+    // Small values are exact, larger ones keep 3 significant digits
+    for (uint64_t v = 0; v < 2048; ++v) {
+        assert(layout.lowest_at(layout.index_of(v)) == v);
+        assert(layout.highest_at(layout.index_of(v)) == v);
+    }
+    for (uint64_t v = 2048; v < 50'000'000'000ull; v = v * 3 + 7) {
+        [[maybe_unused]] const std::size_t idx = layout.index_of(v);
+        assert(idx < layout.counts_len());
+        assert(layout.lowest_at(idx) <= v && v <= layout.highest_at(idx));
+        assert(static_cast<double>(layout.highest_at(idx) - layout.lowest_at(idx)) <= v * 1e-3);
+    }
+
+    // Values beyond the trackable range clamp into the last bucket
+    assert(layout.index_of(UINT64_MAX) == layout.index_of(60'000'000'000ull));
+
+    std::cout << "✅ HdrLayout precision tests passed\n";
+}
+
+void test_latency_histogram_percentiles() {
+    std::cout << "Testing LatencyHistogram percentiles...\n";
+
+    LatencyHistogram hist;
+
+    // Uniform 1..100000 ns
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        hist.add_sample_ns(v);
+    }
+
+    assert(hist.total_samples() == 100000);
+    assert(hist.min_latency_ns() == 1);
+    assert(hist.max_latency_ns() == 100000);
+    assert(within_relative(hist.mean_latency_ns(), 50000.5, 1e-9));
+    assert(within_relative(static_cast<double>(hist.percentile_ns(50.0)), 50000.0, 1e-3));
+    assert(within_relative(static_cast<double>(hist.percentile_ns(99.0)), 99000.0, 1e-3));
+    assert(within_relative(static_cast<double>(hist.percentile_ns(99.9)), 99900.0, 1e-3));
+    assert(within_relative(static_cast<double>(hist.percentile_ns(99.99)), 99990.0, 1e-3));
+    assert(hist.percentile_ns(100.0) == 100000);
+    assert(hist.percentile_ns(0.0) == 1);
+
+    // Sub-microsecond samples are resolved rather than lumped together
+    LatencyHistogram fast;
+    for (int i = 0; i < 90; ++i) fast.add_sample_ns(250);
+    for (int i = 0; i < 10; ++i) fast.add_sample_ns(900);
+    assert(fast.percentile_ns(50.0) == 250);
+    assert(fast.percentile_ns(95.0) == 900);
+    assert(std::abs(fast.p50_us() - 0.25) < 1e-12);
+
+    // Time-point API records nanoseconds
+    LatencyHistogram timed;
+    const auto start = std::chrono::steady_clock::now();
+    timed.add_sample(start, start + std::chrono::nanoseconds(1234));
+    assert(timed.max_latency_ns() == 1234);
+    timed.add_sample_us(3);
+    assert(timed.max_latency_ns() == 3000);
+
+    std::cout << "✅ LatencyHistogram percentile tests passed\n";
+}
+
+void test_latency_histogram_merge_and_snapshot() {
+    std::cout << "Testing LatencyHistogram merge and snapshots...\n";
+
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (uint64_t v = 1; v <= 1000; ++v) a.add_sample_ns(v);
+    for (uint64_t v = 1001; v <= 2000; ++v) b.add_sample_ns(v);
+
+    LatencyHistogram merged;
+    merged.merge_from(a);
+    merged.merge_from(b);
+    assert(merged.total_samples() == 2000);
+    assert(merged.min_latency_ns() == 1);
+    assert(merged.max_latency_ns() == 2000);
+    assert(within_relative(static_cast<double>(merged.percentile_ns(50.0)), 1000.0, 1e-3));
+
+    // Snapshot merge matches live merge
+    HistogramSnapshot snap = a.snapshot();
+    snap.merge(b.snapshot());
+    assert(snap.total_samples() == 2000);
+    assert(snap.percentile_ns(50.0) == merged.percentile_ns(50.0));
+    assert(snap.percentile_ns(99.9) == merged.percentile_ns(99.9));
+
+    // Interval view without reset: only the samples since the first snapshot
+    const HistogramSnapshot before = a.snapshot();
+    for (int i = 0; i < 100; ++i) a.add_sample_ns(500000);
+    const HistogramSnapshot interval = a.snapshot().delta_since(before);
+    assert(interval.total_samples() == 100);
+    assert(within_relative(static_cast<double>(interval.percentile_ns(50.0)), 500000.0, 1e-3));
+    assert(within_relative(static_cast<double>(interval.min_latency_ns()), 500000.0, 1e-3));
+    assert(a.total_samples() == 1100); // Live histogram untouched
+
+    // Differently configured histograms still merge, at the coarser precision
+    LatencyHistogram coarse(1, 1'000'000'000ull);
+    coarse.merge_from(a);
+    assert(coarse.total_samples() == 1100);
+    assert(coarse.max_latency_ns() == 500000);
+
+    std::cout << "✅ LatencyHistogram merge/snapshot tests passed\n";
+}
+
+void test_latency_histogram_rate_concurrent() {
+    std::cout << "Testing LatencyHistogram rate under concurrent reset...\n";
+
+    // The writer resets and refills while a reader polls the rate (TSan
+    // builds check the start time is shared race-free)
+    LatencyHistogram hist;
+    assert(hist.sample_rate_per_second() == 0.0);
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_acquire)) {
+            [[maybe_unused]] const double rate = hist.sample_rate_per_second();
+            assert(rate >= 0.0);
+        }
+    });
+    for (int round = 0; round < 2000; ++round) {
+        hist.reset();
+        for (uint64_t v = 1; v <= 16; ++v) hist.add_sample_ns(v);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    LatencyHistogram merged;
+    merged.merge_from(hist);
+    assert(merged.total_samples() == 16 && merged.sample_rate_per_second() > 0.0);
+    hist.reset();
+    assert(hist.sample_rate_per_second() == 0.0);
+
+    std::cout << "✅ LatencyHistogram concurrent rate tests passed\n";
+}
+
+void test_cycle_clock() {
+    std::cout << "Testing CycleClock calibration...\n";
+
+    CycleClock::calibrate();
+    assert(CycleClock::ns_per_cycle() > 0.0);
+
+    // Readings are monotonic
+    auto prev = CycleClock::now();
+    for (int i = 0; i < 10000; ++i) {
+        const auto next = CycleClock::now();
+        assert(next >= prev);
+        prev = next;
+    }
+
+    // Shares steady_clock's epoch and rate
+    const auto cycle_start = CycleClock::now();
+    const auto steady_start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto cycle_elapsed = CycleClock::now() - cycle_start;
+    const auto steady_elapsed = std::chrono::steady_clock::now() - steady_start;
+    [[maybe_unused]] const double ratio = static_cast<double>(cycle_elapsed.count()) /
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(steady_elapsed).count());
+    assert(ratio > 0.95 && ratio < 1.05);
+
+    [[maybe_unused]] const auto skew = convert_time_point<std::chrono::steady_clock>(CycleClock::now()) -
+                      std::chrono::steady_clock::now();
+    assert(std::chrono::abs(skew) < std::chrono::milliseconds(1));
+
+    // Re-anchoring keeps the epoch shared while other threads read the clock
+    std::atomic<bool> reading{true};
+    std::thread reader([&reading]() {
+        while (reading.load(std::memory_order_acquire)) {
+            [[maybe_unused]] const auto skew = convert_time_point<std::chrono::steady_clock>(CycleClock::now()) -
+                                               std::chrono::steady_clock::now();
+            assert(std::chrono::abs(skew) < std::chrono::milliseconds(1));
+        }
+    });
+    for (int i = 0; i < 100; ++i) {
+        CycleClock::reanchor();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    reading.store(false, std::memory_order_release);
+    reader.join();
+    assert(CycleClock::ns_per_cycle() > 0.0);
+    [[maybe_unused]] const auto anchored_skew = convert_time_point<std::chrono::steady_clock>(CycleClock::now()) -
+                                                std::chrono::steady_clock::now();
+    assert(std::chrono::abs(anchored_skew) < std::chrono::milliseconds(1));
+
+    // Histograms accept cycle-clock time points
+    LatencyHistogram timed;
+    const auto start = CycleClock::now();
+    timed.add_sample(start, start + std::chrono::nanoseconds(500));
+    assert(timed.max_latency_ns() == 500);
+
+    std::cout << "✅ CycleClock tests passed\n";
+}
+
+void test_stage_trace() {
+    std::cout << "Testing stage profiler and Chrome trace...\n";
+
+    // Ring keeps the newest events, oldest first
+    TraceRing ring(4);
+    for (uint32_t i = 0; i < 6; ++i) {
+        ring.record(TraceEvent{static_cast<int64_t>(i) * 100, i, INVALID_SYMBOL_ID, TraceStage::TICK_TOTAL});
+    }
+    [[maybe_unused]] const auto kept = ring.events();
+    assert(ring.written() == 6 && kept.size() == 4);
+    assert(kept.front().duration_ns == 2 && kept.back().duration_ns == 5);
+
+    [[maybe_unused]] bool rejected = false;
+    try {
+        TraceRing bad(3);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // One histogram per stage, spans mirrored into the ring
+    const SymbolId id = SymbolTable::intern_id("TRACE\"X");
+    StageProfiler profiler;
+    profiler.enable_trace(16);
+    const auto t0 = TickClock::now();
+    profiler.record(TraceStage::SINGLE_RULES, id, t0, t0 + std::chrono::nanoseconds(300));
+    profiler.record(TraceStage::QUEUE_DWELL, id, t0 - std::chrono::nanoseconds(2000), t0);
+    profiler.record(TraceStage::SIGNAL_EMIT, id, t0 + std::chrono::nanoseconds(100), t0);  // Clamped to 0
+    assert(profiler.histogram(TraceStage::SINGLE_RULES).max_latency_ns() == 300);
+    assert(profiler.histogram(TraceStage::SIGNAL_EMIT).max_latency_ns() == 0);
+    assert(profiler.histogram(TraceStage::CROSS_RULES).total_samples() == 0);
+    assert(profiler.trace()->size() == 3);
+
+    std::ostringstream json;
+    const auto events = profiler.trace()->events();
+    write_chrome_trace(json, events);
+    const std::string trace = json.str();
+    assert(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+    assert(trace.find("\"name\":\"single_rules\",\"cat\":\"router\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                      "\"ts\":2.000,\"dur\":0.300") != std::string::npos);
+    assert(trace.find("\"name\":\"queue_dwell\",\"cat\":\"router\",\"ph\":\"X\",\"pid\":1,\"tid\":2,"
+                      "\"ts\":0.000,\"dur\":2.000") != std::string::npos);
+    assert(trace.find("\"symbol\":\"TRACE\\\"X\"") != std::string::npos);
+    assert(trace.substr(trace.size() - 3) == "]}\n");
+
+    profiler.reset();
+    assert(profiler.trace()->size() == 0);
+    assert(profiler.histogram(TraceStage::SINGLE_RULES).total_samples() == 0);
+
+    // Router probes exist only when compiled in
+    Router router;
+    router.set_zscore_threshold(0.5);
+    router.set_signal_callback([](const SignalEvent&) {});
+    [[maybe_unused]] const bool traced = router.enable_trace(256);
+    assert(traced == TRACING_ENABLED);
+    assert((router.stage_profiler() != nullptr) == TRACING_ENABLED);
+    for (uint64_t i = 0; i < 100; ++i) {
+        const double x = 20.0 + std::sin(static_cast<double>(i));
+        router.process_tick(Tick{id, x, x - 0.01, x + 0.01, 100.0, i});
+    }
+    if constexpr (TRACING_ENABLED) {
+        [[maybe_unused]] const StageProfiler& stages = *router.stage_profiler();
+        assert(stages.histogram(TraceStage::TICK_TOTAL).total_samples() == 100);
+        assert(stages.histogram(TraceStage::SINGLE_RULES).total_samples() == 100);
+        assert(stages.histogram(TraceStage::SIGNAL_EMIT).total_samples() == router.signals_generated());
+        assert(stages.trace()->written() == 400 + router.signals_generated());
+    }
+
+    std::cout << "✅ Stage trace tests passed\n";
+}
+
+void test_load_report() {
+    std::cout << "Testing rt_loadtest report and regression check...\n";
+
+    LoadStepResult slow;
+    slow.offered_tps = 100000.0;
+    slow.achieved_tps = 99876.5;
+    slow.seconds = 2.0004;
+    slow.ticks_offered = 200000;
+    slow.ticks_processed = 200000;
+    slow.signals = 321;
+    slow.queue_depth_p50 = 0;
+    slow.queue_depth_p99 = 63;
+    slow.queue_depth_max = 70;
+    slow.latency_p50_ns = 350;
+    slow.latency_p99_ns = 4100;
+    slow.latency_p999_ns = 9000;
+    slow.latency_max_ns = 52000;
+
+    LoadStepResult fast = slow;
+    fast.offered_tps = 10000000.0;
+    fast.achieved_tps = 6500000.0;
+    fast.ticks_offered = 20000000;
+    fast.ticks_processed = 13000000;
+    fast.ticks_dropped = 7000000;
+    fast.signals_dropped = 12;
+    fast.queue_depth_max = 65535;
+    fast.latency_p99_ns = 8000000;
+
+    std::stringstream report;
+    write_load_report(report, {slow, fast}, "ci \"nightly\"\n");
+    assert(report.str().find("\"label\": \"ci \\\"nightly\\\"\",\n") != std::string::npos);
+    const auto steps = read_load_report(report);
+    assert(steps.size() == 2);
+    assert(steps[0].offered_tps == slow.offered_tps);
+    assert(steps[0].achieved_tps == slow.achieved_tps);
+    assert(steps[0].seconds == slow.seconds);
+    assert(steps[0].signals == 321);
+    assert(steps[0].queue_depth_p99 == 63);
+    assert(steps[0].latency_p999_ns == 9000);
+    assert(steps[0].latency_max_ns == 52000);
+    assert(steps[1].ticks_dropped == 7000000);
+    assert(steps[1].signals_dropped == 12);
+    assert(steps[1].queue_depth_max == 65535);
+    assert(within_relative(steps[1].drop_rate(), 0.35, 1e-12));
+
+    // Identical and within-tolerance runs pass
+    assert(compare_load_reports(steps, steps).empty());
+    LoadStepResult noisy = slow;
+    noisy.achieved_tps *= 0.95;
+    noisy.latency_p99_ns = 4100 * 5 / 4 + 2000;
+    assert(compare_load_reports(steps, {noisy}).empty());
+
+    // Each metric past its tolerance is reported once, for that step only
+    LoadStepResult worse = fast;
+    worse.achieved_tps = 5000000.0;
+    worse.latency_p99_ns = 12000000;
+    worse.ticks_dropped = 9000000;
+    const auto regressions = compare_load_reports(steps, {slow, worse});
+    assert(regressions.size() == 3);
+    for ([[maybe_unused]] const LoadRegression& r : regressions) assert(r.offered_tps == fast.offered_tps);
+    assert(regressions[0].metric == "achieved_tps");
+    assert(regressions[1].metric == "latency_p99_ns" && regressions[1].measured == 12000000.0);
+    assert(regressions[2].metric == "drop_rate");
+
+    // Steps missing from the baseline are not compared
+    [[maybe_unused]] LoadStepResult unmatched = worse;
+    unmatched.offered_tps = 3000000.0;
+    assert(compare_load_reports(steps, {unmatched}).empty());
+
+    // Only rt_loadtest reports are accepted
+    [[maybe_unused]] bool threw = false;
+    try {
+        std::stringstream other("{\"benchmarks\": []}\n");
+        (void)read_load_report(other);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        std::stringstream truncated("{\n  \"report\": \"rt_loadtest\",\n    {\"offered_tps\": 1000, \"achieved_tps\": 9}\n");
+        (void)read_load_report(truncated);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Load report tests passed\n";
+}
+
+void run_latency_tests() {
+    std::cout << "🧪 Running Latency Tests\n";
+    std::cout << "========================\n";
+
+    test_hdr_layout_precision();
+    test_latency_histogram_percentiles();
+    test_latency_histogram_merge_and_snapshot();
+    test_latency_histogram_rate_concurrent();
+    test_cycle_clock();
+    test_stage_trace();
+    test_load_report();
+
+    std::cout << "\n✅ All latency tests passed!\n\n";
+}
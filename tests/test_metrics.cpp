@@ -0,0 +1,236 @@
+#include "engine/router.hpp"
+#include "engine/sharded_router.hpp"
+#include "io/metrics_exporter.hpp"
+#include "md/feed_sim.hpp"
+#include "util/seqlock.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Bare HTTP/1.0 GET against localhost; returns the whole response
+std::string http_get(uint16_t port, const std::string& path) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return {};
+    }
+    const std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+    [[maybe_unused]] const ssize_t sent = ::send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+    return response;
+}
+
+struct Triple {
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+};
+
+} // namespace
+
+void test_seqlock() {
+    std::cout << "Testing SeqLock publication...\n";
+
+    SeqLock<Triple> lock;
+    assert(lock.version() == 1);  // Default value published by the constructor
+    assert(lock.load().a == 0);
+
+    // Readers only ever see whole stores
+    constexpr uint64_t STORES = 200000;
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (uint64_t v = 1; v <= STORES; ++v) {
+            lock.store(Triple{v, v * 3, ~v});
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    [[maybe_unused]] uint64_t last = 0;
+    uint64_t reads = 0;
+    while (!done.load(std::memory_order_acquire) || reads == 0) {
+        const Triple t = lock.load();
+        assert((t.a == 0 && t.b == 0 && t.c == 0) || (t.b == t.a * 3 && t.c == ~t.a));
+        assert(t.a >= last);
+        last = t.a;
+        ++reads;
+    }
+    writer.join();
+    assert(lock.load().a == STORES);
+    assert(lock.version() == STORES + 1);
+
+    std::cout << "✅ SeqLock tests passed\n";
+}
+
+void test_router_snapshot() {
+    std::cout << "Testing Router snapshot consistency...\n";
+
+    std::vector<SymbolConfig> configs;
+    for (int i = 0; i < 8; ++i) {
+        configs.emplace_back("SNAP_" + std::to_string(i), 100.0 + i, 200.0);
+    }
+    FeedSimulator feed(configs);
+
+    struct VectorSink {
+        std::vector<Tick>& out;
+        bool push(const Tick& tick) { out.push_back(tick); return true; }
+    };
+    std::vector<Tick> ticks;
+    VectorSink sink{ticks};
+    for (int step = 0; step < 2000; ++step) feed.generate_ticks(sink);
+
+    Router router;
+    router.set_zscore_threshold(1.0);  // Plenty of signals
+    router.set_signal_callback([](const SignalEvent&) {});
+    router.add_watched_pair("SNAP_0", "SNAP_1");
+
+    const RouterSnapshot empty = router.snapshot();
+    assert(empty.counters.ticks_processed == 0 && empty.symbols.empty());
+    assert(router.processing_rate() == 0.0);
+
+    // A reader polls while the tick thread runs; every view is self-consistent
+    std::atomic<bool> done{false};
+    std::thread processor([&]() {
+        for (const auto& tick : ticks) router.process_tick(tick);
+        done.store(true, std::memory_order_release);
+    });
+
+    [[maybe_unused]] uint64_t last_ticks = 0;
+    uint64_t snapshots = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        const RouterSnapshot snap = router.snapshot();
+        const auto& c = snap.counters;
+        assert(std::accumulate(c.signals_by_type.begin(), c.signals_by_type.end(), uint64_t{0}) ==
+               c.signals_generated);
+        assert(c.ticks_processed >= last_ticks);
+        last_ticks = c.ticks_processed;
+
+        uint64_t symbol_ticks = 0;
+        for (const auto& stats : snap.symbols) {
+            assert(stats.symbol != INVALID_SYMBOL_ID);
+            symbol_ticks += stats.ticks;
+        }
+        // Symbol stats are published before the counters of the same tick
+        assert(symbol_ticks >= c.ticks_processed);
+        ++snapshots;
+    }
+    processor.join();
+    assert(snapshots > 0);
+
+    const RouterSnapshot snap = router.snapshot();
+    assert(snap.counters.ticks_processed == ticks.size());
+    assert(snap.counters.signals_generated == router.signals_generated());
+    assert(snap.counters.signals_generated > 0);
+    assert(snap.latency.total_samples() == ticks.size());
+    assert(snap.counters.ticks_per_second() > 0.0);
+    assert(snap.ticks_per_second_since(empty) > 0.0);
+    assert(snap.symbols.size() == configs.size());
+    assert(std::is_sorted(snap.symbols.begin(), snap.symbols.end(),
+                          [](const SymbolStats& a, const SymbolStats& b) { return a.symbol < b.symbol; }));
+    for ([[maybe_unused]] const auto& stats : snap.symbols) {
+        assert(stats.ticks == 2000);
+        assert(stats.last_price > 0.0 && stats.bid_price <= stats.ask_price);
+        assert(stats.price_std_dev() > 0.0 && std::isfinite(stats.zscore()));
+    }
+
+    // ShardedRouter merges its shards
+    ShardedRouter sharded(2);
+    sharded.start();
+    for (const auto& tick : ticks) {
+        while (!sharded.push(tick)) std::this_thread::yield();
+    }
+    while (sharded.ticks_processed() < ticks.size()) std::this_thread::yield();
+    sharded.stop();
+    const RouterSnapshot merged = sharded.snapshot();
+    assert(merged.counters.ticks_processed == ticks.size());
+    assert(merged.latency.total_samples() == ticks.size());
+    assert(merged.symbols.size() == configs.size());
+
+    router.reset_stats();
+    assert(router.snapshot().counters.ticks_processed == 0);
+    assert(router.snapshot().symbols.front().ticks == 0);
+
+    std::cout << "✅ Router snapshot tests passed\n";
+}
+
+void test_prometheus_export() {
+    std::cout << "Testing Prometheus exporter...\n";
+
+    Router router;
+    router.set_zscore_threshold(0.5);
+    router.set_signal_callback([](const SignalEvent&) {});
+    const SymbolId id = SymbolTable::intern_id("PROM\"Q");  // Needs label escaping
+    for (uint64_t i = 0; i < 100; ++i) {
+        const double x = 50.0 + std::sin(static_cast<double>(i) * 0.3);
+        router.process_tick(Tick{id, x, x - 0.02, x + 0.02, 100.0 + static_cast<double>(i % 5), i});
+    }
+
+    std::ostringstream text;
+    write_prometheus(text, router.snapshot());
+    write_prometheus_gauge(text, "rt_queue_fill_ratio", "Tick queue occupancy", 0.25);
+    const std::string metrics = text.str();
+    assert(metrics.find("# TYPE rt_ticks_processed_total counter\nrt_ticks_processed_total 100\n") != std::string::npos);
+    assert(metrics.find("rt_signals_total{type=\"ZBreak\"} ") != std::string::npos);
+    assert(metrics.find("rt_tick_latency_seconds{quantile=\"0.99\"} ") != std::string::npos);
+    assert(metrics.find("rt_tick_latency_seconds_count 100\n") != std::string::npos);
+    assert(metrics.find("rt_symbol_ticks{symbol=\"PROM\\\"Q\"} 100\n") != std::string::npos);
+    assert(metrics.find("rt_queue_fill_ratio 0.25\n") != std::string::npos);
+
+    // Served over HTTP on an ephemeral port
+    MetricsServerConfig config;
+    config.port = 0;
+    MetricsHttpServer server([&router]() {
+        std::ostringstream out;
+        write_prometheus(out, router.snapshot());
+        return out.str();
+    }, config);
+    server.start();
+    assert(server.running() && server.port() != 0);
+
+    const std::string ok = http_get(server.port(), "/metrics");
+    assert(ok.rfind("HTTP/1.0 200 OK\r\n", 0) == 0);
+    assert(ok.find("text/plain; version=0.0.4") != std::string::npos);
+    assert(ok.find("rt_ticks_processed_total 100\n") != std::string::npos);
+    assert(http_get(server.port(), "/missing").rfind("HTTP/1.0 404", 0) == 0);
+    assert(server.requests_served() == 2);
+
+    server.stop();
+    assert(!server.running());
+    assert(http_get(server.port(), "/metrics").empty());
+
+    std::cout << "✅ Prometheus exporter tests passed\n";
+}
+
+void run_metrics_tests() {
+    std::cout << "🧪 Running Metrics Tests\n";
+    std::cout << "========================\n";
+
+    test_seqlock();
+    test_router_snapshot();
+    test_prometheus_export();
+
+    std::cout << "\n✅ All metrics tests passed!\n\n";
+}
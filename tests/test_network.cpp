@@ -0,0 +1,336 @@
+#include "engine/sharded_router.hpp"
+#include "io/udp_receiver.hpp"
+#include "md/feed_handler.hpp"
+#include "md/spsc_queue.hpp"
+#include "md/wire_decoders.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+[[maybe_unused]] bool near(double a, double b) {
+    return std::abs(a - b) < 1e-9;
+}
+
+std::span<const std::byte> as_bytes(std::string_view text) {
+    return {reinterpret_cast<const std::byte*>(text.data()), text.size()};
+}
+
+// Unconnected UDP socket sending to 127.0.0.1:port
+class LoopbackSender {
+private:
+    int fd_;
+    sockaddr_in to_{};
+
+public:
+    explicit LoopbackSender(uint16_t port)
+        : fd_(::socket(AF_INET, SOCK_DGRAM, 0)) {
+        to_.sin_family = AF_INET;
+        to_.sin_port = htons(port);
+        ::inet_pton(AF_INET, "127.0.0.1", &to_.sin_addr);
+    }
+
+    ~LoopbackSender() { ::close(fd_); }
+
+    bool send(std::span<const std::byte> packet) const {
+        return ::sendto(fd_, packet.data(), packet.size(), 0,
+                        reinterpret_cast<const sockaddr*>(&to_), sizeof(to_)) ==
+               static_cast<ssize_t>(packet.size());
+    }
+};
+
+// Hands out a fixed set of packets once
+class ScriptedPacketSource : public PacketSource {
+private:
+    std::vector<std::vector<std::byte>> packets_;
+    std::size_t next_{0};
+
+public:
+    void add(std::span<const std::byte> packet) { packets_.emplace_back(packet.begin(), packet.end()); }
+
+    std::size_t receive(std::span<PacketView> out) override {
+        std::size_t n = 0;
+        for (; n < out.size() && next_ < packets_.size(); ++n, ++next_) {
+            out[n] = PacketView{packets_[next_].data(), packets_[next_].size(), TickClock::now()};
+        }
+        return n;
+    }
+
+    [[nodiscard]] std::size_t max_batch() const noexcept override { return 4; }
+};
+
+} // namespace
+
+void test_rtmd_decoder() {
+    std::cout << "Testing RTMD encode/decode...\n";
+
+    RtmdPacketBuilder builder(100);
+    [[maybe_unused]] bool added = builder.add_instrument(7, "RTMD_A", 0.01);
+    added &= builder.add_instrument(9, "RTMD_B", 0.5);
+    added &= builder.add_tick(7, Tick{INVALID_SYMBOL_ID, 101.23, 101.20, 101.25, 300.0, 0}, 0.01);
+    added &= builder.add_tick(9, Tick{INVALID_SYMBOL_ID, 50.5, 50.0, 51.0, 10.0, 0}, 0.5);
+    assert(added && builder.message_count() == 4 && builder.next_sequence() == 104);
+
+    RtmdDecoder decoder;
+    std::vector<Tick> out(16);
+    const auto rx = TickClock::now();
+    DecodeResult result = decoder.decode(builder.finish(), rx, out);
+    assert(!result.malformed && result.ticks == 2);
+    assert(out[0].symbol() == "RTMD_A" && near(out[0].last_price, 101.23));
+    assert(near(out[0].bid_price, 101.20) && near(out[0].ask_price, 101.25) && out[0].last_size == 300.0);
+    assert(out[0].sequence_id == 102 && out[0].timestamp == rx);
+    assert(out[1].symbol() == "RTMD_B" && near(out[1].bid_price, 50.0) && near(out[1].ask_price, 51.0));
+    assert(decoder.symbol_of(7) == SymbolTable::find("RTMD_A"));
+
+    // Replayed packet: dropped whole
+    result = decoder.decode(builder.finish(), rx, out);
+    assert(result.ticks == 0 && !result.malformed && decoder.duplicate_packets() == 1);
+
+    // Skipping a packet shows up as a gap; unannounced instruments are skipped
+    builder.clear();
+    builder.add_tick(7, Tick{INVALID_SYMBOL_ID, 101.0, 100.99, 101.01, 1.0, 0}, 0.01);
+    builder.clear();  // "Lost" message 104
+    builder.add_tick(7, Tick{INVALID_SYMBOL_ID, 102.0, 101.99, 102.01, 1.0, 0}, 0.01);
+    builder.add_tick(8, Tick{INVALID_SYMBOL_ID, 1.0, 1.0, 1.0, 1.0, 0}, 0.01);
+    result = decoder.decode(builder.finish(), rx, out);
+    assert(result.ticks == 1 && near(out[0].last_price, 102.0) && out[0].sequence_id == 105);
+    assert(decoder.sequence_gaps() == 1 && decoder.unknown_instruments() == 1);
+
+    // Corrupt packets
+    const auto packet = builder.finish();
+    result = decoder.decode(packet.first(10), rx, out);  // Short header
+    assert(result.malformed);
+    std::vector<std::byte> bad_magic(packet.begin(), packet.end());
+    bad_magic[0] = std::byte{0};
+    result = decoder.decode(bad_magic, rx, out);
+    assert(result.malformed);
+    builder.clear();
+    builder.add_tick(7, Tick{INVALID_SYMBOL_ID, 103.0, 102.99, 103.01, 1.0, 0}, 0.01);
+    const auto whole = builder.finish();
+    result = decoder.decode(whole.first(whole.size() - 4), rx, out);  // Truncated message
+    assert(result.malformed && result.ticks == 0);
+
+    // An unusable definition flags the packet but not the messages after it
+    RtmdPacketBuilder defining(1);
+    RtmdDecoder defining_decoder;
+    defining.add_instrument(RtmdDecoder::MAX_INSTRUMENT_ID, "RTMD_BAD", 0.01);
+    defining.add_instrument(4, "RTMD_D", 0.01);
+    defining.add_tick(4, Tick{INVALID_SYMBOL_ID, 20.0, 19.99, 20.01, 1.0, 0}, 0.01);
+    result = defining_decoder.decode(defining.finish(), rx, out);
+    assert(result.malformed && result.ticks == 1 && out[0].symbol_id == SymbolTable::find("RTMD_D"));
+
+    // Out of room in out: the rest of the packet is reported, not overrun
+    RtmdPacketBuilder burst(1);
+    RtmdDecoder burst_decoder;
+    burst.add_instrument(1, "RTMD_C", 0.01);
+    for (int i = 0; i < 5; ++i) {
+        burst.add_tick(1, Tick{INVALID_SYMBOL_ID, 10.0, 9.99, 10.01, 1.0, 0}, 0.01);
+    }
+    result = burst_decoder.decode(burst.finish(), rx, std::span<Tick>(out.data(), 3));
+    assert(result.ticks == 3 && result.malformed);
+
+    // Packets stop at one Ethernet frame
+    RtmdPacketBuilder full;
+    std::size_t quotes = 0;
+    while (full.add_tick(1, Tick{INVALID_SYMBOL_ID, 10.0, 9.99, 10.01, 1.0, 0}, 0.01)) ++quotes;
+    assert(quotes == (RTMD_MAX_PACKET_BYTES - sizeof(RtmdPacketHeader)) / sizeof(RtmdQuote));
+    assert(full.finish().size() <= RTMD_MAX_PACKET_BYTES);
+
+    [[maybe_unused]] bool rejected = false;
+    try {
+        [[maybe_unused]] const bool fits = full.add_instrument(2, "A_SYMBOL_LONGER_THAN_16", 0.01);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    std::cout << "✅ RTMD tests passed\n";
+}
+
+void test_text_decoder() {
+    std::cout << "Testing text tick decoder...\n";
+
+    TextTickDecoder decoder;
+    std::vector<Tick> out(8);
+    const auto rx = TickClock::now();
+    DecodeResult result = decoder.decode(
+        as_bytes("TXT_A 10.5 10.4 10.6 100\r\nTXT_B,20,19.9,20.1,5\n\n"), rx, out);
+    assert(!result.malformed && result.ticks == 2);
+    assert(out[0].symbol() == "TXT_A" && out[0].last_price == 10.5 && out[0].last_size == 100.0);
+    assert(out[1].symbol() == "TXT_B" && out[1].ask_price == 20.1 && out[1].sequence_id == 1);
+
+    // Bad lines are skipped, good ones still decoded
+    result = decoder.decode(as_bytes("TXT_A 1 2\nTXT_A 1 2 3 x\nTXT_A 1 2 3 4 5\nTXT_A 11 10.9 11.1 7"), rx, out);
+    assert(result.malformed && result.ticks == 1 && out[0].last_price == 11.0);
+
+    std::cout << "✅ Text decoder tests passed\n";
+}
+
+void test_udp_feed_handler() {
+    std::cout << "Testing UDP receiver and feed handler...\n";
+
+    UdpReceiverConfig config;
+    config.bind_address = "127.0.0.1";
+    config.batch_size = 8;
+    config.max_packet_bytes = 256;
+    config.busy_poll_us = 50;  // Granted or not depending on privileges; must not fail
+    UdpReceiver receiver(config);
+    assert(receiver.port() != 0 && receiver.max_batch() == 8);
+
+    std::vector<PacketView> views(8);
+    [[maybe_unused]] const std::size_t waiting = receiver.receive(views);
+    assert(waiting == 0);  // Nothing waiting, does not block
+
+    // Quotes arrive in order through the queue, stamped at receive
+    constexpr int PACKETS = 200;
+    LoopbackSender sender(receiver.port());
+    RtmdPacketBuilder builder;
+    builder.add_instrument(3, "UDP_A", 0.01);
+    [[maybe_unused]] bool sent = sender.send(builder.finish());
+    builder.clear();
+
+    SPSCQueue<Tick, 1024> queue;
+    FeedHandler<RtmdDecoder> handler(receiver);
+    [[maybe_unused]] const auto before = TickClock::now();
+    std::thread producer([&]() {
+        for (int i = 0; i < PACKETS; ++i) {
+            const double px = 100.0 + i * 0.01;
+            builder.add_tick(3, Tick{INVALID_SYMBOL_ID, px, px - 0.01, px + 0.01, 10.0, 0}, 0.01);
+            sender.send(builder.finish());
+            builder.clear();
+            if (i % 16 == 0) std::this_thread::yield();  // Stay inside the socket buffer
+        }
+    });
+
+    std::vector<Tick> ticks;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (ticks.size() < PACKETS && std::chrono::steady_clock::now() < deadline) {
+        handler.poll(queue);
+        Tick tick;
+        while (queue.pop(tick)) ticks.push_back(tick);
+    }
+    producer.join();
+
+    assert(ticks.size() == PACKETS);
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        assert(ticks[i].symbol() == "UDP_A");
+        assert(near(ticks[i].last_price, 100.0 + static_cast<double>(i) * 0.01));
+        assert(ticks[i].timestamp >= before);
+    }
+    assert(handler.packets_decoded() == PACKETS + 1 && handler.ticks_pushed() == PACKETS);
+    assert(handler.decoder().sequence_gaps() == 0 && handler.malformed_packets() == 0);
+    assert(receiver.packets_received() == PACKETS + 1 && receiver.receive_errors() == 0);
+
+    // Oversized datagrams are dropped and counted; junk is reported malformed
+    const std::vector<std::byte> oversized(config.max_packet_bytes + 1);
+    sent &= sender.send(oversized);
+    sent &= sender.send(as_bytes("not rtmd"));
+    for (int i = 0; i < 100 && handler.malformed_packets() == 0; ++i) {
+        handler.poll(queue);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(sent && receiver.packets_truncated() == 1 && handler.malformed_packets() == 1);
+
+    // A full queue drops rather than stalling the socket
+    SPSCQueue<Tick, 4> tiny;
+    RtmdPacketBuilder burst(builder.next_sequence());
+    for (int i = 0; i < 8; ++i) burst.add_tick(3, Tick{INVALID_SYMBOL_ID, 1.0, 0.99, 1.01, 1.0, 0}, 0.01);
+    sent &= sender.send(burst.finish());
+    for (int i = 0; i < 100 && handler.ticks_dropped() == 0; ++i) {
+        handler.poll(tiny);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(sent && handler.ticks_dropped() == 8 - tiny.size());
+
+    // run() with a blocking idle wait stops promptly
+    FeedHandlerConfig blocking;
+    blocking.wait = WaitStrategy::BLOCKING;
+    blocking.spin_iterations = 10;
+    FeedHandler<TextTickDecoder> text_handler(receiver, TextTickDecoder{}, blocking);
+    std::atomic<bool> running{true};
+    std::thread runner([&]() { text_handler.run(queue, running); });
+    sent &= sender.send(as_bytes("UDP_T 5 4.9 5.1 1\n"));
+    for (int i = 0; i < 1000 && text_handler.ticks_pushed() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    running.store(false, std::memory_order_release);
+    runner.join();
+    assert(sent && text_handler.ticks_pushed() == 1);
+
+    // Config errors surface at construction
+    [[maybe_unused]] int rejected = 0;
+    for (const auto& [bind_address, group] : {std::pair{"127.0.0.1", "10.0.0.1"}, std::pair{"not-an-ip", ""}}) {
+        UdpReceiverConfig bad;
+        bad.bind_address = bind_address;
+        bad.multicast_group = group;
+        try {
+            UdpReceiver receiver_with_bad_config(bad);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    assert(rejected == 2);
+
+    std::cout << "✅ UDP feed handler tests passed\n";
+}
+
+// A ShardedRouter with one full shard takes a prefix of each packet's ticks,
+// so the handler neither re-pushes delivered ticks nor loses the wrong ones
+void test_feed_handler_sharded_router() {
+    std::cout << "Testing feed handler into a sharded router...\n";
+
+    const SymbolId a = SymbolTable::intern_id("FH_SHARD_A");
+    const SymbolId b = SymbolTable::intern_id("FH_SHARD_B");
+    ShardedRouter router(2);
+    router.assign_symbol(a, 0);
+    router.assign_symbol(b, 1);
+    const std::vector<Tick> backlog(ShardedRouter::SHARD_QUEUE_SIZE - 1,
+                                    Tick{a, 1.0, 0.99, 1.01, 1.0, 0, TickClock::now()});
+    [[maybe_unused]] const std::size_t filled = router.try_push_n(backlog.data(), backlog.size());
+    assert(filled == backlog.size());
+
+    RtmdPacketBuilder builder;
+    [[maybe_unused]] bool added = builder.add_instrument(1, "FH_SHARD_A", 0.01);
+    added &= builder.add_instrument(2, "FH_SHARD_B", 0.01);
+    added &= builder.add_tick(2, Tick{INVALID_SYMBOL_ID, 10.0, 9.99, 10.01, 1.0, 0}, 0.01);
+    added &= builder.add_tick(1, Tick{INVALID_SYMBOL_ID, 20.0, 19.99, 20.01, 1.0, 0}, 0.01);
+    added &= builder.add_tick(2, Tick{INVALID_SYMBOL_ID, 10.5, 10.49, 10.51, 1.0, 0}, 0.01);
+    assert(added);
+    ScriptedPacketSource source;
+    source.add(builder.finish());
+
+    FeedHandler<RtmdDecoder> handler(source);
+    [[maybe_unused]] const std::size_t received = handler.poll(router);
+    assert(received == 1 && handler.malformed_packets() == 0);
+    assert(handler.ticks_pushed() == 1 && handler.ticks_dropped() == 2);
+
+    router.start();
+    router.stop();
+    assert(router.shard_router(0).ticks_processed() == backlog.size());
+    assert(router.shard_router(1).ticks_processed() == 1);
+
+    std::cout << "✅ Feed handler sharded router tests passed\n";
+}
+
+void run_network_tests() {
+    std::cout << "🧪 Running Network Feed Tests\n";
+    std::cout << "=============================\n";
+
+    test_rtmd_decoder();
+    test_text_decoder();
+    test_udp_feed_handler();
+    test_feed_handler_sharded_router();
+
+    std::cout << "\n✅ All network feed tests passed!\n\n";
+}
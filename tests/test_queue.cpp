@@ -1,5 +1,13 @@
 #include "md/spsc_queue.hpp"
+#include "md/mpmc_queue.hpp"
+#include "md/feed_sim.hpp"
 #include "md/tick.hpp"
+#include "md/compact_tick.hpp"
+#include "md/monte_carlo_feed.hpp"
+#include "md/overload_policy.hpp"
+#include "stats/cholesky.hpp"
+#include "stats/rolling_covar.hpp"
+#include "util/random.hpp"
 #include <iostream>
 #include <iomanip>
 #include <thread>
@@ -7,6 +15,10 @@
 #include <chrono>
 #include <vector>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
 
 // Simple test structure
 struct TestItem {
@@ -140,7 +152,7 @@ void test_spsc_with_ticks() {
     std::vector<Tick> test_ticks;
     for (int i = 0; i < 10; ++i) {
         test_ticks.emplace_back(
-            SymbolTable::intern("TEST"),
+            SymbolTable::intern_id("TEST"),
             100.0 + i,
             99.0 + i,
             101.0 + i,
@@ -158,7 +170,8 @@ void test_spsc_with_ticks() {
     Tick received_tick;
     for (size_t i = 0; i < test_ticks.size(); ++i) {
         assert(queue.pop(received_tick));
-        assert(received_tick.symbol == test_ticks[i].symbol);
+        assert(received_tick.symbol_id == test_ticks[i].symbol_id);
+        assert(received_tick.symbol() == "TEST");
         assert(received_tick.last_price == test_ticks[i].last_price);
         assert(received_tick.sequence_id == test_ticks[i].sequence_id);
     }
@@ -168,6 +181,520 @@ void test_spsc_with_ticks() {
     std::cout << "✅ SPSC Tick tests passed\n";
 }
 
+void test_spsc_batch() {
+    std::cout << "Testing SPSC queue batch operations...\n";
+
+    SPSCQueue<int, 8> queue;
+    int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    [[maybe_unused]] int out[10] = {};
+
+    // Partial push when the batch exceeds free space
+    [[maybe_unused]] size_t n = queue.try_push_n(in, 10);
+    assert(n == 7);
+    assert(queue.size() == 7);
+    n = queue.try_push_n(in, 1);
+    assert(n == 0);
+
+    n = queue.try_pop_n(out, 3);
+    assert(n == 3);
+    assert(out[0] == 0 && out[1] == 1 && out[2] == 2);
+
+    // Wraps around the end of the ring
+    n = queue.try_push_n(in + 7, 3);
+    assert(n == 3);
+    assert(queue.size() == 7);
+
+    int expected = 3;
+    n = queue.consume_all([&expected]([[maybe_unused]] int& value) {
+        assert(value == expected);
+        expected++;
+    });
+    assert(n == 7);
+    assert(expected == 10);
+    assert(queue.empty());
+    n = queue.try_pop_n(out, 10);
+    assert(n == 0);
+
+    // consume_all honours max_items
+    n = queue.try_push_n(in, 5);
+    assert(n == 5);
+    n = queue.consume_all([](int&) {}, 2);
+    assert(n == 2);
+    assert(queue.size() == 3);
+
+    std::cout << "✅ SPSC batch tests passed\n";
+}
+
+void test_spsc_batch_concurrency() {
+    std::cout << "Testing SPSC queue batch concurrency...\n";
+
+    static constexpr size_t NUM_ITEMS = 200000;
+    static constexpr size_t BATCH = 37;
+
+    SPSCQueue<size_t, 256> queue;
+
+    std::thread producer([&queue]() {
+        size_t batch[BATCH];
+        size_t next = 0;
+        while (next < NUM_ITEMS) {
+            const size_t n = std::min(BATCH, NUM_ITEMS - next);
+            for (size_t i = 0; i < n; ++i) batch[i] = next + i;
+            size_t pushed = 0;
+            while (pushed < n) {
+                const size_t accepted = queue.try_push_n(batch + pushed, n - pushed);
+                if (accepted == 0) std::this_thread::yield();
+                pushed += accepted;
+            }
+            next += n;
+        }
+    });
+
+    size_t expected = 0;
+    std::thread consumer([&queue, &expected]() {
+        while (expected < NUM_ITEMS) {
+            const size_t consumed = queue.consume_all([&expected]([[maybe_unused]] size_t& value) {
+                assert(value == expected);
+                expected++;
+            });
+            if (consumed == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    assert(expected == NUM_ITEMS);
+    assert(queue.empty());
+
+    std::cout << "✅ SPSC batch concurrency tests passed\n";
+}
+
+void test_mpmc_basic() {
+    std::cout << "Testing MPMC queue basic operations...\n";
+
+    MPMCQueue<TestItem, 8> queue;
+    TestItem item;
+
+    assert(queue.empty());
+    assert(queue.capacity() == 8);
+    [[maybe_unused]] bool ok = queue.pop(item);
+    assert(!ok);
+
+    for (int i = 0; i < 8; ++i) {
+        ok = queue.push(TestItem{i});
+        assert(ok);
+    }
+    ok = queue.push(TestItem{999});
+    assert(!ok); // Full
+    assert(queue.size() == 8);
+    assert(queue.fill_ratio() == 1.0);
+
+    // FIFO across several laps of the ring
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 8; ++i) {
+            ok = queue.pop(item);
+            assert(ok && item.value == lap * 100 + i);
+            ok = queue.push(TestItem{(lap + 1) * 100 + i});
+            assert(ok);
+        }
+    }
+
+    [[maybe_unused]] size_t drained = queue.consume_all([](TestItem&) {});
+    assert(drained == 8);
+    assert(queue.empty());
+
+    std::cout << "✅ MPMC basic tests passed\n";
+}
+
+void test_mpsc_fan_in() {
+    std::cout << "Testing MPSC fan-in from several producers...\n";
+
+    static constexpr int NUM_PRODUCERS = 4;
+    static constexpr int ITEMS_PER_PRODUCER = 50000;
+
+    // Encode producer in the high bits so per-producer order can be checked
+    MPSCQueue<uint64_t, 1024> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (uint64_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                const uint64_t item = (static_cast<uint64_t>(p) << 32) | i;
+                while (!queue.push(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint64_t> next_expected(NUM_PRODUCERS, 0);
+    int received = 0;
+    while (received < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+        const size_t n = queue.consume_all([&](uint64_t& item) {
+            const auto producer = static_cast<size_t>(item >> 32);
+            [[maybe_unused]] const uint64_t seq = item & 0xFFFFFFFFull;
+            assert(seq == next_expected[producer]);
+            next_expected[producer]++;
+        });
+        if (n == 0) std::this_thread::yield();
+        received += static_cast<int>(n);
+    }
+
+    for (auto& producer : producers) producer.join();
+
+    for ([[maybe_unused]] const auto expected : next_expected) {
+        assert(expected == ITEMS_PER_PRODUCER);
+    }
+    assert(queue.empty());
+
+    std::cout << "✅ MPSC fan-in tests passed\n";
+}
+
+void test_mpmc_feed_simulators() {
+    std::cout << "Testing MPMC queue fed by several FeedSimulators...\n";
+
+    // One simulator per venue, all feeding one queue
+    MPMCQueue<Tick, 1024> queue;
+    FeedSimulator venue_a({SymbolConfig{"MPMC_A1"}, SymbolConfig{"MPMC_A2"}});
+    FeedSimulator venue_b({SymbolConfig{"MPMC_B1"}});
+
+    std::thread feed_a([&]() { for (int i = 0; i < 100; ++i) venue_a.generate_ticks(queue); });
+    std::thread feed_b([&]() { for (int i = 0; i < 100; ++i) venue_b.generate_ticks(queue); });
+    feed_a.join();
+    feed_b.join();
+
+    size_t received = 0;
+    while (queue.consume_all([&received]([[maybe_unused]] Tick& tick) {
+        assert(tick.is_valid());
+        received++;
+    }) > 0) {}
+
+    assert(received == venue_a.ticks_generated() + venue_b.ticks_generated());
+    assert(venue_a.ticks_generated() + venue_a.ticks_dropped() == 200);
+
+    std::cout << "✅ MPMC feed simulator tests passed\n";
+}
+
+void test_compact_tick() {
+    std::cout << "Testing CompactTick encoding...\n";
+
+    static_assert(sizeof(CompactTick) * 2 == 64);
+
+    const SymbolId es = SymbolTable::intern_id("COMPACT_ES");
+    const auto epoch = TickClock::now();
+    TickCodec codec(epoch);
+    codec.set_tick_size(es, 0.25);
+
+    // Round trip on the grid is exact
+    const Tick tick(es, 5000.25, 5000.00, 5000.50, 12.0, (1ull << 32) + 7,
+                    epoch + std::chrono::microseconds(1500));
+    CompactTick compact;
+    [[maybe_unused]] bool encoded = codec.encode(tick, compact);
+    assert(encoded);
+    assert(compact.last_px == 20001 && compact.bid_offset == 1 && compact.ask_offset == 1);
+
+    [[maybe_unused]] const Tick decoded = codec.decode(compact);
+    assert(decoded.symbol_id == es);
+    assert(decoded.last_price == 5000.25 && decoded.bid_price == 5000.00 && decoded.ask_price == 5000.50);
+    assert(decoded.last_size == 12.0);
+    assert(decoded.timestamp == tick.timestamp);
+    assert(decoded.sequence_id == 7);  // Low 32 bits only
+
+    // A spread wider than the 16-bit offsets is rejected
+    const Tick wide(es, 10000.0, 1.0, 10000.5, 1.0, 1);
+    encoded = codec.encode(wide, compact);
+    assert(!encoded);
+
+    // FeedSimulator encodes for CompactTick queues with its own tick sizes
+    SymbolConfig config{"COMPACT_NQ", 18000.0, 0.2};
+    config.tick_size = 0.25;
+    FeedSimulator feed({config});
+    SPSCQueue<CompactTick, 256> queue;
+    for (int i = 0; i < 100; ++i) feed.generate_ticks(queue);
+    assert(feed.ticks_generated() == 100);
+
+    const TickCodec& feed_codec = feed.codec();
+    while (queue.consume_all([&feed_codec]([[maybe_unused]] const CompactTick& c) {
+        [[maybe_unused]] const Tick t = feed_codec.decode(c);
+        assert(t.is_valid());
+        assert(t.symbol() == "COMPACT_NQ");
+        assert(std::fmod(t.last_price, 0.25) == 0.0);
+    }) > 0) {}
+
+    std::cout << "✅ CompactTick tests passed\n";
+}
+
+void test_batched_rng() {
+    std::cout << "Testing xoshiro streams and batched normals...\n";
+
+    // Split streams are distinct and reproducible
+    Xoshiro256 parent(7);
+    Xoshiro256 a = parent.split();
+    [[maybe_unused]] Xoshiro256 b = parent.split();
+    Xoshiro256 again(7);
+    [[maybe_unused]] const uint64_t first = a();
+    assert(first != b());
+    assert(first == again());
+
+    constexpr std::size_t N = 200001;  // Odd, to cover the unpaired tail
+    std::vector<double> draws(N);
+    Xoshiro256x4 rng(11);
+    rng.fill_uniform(draws.data(), N);
+    assert(*std::min_element(draws.begin(), draws.end()) > 0.0);
+    assert(*std::max_element(draws.begin(), draws.end()) <= 1.0);
+
+    // The vectorizable kernels track libm to within a few ulp
+    Xoshiro256 grid(5);
+    for (int i = 0; i < 100000; ++i) {
+        const double u = i < 64 ? std::ldexp(1.0, -i) : grid.uniform();
+        double sin_theta, cos_theta;
+        unit_turn_sincos(u, sin_theta, cos_theta);
+        assert(std::abs(unit_log(u) - std::log(u)) <= 1e-15 * std::max(1.0, std::abs(std::log(u))));
+        assert(std::abs(sin_theta - std::sin(2.0 * std::numbers::pi * u)) < 2e-15);
+        assert(std::abs(cos_theta - std::cos(2.0 * std::numbers::pi * u)) < 2e-15);
+    }
+
+    rng.fill_normal(draws.data(), N);
+    double sum = 0.0, sum_sq = 0.0;
+    for (const double x : draws) {
+        sum += x;
+        sum_sq += x * x;
+    }
+    [[maybe_unused]] const double mean = sum / N;
+    [[maybe_unused]] const double variance = sum_sq / N - mean * mean;
+    assert(std::abs(mean) < 0.01);
+    assert(std::abs(variance - 1.0) < 0.02);
+
+    std::cout << "✅ Batched RNG tests passed\n";
+}
+
+void test_monte_carlo_feed() {
+    std::cout << "Testing MonteCarloFeed parallel path generation...\n";
+
+    std::vector<SymbolConfig> paths;
+    for (int i = 0; i < 1000; ++i) {
+        paths.emplace_back("MC" + std::to_string(i), 100.0 + i % 50, 200.0);
+    }
+
+    // Same seed, different thread counts: identical paths
+    MonteCarloConfig config;
+    config.seed = 99;
+    config.threads = 1;
+    MonteCarloFeed single(paths, config);
+    config.threads = 3;
+    MonteCarloFeed parallel(paths, config);
+    assert(parallel.threads() == 3);
+
+    // Sinks run on the workers: keep state per worker
+    std::vector<uint64_t> per_worker(parallel.threads(), 0);
+    std::vector<uint64_t> invalid(parallel.threads(), 0);
+    [[maybe_unused]] const uint64_t generated = parallel.run(200, [&](unsigned worker, const Tick* ticks, std::size_t n) {
+        per_worker[worker] += n;
+        for (std::size_t i = 0; i < n; ++i) invalid[worker] += !ticks[i].is_valid();
+    });
+    single.run(200, []([[maybe_unused]] unsigned worker, const Tick*, std::size_t) {});
+
+    assert(std::count(invalid.begin(), invalid.end(), 0) == 3);
+    assert(generated == 200 * 1000);
+    assert(per_worker[0] + per_worker[1] + per_worker[2] == generated);
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        assert(single.price(i) == parallel.price(i));
+    }
+    assert(single.price(0) != 100.0);  // Paths actually moved
+
+    // Throughput, single-threaded, for the log
+    std::vector<SymbolConfig> many;
+    for (int i = 0; i < 4096; ++i) many.emplace_back("MCT" + std::to_string(i), 100.0, 0.3);
+    config.threads = 1;
+    MonteCarloFeed bench(std::move(many), config);
+    uint64_t sink_count = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t ticks = bench.run(100, [&sink_count](unsigned, const Tick*, std::size_t n) { sink_count += n; });
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  Rate: " << std::fixed << std::setprecision(0)
+              << static_cast<double>(ticks) / seconds << " ticks/sec per thread\n";
+    assert(sink_count == ticks);
+
+    std::cout << "✅ MonteCarloFeed tests passed\n";
+}
+
+void test_correlated_feed() {
+    std::cout << "Testing correlated FeedSimulator shocks...\n";
+
+    // Cholesky factor reproduces the matrix
+    const std::vector<double> matrix = {1.0, 0.8, 0.1,
+                                        0.8, 1.0, 0.0,
+                                        0.1, 0.0, 1.0};
+    const auto l = cholesky_lower(matrix, 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < 3; ++k) sum += l[i * 3 + k] * l[j * 3 + k];
+            assert(std::abs(sum - matrix[i * 3 + j]) < 1e-12);
+        }
+    }
+
+    std::vector<SymbolConfig> configs;
+    for (const char* name : {"CORR_A", "CORR_B", "CORR_C"}) {
+        SymbolConfig config{name, 100.0, 200.0};
+        config.tick_size = 1e-9;  // Fine grid: returns are not quantized away
+        configs.push_back(config);
+    }
+    FeedSimulator feed(configs);
+    feed.set_pair_correlation("CORR_A", "CORR_B", 0.8);
+
+    // Not positive definite / not a correlation matrix
+    [[maybe_unused]] int rejected = 0;
+    for (const auto& bad : {std::vector<double>{1.0, 0.9, 0.9, 0.9, 1.0, -0.9, 0.9, -0.9, 1.0},
+                            std::vector<double>{2.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0},
+                            std::vector<double>{1.0, 0.5}}) {
+        try {
+            feed.set_correlation_matrix(bad);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    assert(rejected == 3);
+    assert(feed.correlation_matrix()[1] == 0.8);  // Failed updates keep the old factor
+
+    SPSCQueue<Tick, 8> queue;
+    double last[3] = {100.0, 100.0, 100.0};
+    RollingCovar ab, ac;
+    for (int step = 0; step < 5000; ++step) {
+        feed.generate_ticks(queue);
+        double returns[3];
+        Tick tick;
+        for (auto& r : returns) {
+            [[maybe_unused]] const bool popped = queue.pop(tick);
+            assert(popped);
+            const std::size_t i = static_cast<std::size_t>(&r - returns);
+            r = tick.last_price / last[i] - 1.0;
+            last[i] = tick.last_price;
+        }
+        ab.add(returns[0], returns[1]);
+        ac.add(returns[0], returns[2]);
+    }
+    assert(std::abs(ab.correlation() - 0.8) < 0.05);
+    assert(std::abs(ac.correlation()) < 0.05);
+
+    std::cout << "✅ Correlated feed tests passed\n";
+}
+
+void test_overload_policies() {
+    std::cout << "Testing overload policies...\n";
+
+    QueueDepthHistogram depth;
+    for (std::size_t d : {0, 1, 2, 3, 100}) depth.record(d);
+    assert(depth.samples() == 5);
+    assert(depth.count(0) == 1 && depth.count(1) == 1 && depth.count(2) == 2 && depth.count(7) == 1);
+    assert(depth.quantile(0.5) == 3);
+    assert(depth.quantile(1.0) == 100 && depth.max() == 100);
+
+    const SymbolId a = SymbolTable::intern_id("OVL_A");
+    const SymbolId b = SymbolTable::intern_id("OVL_B");
+    const SymbolId c = SymbolTable::intern_id("OVL_C");
+    const auto stamp = TickClock::now();
+    auto tick = [&](SymbolId symbol, uint64_t sequence) {
+        return Tick(symbol, 100.0, 99.9, 100.1, 10.0, sequence, stamp);
+    };
+
+    // Conflation: overflow parks per symbol, newer ticks replace parked ones
+    {
+        SPSCQueue<Tick, 8> queue;  // 7 slots
+        OverloadConfig config;
+        config.policy = OverloadPolicy::CONFLATE;
+        OverloadController overload(config);
+
+        std::vector<Tick> backlog(7, tick(c, 1));
+        [[maybe_unused]] PublishResult result = overload.publish(queue, backlog.data(), backlog.size());
+        assert(result.delivered == 7 && result.lost == 0);
+
+        const Tick burst[] = {tick(a, 10), tick(b, 11), tick(a, 12)};
+        result = overload.publish(queue, burst, 3);
+        assert(result.delivered == 0 && result.lost == 1);
+        assert(overload.parked() == 2 && overload.ticks_conflated() == 1);
+
+        const Tick late = tick(c, 13);
+        result = overload.publish(queue, &late, 1);
+        assert(result.delivered == 0 && result.lost == 0 && overload.parked() == 3);
+
+        Tick out;
+        for (int i = 0; i < 5; ++i) {
+            [[maybe_unused]] const bool popped = queue.pop(out);
+        }
+        [[maybe_unused]] const std::size_t flushed = overload.flush(queue);
+        assert(flushed == 3 && overload.parked() == 0);
+
+        std::vector<uint64_t> sequences;
+        while (queue.pop(out)) sequences.push_back(out.sequence_id);
+        assert((sequences == std::vector<uint64_t>{1, 1, 12, 11, 13}));
+    }
+
+    // Bounded spin-retry, then drop
+    {
+        SPSCQueue<Tick, 4> queue;
+        OverloadConfig config;
+        config.spin_retries = 5;
+        OverloadController overload(config);
+
+        const Tick ticks[] = {tick(a, 1), tick(a, 2), tick(a, 3), tick(a, 4)};
+        [[maybe_unused]] const PublishResult result = overload.publish(queue, ticks, 4);
+        assert(result.delivered == 3 && result.lost == 1);
+        assert(overload.spin_retries() == 5 && overload.parked() == 0);
+    }
+
+    // Water marks fire once per crossing
+    {
+        SPSCQueue<Tick, 8> queue;
+        std::vector<std::pair<bool, std::size_t>> events;
+        OverloadConfig config;
+        config.high_water_mark = 0.5;
+        config.low_water_mark = 0.2;
+        config.on_pressure = [&events](bool high, std::size_t d) { events.emplace_back(high, d); };
+        OverloadController overload(std::move(config));
+
+        const Tick ticks[] = {tick(b, 1), tick(b, 2), tick(b, 3), tick(b, 4)};
+        [[maybe_unused]] const PublishResult result = overload.publish(queue, ticks, 4);
+        overload.sample(queue);
+        overload.sample(queue);
+        assert(events.size() == 1 && events[0] == std::make_pair(true, std::size_t{4}));
+        assert(overload.above_high_water());
+
+        Tick out;
+        for (int i = 0; i < 3; ++i) {
+            [[maybe_unused]] const bool popped = queue.pop(out);
+        }
+        overload.sample(queue);
+        assert(events.size() == 2 && events[1] == std::make_pair(false, std::size_t{1}));
+        assert(overload.queue_depth().samples() == 3);
+    }
+
+    // FeedSimulator into a CompactTick ring: a stalled consumer sees the
+    // newest tick per symbol once it drains
+    {
+        SPSCQueue<CompactTick, 8> queue;
+        FeedSimulator feed({SymbolConfig{"OVL_F1"}, SymbolConfig{"OVL_F2"}, SymbolConfig{"OVL_F3"}});
+        OverloadConfig config;
+        config.policy = OverloadPolicy::CONFLATE;
+        feed.set_overload_config(config);
+
+        for (int step = 0; step < 10; ++step) feed.generate_ticks(queue);
+        assert(feed.ticks_generated() == 7);
+        assert(feed.overload().parked() == 3);
+        assert(feed.ticks_generated() + feed.ticks_dropped() + feed.overload().parked() == 30);
+        assert(feed.queue_depth().samples() == 10 && feed.queue_depth().max() == 7);
+
+        CompactTick out;
+        while (queue.pop(out)) {}
+        feed.generate_ticks(queue);
+        std::vector<uint64_t> sequences;
+        while (queue.pop(out)) sequences.push_back(feed.codec().decode(out).sequence_id);
+        assert((sequences == std::vector<uint64_t>{10, 10, 10, 11, 11, 11}));
+        assert(feed.ticks_generated() + feed.ticks_dropped() == 33);
+    }
+
+    std::cout << "✅ Overload policy tests passed\n";
+}
+
 void test_spsc_performance() {
     std::cout << "Testing SPSC queue performance...\n";
 
@@ -213,6 +740,16 @@ void run_queue_tests() {
     test_spsc_move_semantics();
     test_spsc_concurrency();
     test_spsc_with_ticks();
+    test_spsc_batch();
+    test_spsc_batch_concurrency();
+    test_mpmc_basic();
+    test_mpsc_fan_in();
+    test_mpmc_feed_simulators();
+    test_compact_tick();
+    test_batched_rng();
+    test_monte_carlo_feed();
+    test_correlated_feed();
+    test_overload_policies();
     test_spsc_performance();
 
     std::cout << "\n✅ All queue tests passed!\n\n";
@@ -230,6 +767,26 @@ int main() {
     // Run queue tests
     run_queue_tests();
 
+    // Run router tests
+    void run_router_tests();
+    run_router_tests();
+
+    // Run latency tests
+    void run_latency_tests();
+    run_latency_tests();
+
+    // Run journal tests
+    void run_journal_tests();
+    run_journal_tests();
+
+    // Run metrics tests
+    void run_metrics_tests();
+    run_metrics_tests();
+
+    // Run network feed tests
+    void run_network_tests();
+    run_network_tests();
+
     std::cout << "🎉 All tests completed successfully!\n";
     std::cout << "Your C++ skills are looking solid! 💪\n";
 
@@ -0,0 +1,910 @@
+#include "engine/backtest.hpp"
+#include "engine/consumer_runner.hpp"
+#include "engine/correlation_matrix.hpp"
+#include "engine/router.hpp"
+#include "engine/sharded_router.hpp"
+#include "engine/signal_dispatcher.hpp"
+#include "md/feed_sim.hpp"
+#include "md/overload_policy.hpp"
+#include "md/spsc_queue.hpp"
+#include "md/tick.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <thread>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+void test_symbol_table_ids() {
+    std::cout << "Testing SymbolTable dense ids...\n";
+
+    const SymbolId a = SymbolTable::intern_id("IDTEST_A");
+    [[maybe_unused]] const SymbolId b = SymbolTable::intern_id("IDTEST_B");
+
+    assert(a != INVALID_SYMBOL_ID && b != INVALID_SYMBOL_ID);
+    assert(a != b);
+    assert(SymbolTable::intern_id("IDTEST_A") == a); // Stable
+    assert(SymbolTable::find("IDTEST_B") == b);
+    assert(SymbolTable::find("IDTEST_NEVER_SEEN") == INVALID_SYMBOL_ID);
+    assert(SymbolTable::name(a) == "IDTEST_A");
+    assert(SymbolTable::intern("IDTEST_B") == SymbolTable::name(b));
+
+    Tick tick{a, 100.0, 99.9, 100.1, 10.0, 1};
+    assert(tick.symbol() == "IDTEST_A");
+    assert(tick.is_valid());
+    assert(!Tick{}.is_valid());
+
+    std::cout << "✅ SymbolTable id tests passed\n";
+}
+
+void test_symbol_table_concurrent_intern() {
+    std::cout << "Testing SymbolTable concurrent interning...\n";
+
+    constexpr int NUM_THREADS = 8;
+    constexpr int NUM_SYMBOLS = 2000;
+
+    assert(SymbolTable::capacity() >= 10000);
+    assert(!SymbolTable::reserve(SymbolTable::capacity() + 1)); // Too late to grow
+
+    std::vector<std::string> names;
+    for (int i = 0; i < NUM_SYMBOLS; ++i) {
+        names.push_back("CONC_" + std::to_string(i));
+    }
+
+    // Every thread interns every symbol, each in a different order
+    std::vector<std::vector<SymbolId>> ids(NUM_THREADS, std::vector<SymbolId>(NUM_SYMBOLS));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&names, &ids, t]() {
+            for (int k = 0; k < NUM_SYMBOLS; ++k) {
+                const int i = (k * 7 + t * 131) % NUM_SYMBOLS;
+                ids[t][i] = SymbolTable::intern_id(names[i]);
+                assert(SymbolTable::name(ids[t][i]) == names[i]);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // All threads agree, and each symbol got exactly one id
+    std::vector<SymbolId> sorted = ids[0];
+    for (int t = 1; t < NUM_THREADS; ++t) {
+        assert(ids[t] == ids[0]);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    assert(sorted.back() < SymbolTable::size());
+
+    [[maybe_unused]] const auto entry = SymbolTable::intern_entry("CONC_42");
+    assert(entry.id == ids[0][42]);
+    assert(entry.name == "CONC_42");
+
+    std::cout << "✅ SymbolTable concurrency tests passed\n";
+}
+
+void test_router_signals_carry_ids() {
+    std::cout << "Testing Router id-based signal routing...\n";
+
+    const SymbolId x = SymbolTable::intern_id("RTR_X");
+    const SymbolId y = SymbolTable::intern_id("RTR_Y");
+
+    Router router;
+    router.set_zscore_threshold(2.0);
+    router.add_watched_pair("RTR_X", "RTR_Y");
+
+    std::vector<SignalEvent> events;
+    router.set_signal_callback([&events](const SignalEvent& event) {
+        events.push_back(event);
+    });
+
+    // Stable prices, then a large jump on X to trip the z-score rule
+    for (int i = 0; i < 100; ++i) {
+        const double px = 100.0 + (i % 2) * 0.01;
+        router.process_tick(Tick{x, px, px - 0.01, px + 0.01, 100.0, static_cast<uint64_t>(i)});
+        router.process_tick(Tick{y, 2 * px, 2 * px - 0.01, 2 * px + 0.01, 100.0, static_cast<uint64_t>(i)});
+    }
+    router.process_tick(Tick{x, 150.0, 149.99, 150.01, 100.0, 100});
+
+    assert(router.ticks_processed() == 201);
+
+    [[maybe_unused]] bool saw_zscore = false;
+    for (const auto& event : events) {
+        if (event.event_type == SignalEvent::Type::Z_SCORE_BREAK && event.primary_id == x) {
+            assert(event.primary_symbol == "RTR_X");
+            assert(event.secondary_id == INVALID_SYMBOL_ID);
+            assert(event.secondary_symbol.empty());
+            saw_zscore = true;
+        }
+        if (event.event_type == SignalEvent::Type::CORRELATION_BREAK) {
+            assert(event.primary_id == x && event.secondary_id == y);
+        }
+    }
+    assert(saw_zscore);
+
+    // Correlation lookups work in either order, by name or by id
+    [[maybe_unused]] const double corr = router.get_correlation("RTR_X", "RTR_Y");
+    assert(std::isfinite(corr));
+    assert(router.get_correlation(y, x) == corr);
+    assert(router.get_correlation("RTR_X", "RTR_UNKNOWN") == 0.0);
+
+    std::cout << "✅ Router id routing tests passed\n";
+}
+
+void test_zscore_rule_window() {
+    std::cout << "Testing ZScoreRule sliding window...\n";
+
+    // After a level shift, a windowed rule re-centres and stops firing
+    ZScoreRule windowed(2.0, 50);
+    for (int i = 0; i < 5000; ++i) windowed.add_observation(100.0 + (i % 2) * 0.1);
+    for (int i = 0; i < 50; ++i) windowed.add_observation(110.0 + (i % 2) * 0.1);
+
+    [[maybe_unused]] double strength = 0.0;
+    assert(!windowed.evaluate(strength));
+    assert(std::abs(strength) < 2.0);
+    assert(windowed.window() == 50);
+
+    std::cout << "✅ ZScoreRule window tests passed\n";
+}
+
+void test_router_pair_index() {
+    std::cout << "Testing Router pair adjacency...\n";
+
+    Router router;
+    router.set_correlation_threshold(1.1); // Every evaluation fires once warmed up
+    std::vector<SignalEvent> events;
+    router.set_signal_callback([&events](const SignalEvent& event) {
+        if (event.event_type == SignalEvent::Type::CORRELATION_BREAK) events.push_back(event);
+    });
+
+    // Chain A-B, B-C plus many unrelated pairs
+    const SymbolId a = SymbolTable::intern_id("ADJ_A");
+    const SymbolId b = SymbolTable::intern_id("ADJ_B");
+    const SymbolId c = SymbolTable::intern_id("ADJ_C");
+    router.add_watched_pair(a, b);
+    router.add_watched_pair(c, b); // b is the second leg here
+    for (int i = 0; i < 500; ++i) {
+        router.add_watched_pair("ADJ_FILL_" + std::to_string(i), "ADJ_FILL_" + std::to_string(i + 1));
+    }
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        const double x = 100.0 + std::sin(static_cast<double>(i) * 0.05);
+        router.process_tick(Tick{a, x, x - 0.01, x + 0.01, 100.0, i});
+        router.process_tick(Tick{b, 2.0 * x, 2.0 * x - 0.01, 2.0 * x + 0.01, 100.0, i});
+        router.process_tick(Tick{c, 300.0 - x, 299.99 - x, 300.01 - x, 100.0, i});
+    }
+
+    // Legs are fed in registration order whichever one ticked
+    assert(router.get_correlation(a, b) > 0.99);
+    assert(router.get_correlation(c, b) < -0.99);
+    assert(!events.empty());
+    for ([[maybe_unused]] const auto& event : events) {
+        assert((event.primary_id == a && event.secondary_id == b) ||
+               (event.primary_id == c && event.secondary_id == b));
+    }
+
+    // Unrelated pairs never saw a tick
+    assert(router.get_correlation("ADJ_FILL_0", "ADJ_FILL_1") == 0.0);
+
+    std::cout << "✅ Router pair adjacency tests passed\n";
+}
+
+void test_router_reserve() {
+    std::cout << "Testing Router arena and reserve...\n";
+
+    // Blocks come out cache-line aligned; reserve() makes later ones chunk-free
+    Arena arena(256);
+    [[maybe_unused]] void* first = arena.allocate(100, 64);
+    assert(reinterpret_cast<uintptr_t>(first) % 64 == 0);
+    assert(reinterpret_cast<uintptr_t>(arena.allocate(8, 64)) % 64 == 0);
+    arena.reserve(10 * 128);
+    [[maybe_unused]] const std::size_t chunks = arena.chunk_count();
+    for (int i = 0; i < 10; ++i) [[maybe_unused]] void* p = arena.allocate(128, 64);
+    assert(arena.chunk_count() == chunks);
+    assert(arena.bytes_used() == 100 + 8 + 10 * 128);
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 64; ++i) names.push_back("RSV_" + std::to_string(i));
+
+    // Same ticks through a lazily growing Router and a reserved, pre-registered one
+    Router lazy;
+    Router eager;
+    eager.reserve(names.size(), names.size() / 2);
+    [[maybe_unused]] const std::size_t reserved = eager.rule_memory_bytes();
+    for (const auto& name : names) eager.add_symbol(name);
+    assert(eager.has_symbol(SymbolTable::find(names.back())));
+    assert(!lazy.has_symbol(SymbolTable::find(names.back())));
+
+    std::vector<SignalEvent> lazy_events;
+    std::vector<SignalEvent> eager_events;
+    lazy.set_signal_callback([&lazy_events](const SignalEvent& e) { lazy_events.push_back(e); });
+    eager.set_signal_callback([&eager_events](const SignalEvent& e) { eager_events.push_back(e); });
+    for (std::size_t i = 0; i + 1 < names.size(); i += 2) {
+        lazy.add_watched_pair(names[i], names[i + 1]);
+        eager.add_watched_pair(names[i], names[i + 1]);
+    }
+
+    for (uint64_t step = 0; step < 400; ++step) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            const double x = 100.0 + std::sin(static_cast<double>(step * (i + 1)) * 0.01) * (i % 7 + 1);
+            const double volume = 100.0 + static_cast<double>((step * 31 + i * 17) % 97);
+            const Tick tick{SymbolTable::find(names[i]), x, x - 0.01, x + 0.01, volume, step};
+            lazy.process_tick(tick);
+            eager.process_tick(tick);
+        }
+    }
+
+    // Nothing was allocated for rules after reserve(), and results match
+    assert(eager.rule_memory_bytes() == reserved);
+    assert(lazy.rule_memory_bytes() > 0);
+    assert(!eager_events.empty());
+    assert(eager_events.size() == lazy_events.size());
+    for (std::size_t i = 0; i < eager_events.size(); ++i) {
+        assert(eager_events[i].event_type == lazy_events[i].event_type);
+        assert(eager_events[i].primary_id == lazy_events[i].primary_id);
+        assert(eager_events[i].signal_strength == lazy_events[i].signal_strength);
+    }
+    assert(eager.get_correlation(names[0], names[1]) == lazy.get_correlation(names[0], names[1]));
+
+    // reset_stats clears windows held in the arena
+    eager.reset_stats();
+    eager_events.clear();
+    eager.process_tick(Tick{SymbolTable::find(names[0]), 100.0, 99.99, 100.01, 100.0, 0});
+    assert(eager_events.empty());
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        eager.add_symbol(INVALID_SYMBOL_ID);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Router arena and reserve tests passed\n";
+}
+
+void test_signal_dispatcher() {
+    std::cout << "Testing SignalDispatcher...\n";
+
+    // A slow sink runs on its own drain thread; every signal still arrives, in order
+    SignalDispatcher dispatcher;
+    std::vector<uint64_t> received;
+    std::atomic<uint64_t> second_sink{0};
+    dispatcher.add_sink([&received](const SignalEvent& event) {
+        received.push_back(event.signal_id);
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    });
+    dispatcher.add_sink([&second_sink](const SignalEvent&) {
+        second_sink.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    Router router;
+    router.set_zscore_threshold(0.0); // Fires on nearly every tick
+    router.set_signal_dispatcher(&dispatcher);
+    dispatcher.start();
+
+    const SymbolId id = SymbolTable::intern_id("DISP_X");
+    for (uint64_t i = 0; i < 2000; ++i) {
+        const double price = 100.0 + static_cast<double>(i % 10);
+        router.process_tick(Tick{id, price, price - 0.01, price + 0.01, 100.0, i});
+    }
+    dispatcher.stop();
+
+    [[maybe_unused]] const uint64_t generated = router.signals_generated();
+    assert(generated > 1000);
+    assert(dispatcher.published() + dispatcher.dropped() == generated);
+    assert(dispatcher.delivered() == dispatcher.published());
+    assert(received.size() == dispatcher.delivered());
+    assert(second_sink.load() == dispatcher.delivered());
+    assert(std::is_sorted(received.begin(), received.end()));
+    assert(dispatcher.sink_count() == 2 && dispatcher.sink_dropped(0) == 0);
+
+    std::cout << "✅ SignalDispatcher tests passed\n";
+}
+
+void test_signal_dispatcher_slow_sink() {
+    std::cout << "Testing SignalDispatcher with a stalled sink...\n";
+
+    // The journal sink stalls; the gateway sink keeps receiving signals, and
+    // only the stalled sink misses the ones its full ring cannot take
+    SignalDispatcher dispatcher;
+    std::atomic<bool> release{false};
+    std::atomic<uint64_t> journal{0};
+    std::atomic<uint64_t> gateway{0};
+    dispatcher.add_sink([&](const SignalEvent&) {
+        while (!release.load(std::memory_order_acquire)) std::this_thread::yield();
+        journal.fetch_add(1, std::memory_order_relaxed);
+    });
+    dispatcher.add_sink([&gateway](const SignalEvent&) {
+        gateway.fetch_add(1, std::memory_order_relaxed);
+    });
+    dispatcher.start();
+
+    const SymbolId id = SymbolTable::intern_id("DISP_SLOW");
+    const SignalEvent event(SignalEvent::Type::Z_SCORE_BREAK, id, id, 3.0, 0.9);
+    constexpr uint64_t BURST = 100;
+    for (uint64_t i = 0; i < BURST; ++i) {
+        [[maybe_unused]] const bool published = dispatcher.publish(event);
+        assert(published);
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (gateway.load() < BURST && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    assert(gateway.load() == BURST && journal.load() == 0);
+    assert(dispatcher.sink_delivered(1) == BURST && dispatcher.delivered() == 0);
+
+    // Overfill the stalled ring in chunks the gateway keeps up with: the
+    // gateway still gets every signal
+    const uint64_t overfill = SignalDispatcher::RING_SIZE + 100;
+    [[maybe_unused]] uint64_t rejected = 0;
+    for (uint64_t i = 0; i < overfill; ++i) {
+        if (!dispatcher.publish(event)) ++rejected;
+        if (i % 1000 == 999) {
+            while (gateway.load() < BURST + i + 1 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    assert(rejected > 0 && dispatcher.sink_dropped(0) == rejected && dispatcher.sink_dropped(1) == 0);
+    assert(dispatcher.dropped() == rejected && dispatcher.published() == BURST + overfill - rejected);
+
+    release.store(true, std::memory_order_release);
+    dispatcher.stop();
+    assert(gateway.load() == BURST + overfill);
+    assert(journal.load() == BURST + overfill - rejected);
+    assert(dispatcher.delivered() == dispatcher.published());
+
+    std::cout << "✅ SignalDispatcher stalled sink tests passed\n";
+}
+
+void test_signal_gate_modes() {
+    std::cout << "Testing SignalGate emission modes...\n";
+
+    // Raw rule output: below, three ticks over, a dip just under, over again,
+    // then well clear and over once more
+    const bool fired[] =    {false, true, true, true, false, true, false, true};
+    const double margin[] = {-1.0,  0.5,  0.8,  0.2, -0.1,  0.3, -2.0,  0.1};
+    [[maybe_unused]] auto run = [&](const EmissionPolicy& policy) {
+        SignalGate gate;
+        std::vector<int> emitted;
+        const auto start = TickClock::now();
+        for (int i = 0; i < 8; ++i) {
+            if (gate.admit(policy, fired[i], margin[i], start + std::chrono::milliseconds(i))) {
+                emitted.push_back(i);
+            }
+        }
+        return emitted;
+    };
+
+    assert((run(EmissionPolicy::level()) == std::vector<int>{1, 2, 3, 5, 7}));
+    assert((run(EmissionPolicy::edge()) == std::vector<int>{1, 5, 7}));
+    // The dip at 4 is inside the 0.5 band, so 5 is the same excursion
+    assert((run(EmissionPolicy::hysteresis(0.5)) == std::vector<int>{1, 7}));
+    assert((run(EmissionPolicy::rate_limited(std::chrono::milliseconds(3))) == std::vector<int>{1, 5}));
+
+    // Router applies the policy per signal type; a steady breakdown is reported once
+    Router router;
+    router.set_correlation_threshold(1.1); // Always "broken" once warmed up
+    router.set_emission_policy(SignalEvent::Type::CORRELATION_BREAK, EmissionPolicy::edge());
+    assert(router.emission_policy(SignalEvent::Type::CORRELATION_BREAK).mode == EmissionMode::EDGE);
+    assert(router.emission_policy(SignalEvent::Type::Z_SCORE_BREAK).mode == EmissionMode::LEVEL);
+
+    std::size_t corr_breaks = 0;
+    router.set_signal_callback([&corr_breaks](const SignalEvent& event) {
+        if (event.event_type == SignalEvent::Type::CORRELATION_BREAK) ++corr_breaks;
+    });
+    const SymbolId a = SymbolTable::intern_id("GATE_A");
+    const SymbolId b = SymbolTable::intern_id("GATE_B");
+    router.add_watched_pair(a, b);
+    for (uint64_t i = 0; i < 300; ++i) {
+        const double x = 100.0 + std::sin(static_cast<double>(i) * 0.1);
+        router.process_tick(Tick{a, x, x - 0.01, x + 0.01, 100.0, i});
+        router.process_tick(Tick{b, x + 1.0, x + 0.99, x + 1.01, 100.0, i});
+    }
+    assert(corr_breaks == 1);
+
+    std::cout << "✅ SignalGate tests passed\n";
+}
+
+void test_static_rule_pipeline() {
+    std::cout << "Testing StaticRulePipeline...\n";
+
+    static_assert(TickRule<ZScoreRule> && TickRule<VolumeRule> && TickRule<MeanReversionRule>);
+    static_assert(!TickRule<CorrelationBreakRule>); // Pair rule, fed by the router
+    static_assert(SymbolRulePipeline::size() == 3);
+
+    // Same signals, in the same order, as driving each rule by hand
+    SymbolRulePipeline pipeline{ZScoreRule(2.0, 64), VolumeRule(2.0, 64), MeanReversionRule()};
+    ZScoreRule zscore(2.0, 64);
+    VolumeRule volume(2.0, 64);
+    MeanReversionRule mean_rev;
+
+    const SymbolId id = SymbolTable::intern_id("PIPE_X");
+    std::vector<SignalEvent::Type> from_pipeline;
+    std::vector<SignalEvent::Type> by_hand;
+    for (int i = 0; i < 500; ++i) {
+        const double price = 100.0 + std::sin(i * 0.05) * 2.0 + ((i % 97 == 0) ? 5.0 : 0.0);
+        const double size = (i % 53 == 0) ? 5000.0 : 100.0 + (i % 7);
+        const Tick tick{id, price, price - 0.01, price + 0.01, size, static_cast<uint64_t>(i)};
+
+        pipeline.process(tick, [&](SignalEvent::Type type, double, double) {
+            from_pipeline.push_back(type);
+        });
+
+        double strength;
+        zscore.add_observation(price);
+        if (zscore.evaluate(strength)) by_hand.push_back(ZScoreRule::SIGNAL_TYPE);
+        volume.add_volume(size);
+        if (volume.evaluate(strength)) by_hand.push_back(VolumeRule::SIGNAL_TYPE);
+        mean_rev.add_observation(price);
+        if (mean_rev.evaluate(strength)) by_hand.push_back(MeanReversionRule::SIGNAL_TYPE);
+    }
+    assert(!by_hand.empty());
+    assert(from_pipeline == by_hand);
+
+    // reset() reaches every rule
+    pipeline.reset();
+    [[maybe_unused]] double strength;
+    assert(!pipeline.get<ZScoreRule>().evaluate(strength));
+    assert(!pipeline.get<VolumeRule>().evaluate(strength));
+    assert(!pipeline.get<MeanReversionRule>().evaluate(strength));
+
+    std::cout << "✅ StaticRulePipeline tests passed\n";
+}
+
+void test_sharded_router() {
+    std::cout << "Testing ShardedRouter partitioning...\n";
+
+    // Volatile enough that prices move past the 0.01 tick size every step
+    std::vector<SymbolConfig> configs;
+    for (int i = 0; i < 12; ++i) {
+        configs.emplace_back("SHARD_" + std::to_string(i), 100.0 + i, 200.0);
+    }
+    FeedSimulator feed(configs);
+
+    const SymbolId s0 = SymbolTable::intern_id("SHARD_0");
+    const SymbolId s1 = SymbolTable::intern_id("SHARD_1");
+    const SymbolId s2 = SymbolTable::intern_id("SHARD_2");
+    const SymbolId s3 = SymbolTable::intern_id("SHARD_3");
+
+    ShardedRouter router(4);
+    std::atomic<uint64_t> callbacks{0};
+    router.set_signal_callback([&callbacks](const SignalEvent&) {
+        callbacks.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    // Fresh pair is co-located; pinning s3 elsewhere forces a cross-shard pair
+    router.add_watched_pair(s0, s1);
+    assert(router.shard_of(s0) == router.shard_of(s1));
+    router.assign_symbol(s2, 1);
+    router.assign_symbol(s3, 2);
+    router.add_watched_pair(s2, s3);
+    assert(router.shard_of(s2) != router.shard_of(s3));
+
+    // Let each step drain before the next, so the cross-shard leg always
+    // finds its partner's price on the board
+    router.start();
+    for (int step = 0; step < 200; ++step) {
+        feed.generate_ticks(router);
+        while (router.ticks_processed() < feed.ticks_generated()) {
+            std::this_thread::yield();
+        }
+    }
+    router.stop();
+
+    [[maybe_unused]] const uint64_t generated = feed.ticks_generated();
+    assert(generated + feed.ticks_dropped() == 200 * 12);
+    assert(router.ticks_processed() == generated);
+    assert(router.signals_generated() == callbacks.load());
+
+    // Every shard got work, and the merged histogram covers every tick
+    for (std::size_t i = 0; i < router.num_shards(); ++i) {
+        assert(router.shard_router(i).ticks_processed() > 0);
+    }
+    LatencyHistogram merged;
+    router.merge_latency(merged);
+    assert(merged.total_samples() == generated);
+
+    // Both the co-located and the cross-shard pair accumulated correlation
+    assert(router.get_correlation(s0, s1) != 0.0);
+    assert(router.get_correlation(s3, s2) != 0.0);
+
+    std::cout << "✅ ShardedRouter tests passed\n";
+}
+
+// try_push_n takes a prefix, so OverloadController can retry or park the rest
+void test_sharded_router_partial_push() {
+    std::cout << "Testing ShardedRouter partial pushes...\n";
+
+    const SymbolId a = SymbolTable::intern_id("SHARD_FULL_A");
+    const SymbolId b = SymbolTable::intern_id("SHARD_FULL_B");
+    const auto stamp = TickClock::now();
+    auto tick = [&](SymbolId symbol, uint64_t sequence) {
+        return Tick(symbol, 100.0, 99.9, 100.1, 10.0, sequence, stamp);
+    };
+
+    ShardedRouter router(2);
+    router.assign_symbol(a, 0);
+    router.assign_symbol(b, 1);
+
+    // Fill shard 0 while its worker is stopped
+    const std::vector<Tick> backlog(ShardedRouter::SHARD_QUEUE_SIZE - 1, tick(a, 0));
+    [[maybe_unused]] std::size_t accepted = router.try_push_n(backlog.data(), backlog.size());
+    assert(accepted == backlog.size());
+
+    // A full shard ends the prefix even though a later tick's shard has room
+    const Tick first_full[] = {tick(a, 1), tick(b, 2)};
+    accepted = router.try_push_n(first_full, 2);
+    assert(accepted == 0 && router.ticks_dropped() == 1);
+
+    OverloadConfig config;
+    config.spin_retries = 3;
+    OverloadController overload(config);
+    const Tick mixed[] = {tick(b, 3), tick(a, 4), tick(b, 5)};
+    [[maybe_unused]] PublishResult result = overload.publish(router, mixed, 3);
+    assert(result.delivered == 1 && result.lost == 2);
+
+    // Conflation parks exactly the ticks that were not taken
+    config.policy = OverloadPolicy::CONFLATE;
+    overload.set_config(config);
+    const Tick burst[] = {tick(b, 6), tick(a, 7), tick(b, 8)};
+    result = overload.publish(router, burst, 3);
+    assert(result.delivered == 1 && result.lost == 0 && overload.parked() == 2);
+
+    router.start();
+    [[maybe_unused]] std::size_t flushed = 0;
+    while (overload.parked() > 0) {
+        flushed += overload.flush(router);
+        std::this_thread::yield();
+    }
+    router.stop();
+
+    assert(flushed == 2);
+    assert(router.shard_router(0).ticks_processed() == backlog.size() + 1);
+    assert(router.shard_router(1).ticks_processed() == 3);
+
+    std::cout << "✅ ShardedRouter partial push tests passed\n";
+}
+
+void test_consumer_runner() {
+    std::cout << "Testing ConsumerRunner wait strategies...\n";
+
+    for (const auto wait : {WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD,
+                            WaitStrategy::BLOCKING, WaitStrategy::SLEEP}) {
+        assert(parse_wait_strategy(wait_strategy_name(wait)) == wait);
+
+        // Small ring so the producer keeps catching the consumer idle
+        SPSCQueue<uint64_t, 64> queue;
+        std::vector<uint64_t> received;
+        ConsumerConfig config;
+        config.wait = wait;
+        config.spin_iterations = 16;
+        config.sleep_interval = std::chrono::microseconds(1);
+        config.cpu = 0;
+        ConsumerRunner runner(queue, [&received](uint64_t v) { received.push_back(v); }, config);
+
+        constexpr uint64_t COUNT = 20000;
+        runner.start();
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            while (!queue.push(i)) std::this_thread::yield();
+            runner.wake_signal().notify();
+            // Bursts with gaps, so the BLOCKING runner actually parks
+            if (i % 2000 == 1999) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        runner.stop();
+
+        // stop() drains; everything arrives once, in order
+        assert(runner.items_consumed() == COUNT);
+        assert(received.size() == COUNT);
+        for (uint64_t i = 0; i < COUNT; ++i) assert(received[i] == i);
+        assert(queue.empty());
+        assert(runner.pinned());
+        if (wait == WaitStrategy::BLOCKING) assert(runner.parks() > 0);
+    }
+
+    // Parked with nothing to do: stop() still wakes and joins it
+    SPSCQueue<uint64_t, 64> idle_queue;
+    ConsumerConfig blocking;
+    blocking.spin_iterations = 0;
+    ConsumerRunner idle(idle_queue, [](uint64_t) {}, blocking);
+    idle.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    idle.stop();
+    assert(idle.items_consumed() == 0);
+
+    std::cout << "✅ ConsumerRunner tests passed\n";
+}
+
+void test_backtest_runner() {
+    std::cout << "Testing BacktestRunner...\n";
+
+    std::vector<SymbolConfig> symbols;
+    symbols.emplace_back("BT_A", 100.0, 0.3);
+    symbols.emplace_back("BT_B", 50.0, 0.3);
+    symbols.emplace_back("BT_C", 80.0, 0.3);
+    FeedSimulator feed(std::move(symbols), PriceModel::GEOMETRIC_BROWNIAN_MOTION, 1.0);
+    feed.set_pair_correlation("BT_A", "BT_B", 0.8);
+    std::vector<Tick> ticks = simulate_ticks(feed, 3000, 1.0);
+    assert(ticks.size() == 9000);
+    // Simulated clock: one millisecond per step, symbols of a step share a stamp
+    assert(ticks[3].timestamp - ticks[0].timestamp == std::chrono::milliseconds(1));
+    assert(ticks[2].timestamp == ticks[0].timestamp);
+
+    // Reference: the same stream through one Router by hand
+    Router reference;
+    reference.set_zscore_threshold(2.0);
+    reference.add_watched_pair("BT_A", "BT_B");
+    uint64_t reference_zbreaks = 0;
+    reference.set_signal_callback([&](const SignalEvent& event) {
+        if (event.event_type == SignalEvent::Type::Z_SCORE_BREAK) ++reference_zbreaks;
+    });
+    for (const Tick& tick : ticks) reference.process_tick(tick);
+
+    const std::vector<double> zscores{1.5, 2.0, 3.0};
+    const std::vector<double> correlations{0.3, 0.6};
+    const std::vector<double> volumes{3.0};
+    const auto grid = BacktestRunner::grid(zscores, correlations, volumes);
+    assert(grid.size() == 6);
+    assert(grid[1].zscore_threshold == 1.5 && grid[1].correlation_threshold == 0.6);
+
+    BacktestConfig one_thread;
+    one_thread.threads = 1;
+    BacktestRunner sequential(ticks, one_thread);
+    sequential.add_watched_pair("BT_A", "BT_B");
+    assert(sequential.symbols().size() == 3);
+
+    BacktestConfig four_threads;
+    four_threads.threads = 4;
+    BacktestRunner parallel(ticks, four_threads);
+    parallel.add_watched_pair("BT_A", "BT_B");
+
+    const auto expected = sequential.run(grid);
+    const auto results = parallel.run(grid);
+    assert(results.size() == grid.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        assert(results[i].params.zscore_threshold == grid[i].zscore_threshold);
+        assert(results[i].ticks_processed == ticks.size());
+        assert(results[i].signals == expected[i].signals);
+        assert(results[i].signals_by_type == expected[i].signals_by_type);
+        assert(results[i].max_abs_strength == expected[i].max_abs_strength);
+    }
+
+    // grid[2] is zscore 2.0, correlation 0.3: the reference configuration
+    assert(results[2].count(SignalEvent::Type::Z_SCORE_BREAK) == reference_zbreaks);
+    assert(reference_zbreaks > 0);
+
+    // A higher threshold only removes Z-score breaks
+    [[maybe_unused]] const auto zbreaks = [&](std::size_t i) { return results[i].count(SignalEvent::Type::Z_SCORE_BREAK); };
+    assert(zbreaks(0) >= zbreaks(2) && zbreaks(2) >= zbreaks(4));
+    assert(zbreaks(0) > zbreaks(4));
+    assert(results[0].max_abs_strength >= results[0].mean_abs_strength);
+    assert(results[0].signals_per_1k_ticks() > 0.0);
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        parallel.add_watched_pair("BT_A", "BT_A");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ BacktestRunner tests passed\n";
+}
+
+void test_router_checkpoint() {
+    std::cout << "Testing Router checkpoint/restore...\n";
+
+    std::vector<SymbolConfig> symbols;
+    symbols.emplace_back("CK_A", 100.0, 0.3);
+    symbols.emplace_back("CK_B", 50.0, 0.3);
+    FeedSimulator feed(std::move(symbols), PriceModel::GEOMETRIC_BROWNIAN_MOTION, 1.0);
+    feed.set_pair_correlation("CK_A", "CK_B", 0.8);
+    const std::vector<Tick> ticks = simulate_ticks(feed, 2000, 1.0);
+    const std::size_t half = ticks.size() / 2;
+
+    const auto make_router = [](Router& router, std::size_t window) {
+        router.set_zscore_threshold(1.5);
+        router.set_zscore_window(window);
+        router.add_watched_pair("CK_A", "CK_B");
+    };
+    const auto count_signals = [](Router& router, std::vector<SignalEvent::Type>& types) {
+        router.set_signal_callback([&types](const SignalEvent& event) {
+            if (event.event_type != SignalEvent::Type::CORRELATION_BREAK) {
+                types.push_back(event.event_type);
+            }
+        });
+    };
+
+    Router original;
+    make_router(original, 128);
+    for (std::size_t i = 0; i < half; ++i) original.process_tick(ticks[i]);
+
+    std::vector<std::byte> image;
+    original.checkpoint(image);
+    [[maybe_unused]] const double checkpoint_correlation = original.get_correlation("CK_A", "CK_B");
+    [[maybe_unused]] const CheckpointHeader header = read_checkpoint_header(image);
+    assert(header.symbol_count == 2 && header.pair_count == 1);
+
+    // A warm start continues exactly where the original left off
+    Router restored;
+    make_router(restored, 128);
+    [[maybe_unused]] const CheckpointRestore result = restored.restore(image);
+    assert(result.symbols == 2 && result.pairs == 1 && result.pairs_skipped == 0);
+    assert(restored.snapshot().symbols[0].ticks == original.snapshot().symbols[0].ticks);
+    assert(restored.snapshot().symbols[0].price_mean == original.snapshot().symbols[0].price_mean);
+
+    // A pair registered with its legs the other way round keeps its state
+    Router swapped;
+    swapped.set_zscore_threshold(1.5);
+    swapped.set_zscore_window(128);
+    swapped.add_watched_pair("CK_B", "CK_A");
+    [[maybe_unused]] const CheckpointRestore swapped_result = swapped.restore(image);
+    assert(swapped_result.pairs == 1 && swapped_result.pairs_skipped == 0);
+    assert(std::abs(swapped.get_correlation("CK_A", "CK_B") - checkpoint_correlation) < 1e-12);
+
+    std::vector<SignalEvent::Type> expected, actual;
+    count_signals(original, expected);
+    count_signals(restored, actual);
+    for (std::size_t i = half; i < ticks.size(); ++i) {
+        original.process_tick(ticks[i]);
+        restored.process_tick(ticks[i]);
+        swapped.process_tick(ticks[i]);
+    }
+    assert(std::abs(swapped.get_correlation("CK_A", "CK_B") - restored.get_correlation("CK_A", "CK_B")) < 1e-9);
+    assert(!expected.empty() && actual == expected);
+    // Latest prices are not saved, so the pair misses one observation
+    assert(std::abs(restored.get_correlation("CK_A", "CK_B") -
+                    original.get_correlation("CK_A", "CK_B")) < 0.01);
+
+    // A smaller window keeps the newest values; unwatched pairs are skipped
+    Router resized;
+    resized.set_zscore_window(32);
+    [[maybe_unused]] const CheckpointRestore resized_result = resized.restore(image);
+    assert(resized_result.symbols == 2 && resized_result.pairs_skipped == 1);
+    const SymbolId ck_a = SymbolTable::find("CK_A");
+    double newest_sum = 0.0;
+    std::size_t newest = 0;
+    for (std::size_t i = half; i-- > 0 && newest < 32;) {
+        if (ticks[i].symbol_id == ck_a) {
+            newest_sum += ticks[i].last_price;
+            ++newest;
+        }
+    }
+    [[maybe_unused]] const SymbolStats resized_stats = resized.snapshot().symbols[0];
+    assert(resized_stats.symbol == ck_a);
+    assert(std::abs(resized_stats.price_mean - newest_sum / 32.0) < 1e-9);
+
+    // Corrupt, truncated and foreign-version images are rejected
+    [[maybe_unused]] const auto rejects = [](std::vector<std::byte> bytes) {
+        Router target;
+        try {
+            (void)target.restore(bytes);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    std::vector<std::byte> corrupt = image;
+    corrupt.back() ^= std::byte{0x01};
+    assert(rejects(corrupt));
+    std::vector<std::byte> truncated(image.begin(), image.end() - 8);
+    assert(rejects(truncated));
+    std::vector<std::byte> future = image;
+    future[8] = std::byte{CHECKPOINT_VERSION + 1};
+    assert(rejects(future));
+    assert(!rejects(image));
+
+    std::cout << "✅ Router checkpoint tests passed\n";
+}
+
+void test_correlation_matrix_engine() {
+    std::cout << "Testing CorrelationMatrixEngine...\n";
+
+    // Ten symbols: CM_0/CM_1 share a factor for the first 400 snapshots and
+    // then decouple; CM_2/CM_3 share one throughout
+    std::vector<SymbolId> universe;
+    for (int i = 0; i < 10; ++i) universe.push_back(SymbolTable::intern_id("CM_" + std::to_string(i)));
+    const SymbolId outsider = SymbolTable::intern_id("CM_OUT");
+
+    CorrelationMatrixConfig config;
+    config.sample_interval = std::chrono::milliseconds(100);
+    config.fast_window = 20;
+    config.reference_window = 400;
+    config.batch = 8;
+    CorrelationMatrixEngine engine(universe, config);
+
+    Router router;
+    router.set_correlation_matrix(&engine);
+
+    std::mt19937 rng(9);
+    std::normal_distribution<double> noise(0.0, 0.001);
+    std::vector<double> prices(universe.size(), 100.0);
+    const TickClock::time_point start{};
+    const int snapshots = 460;
+    for (int step = 0; step < snapshots; ++step) {
+        std::vector<double> returns(universe.size());
+        for (double& r : returns) r = noise(rng);
+        if (step < 400) returns[1] = 0.9 * returns[0] + 0.3 * returns[1];
+        returns[3] = 0.9 * returns[2] + 0.3 * returns[3];
+
+        // One tick per symbol, all inside the same 100ms slot
+        const auto slot_start = start + std::chrono::milliseconds(100 * step);
+        for (std::size_t i = 0; i < universe.size(); ++i) {
+            prices[i] *= std::exp(returns[i]);
+            Tick tick(universe[i], prices[i], prices[i] - 0.01, prices[i] + 0.01, 100.0,
+                      static_cast<uint64_t>(step), slot_start + std::chrono::microseconds(i));
+            router.process_tick(tick);
+        }
+        Tick noise_tick(outsider, 1.0, 0.99, 1.01, 1.0, 0, slot_start + std::chrono::microseconds(50));
+        engine.on_tick(noise_tick);
+    }
+    engine.flush();
+
+    // Step 1's first tick takes the first full snapshot, each later step a return
+    assert(engine.samples() == static_cast<uint64_t>(snapshots - 2));
+    assert(engine.pending_samples() == 0);
+    assert(engine.fast().observations() == engine.samples());
+    assert(engine.slot(outsider) == -1 && engine.correlation(universe[0], outsider) == 0.0);
+    assert(engine.correlation(universe[2], universe[3]) > 0.8);
+
+    const auto top = engine.top_decorrelating(3);
+    assert(top.size() == 3);
+    assert(top[0].first == universe[0] && top[0].second == universe[1]);
+    assert(top[0].reference_correlation > 0.5 && std::abs(top[0].correlation) < 0.5);
+
+    // Without a reference: the lowest |correlation| never includes a factor pair
+    CorrelationMatrixConfig no_reference = config;
+    no_reference.reference_window = 0;
+    CorrelationMatrixEngine plain(universe, no_reference);
+    [[maybe_unused]] bool threw = false;
+    try {
+        const std::vector<SymbolId> duplicated{universe[0], universe[1], universe[0]};
+        CorrelationMatrixEngine invalid(duplicated, config);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(plain.top_decorrelating(5).empty());
+    assert(plain.reference() == nullptr && engine.reference() != nullptr);
+
+    // Batches past MAX_BATCH would stall the tick thread for too long
+    threw = false;
+    try {
+        CorrelationMatrixConfig oversized = config;
+        oversized.batch = CorrelationMatrixEngine::MAX_BATCH + 1;
+        CorrelationMatrixEngine invalid(universe, oversized);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ CorrelationMatrixEngine tests passed\n";
+}
+
+void run_router_tests() {
+    std::cout << "🧪 Running Router Tests\n";
+    std::cout << "=======================\n";
+
+    test_symbol_table_ids();
+    test_symbol_table_concurrent_intern();
+    test_router_signals_carry_ids();
+    test_zscore_rule_window();
+    test_router_pair_index();
+    test_router_reserve();
+    test_signal_dispatcher();
+    test_signal_dispatcher_slow_sink();
+    test_signal_gate_modes();
+    test_static_rule_pipeline();
+    test_sharded_router();
+    test_sharded_router_partial_push();
+    test_consumer_runner();
+    test_backtest_runner();
+    test_router_checkpoint();
+    test_correlation_matrix_engine();
+
+    std::cout << "\n✅ All router tests passed!\n\n";
+}
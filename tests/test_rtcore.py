@@ -0,0 +1,120 @@
+"""
+Smoke test of the rtcore extension (python/rtcore.cpp), run by ctest when
+the module is built:
+
+    python3 tests/test_rtcore.py <dir holding rtcore> <demo_realtime binary>
+
+The demo records a short tick journal for the ReplayFeed path.
+"""
+
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+STEPS = 5000
+SYMBOLS = [("AAPL", 150.0, 0.3), ("MSFT", 300.0, 0.3), ("GOOGL", 120.0, 0.3), ("TSLA", 200.0, 0.3)]
+SIGNAL_FIELDS = ("event_time_ns", "generation_time_ns", "signal_id", "signal_strength", "confidence",
+                 "primary_id", "secondary_id", "event_type", "primary_symbol", "secondary_symbol")
+
+
+def check_signals(rtcore, np, router):
+    signals = router.signals()
+    assert isinstance(signals, np.ndarray)
+    assert signals.dtype.names == SIGNAL_FIELDS, signals.dtype.names
+    assert len(signals) == router.signal_count
+    assert not signals.flags.writeable
+    if len(signals) > 0:
+        try:
+            signals["signal_strength"][:1] = 0.0
+        except ValueError:
+            pass
+        else:
+            raise AssertionError("signal view is writeable")
+        assert signals["event_type"].max() < len(rtcore.SIGNAL_TYPES)
+        assert rtcore.symbol_name(int(signals["primary_id"][0])) in {name for name, _, _ in SYMBOLS}
+    return signals
+
+
+def test_simulated(rtcore, np):
+    feed = rtcore.FeedSimulator(SYMBOLS)
+    router = rtcore.Router()
+    router.set_zscore_threshold(2.0)
+    router.add_watched_pair("AAPL", "MSFT")
+    router.add_watched_pair("GOOGL", "TSLA")
+
+    processed = router.run(feed, steps=STEPS)
+    assert processed == STEPS * len(SYMBOLS), processed
+    assert feed.ticks_generated == processed
+
+    snapshot = router.snapshot()
+    assert snapshot.ticks_processed == processed
+    assert snapshot.signals_generated == router.signal_count + router.signals_dropped
+    assert sum(snapshot.signals_by_type.values()) == snapshot.signals_generated
+    assert int(snapshot.latency_counts.sum()) == processed
+    assert snapshot.latency_bounds_ns().shape == (len(snapshot.latency_counts), 2)
+    assert len(snapshot.symbols) == len(SYMBOLS)
+    assert int(snapshot.symbols["ticks"].sum()) == processed
+
+    signals = check_signals(rtcore, np, router)
+    assert len(signals) > 0, "no signals from a volatile feed"
+
+    # The view keeps the router alive
+    del router
+    assert len(signals["signal_strength"]) == len(signals)
+    print(f"simulated: {processed} ticks, {len(signals)} signals")
+
+
+def test_signal_capacity(rtcore, np):
+    assert rtcore.Router().signal_capacity == 65536
+    router = rtcore.Router(signal_capacity=16)
+    router.set_zscore_threshold(0.5)
+    router.run(rtcore.FeedSimulator(SYMBOLS), steps=STEPS)
+    first = check_signals(rtcore, np, router)
+    assert router.signal_count == 16 and router.signals_dropped > 0
+
+    # The block does not move, so earlier views stay valid across clears
+    router.clear_signals()
+    router.run(rtcore.FeedSimulator(SYMBOLS), steps=100)
+    assert len(first) == 16 and router.signal_count > 0
+    assert router.signals().ctypes.data == first.ctypes.data
+    print(f"capacity: {router.signals_dropped} signals past 16 dropped")
+
+
+def test_replay(rtcore, np, demo):
+    with tempfile.TemporaryDirectory() as workdir:
+        subprocess.run([demo, "--duration", "1", "--record-ticks"], cwd=workdir, check=True,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, timeout=60)
+        journals = sorted(glob.glob(os.path.join(workdir, "data", "journal", "ticks-*.rtj")))
+        assert journals, "demo recorded no tick journal"
+
+        feed = rtcore.ReplayFeed(journals, mode="fast")
+        assert feed.total_ticks > 0
+        router = rtcore.Router()
+        router.add_watched_pair("AAPL", "MSFT")
+
+        replayed = router.replay(feed)
+        assert replayed == feed.total_ticks == feed.ticks_replayed, (replayed, feed.total_ticks)
+        assert router.snapshot().ticks_processed == replayed
+        check_signals(rtcore, np, router)
+        print(f"replay: {replayed} ticks from {len(journals)} journal(s)")
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 2
+    sys.path.insert(0, sys.argv[1])
+    import numpy as np
+    import rtcore
+
+    test_simulated(rtcore, np)
+    test_signal_capacity(rtcore, np)
+    test_replay(rtcore, np, sys.argv[2])
+    print("rtcore tests passed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
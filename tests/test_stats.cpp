@@ -1,10 +1,15 @@
 #include "stats/rolling_stats.hpp"
 #include "stats/rolling_covar.hpp"
+#include "stats/soa_stats.hpp"
+#include "stats/covariance_matrix.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <vector>
 #include <random>
+#include <span>
+#include <stdexcept>
 
 constexpr double EPSILON = 1e-9;
 
@@ -167,10 +172,237 @@ void test_windowed_stats() {
     windowed.add(6.0);
     assert(windowed.count() == 5);
     assert(close_enough(windowed.mean(), 4.0)); // Mean of [2,3,4,5,6]
+    assert(close_enough(windowed.variance(), 2.5));
 
     std::cout << "✅ WindowedStats tests passed\n";
 }
 
+void test_sliding_window_stats() {
+    std::cout << "Testing SlidingWindowStats...\n";
+
+    // Matches a two-pass computation over the window at every step
+    const std::size_t window = 32;
+    SlidingWindowStats sliding(window);
+    std::vector<double> history;
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 0.05);
+
+    const double base = 1e6; // Price-level offset with cent-level moves
+    for (int i = 0; i < 5000; ++i) {
+        const double value = base + noise(rng);
+        sliding.add(value);
+        history.push_back(value);
+
+        const std::size_t n = std::min(history.size(), window);
+        double mean = 0.0;
+        for (std::size_t k = history.size() - n; k < history.size(); ++k) mean += history[k];
+        mean /= static_cast<double>(n);
+        double m2 = 0.0;
+        for (std::size_t k = history.size() - n; k < history.size(); ++k) {
+            m2 += (history[k] - mean) * (history[k] - mean);
+        }
+        [[maybe_unused]] const double variance = n > 1 ? m2 / static_cast<double>(n - 1) : 0.0;
+
+        assert(sliding.count() == n);
+        assert(close_enough(sliding.mean(), mean, 1e-6));
+        assert(close_enough(sliding.variance(), variance, 1e-6 * 0.0025));
+    }
+    assert(sliding.is_full());
+
+    // Old regime falls out of the window entirely
+    SlidingWindowStats regime(10);
+    for (int i = 0; i < 100; ++i) regime.add(100.0);
+    for (int i = 0; i < 10; ++i) regime.add(200.0);
+    assert(close_enough(regime.mean(), 200.0));
+    assert(close_enough(regime.variance(), 0.0));
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        SlidingWindowStats invalid(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // External storage behaves like an owned buffer; copies detach from it
+    std::vector<double> storage(window, -1.0);
+    SlidingWindowStats borrowed(std::span<double>(storage.data(), storage.size()));
+    SlidingWindowStats owned(window);
+    for (int i = 0; i < 100; ++i) {
+        const double value = base + noise(rng);
+        borrowed.add(value);
+        owned.add(value);
+    }
+    assert(borrowed.window() == window);
+    assert(borrowed.mean() == owned.mean() && borrowed.variance() == owned.variance());
+    SlidingWindowStats copy = borrowed;
+    copy.add(0.0);
+    borrowed.add(1.0);
+    assert(copy.mean() != borrowed.mean());
+    assert(std::find(storage.begin(), storage.end(), 1.0) != storage.end());
+    assert(std::find(storage.begin(), storage.end(), 0.0) == storage.end());
+
+    std::cout << "✅ SlidingWindowStats tests passed\n";
+}
+
+void test_soa_stats() {
+    std::cout << "Testing SoAStats against per-symbol RollingStats...\n";
+
+    // Odd symbol count exercises the scalar tail after the vector lanes
+    const std::size_t num_symbols = 37;
+    SoAStats soa(num_symbols);
+    std::vector<RollingStats> reference(num_symbols);
+    std::vector<double> values(num_symbols);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    for (int step = 0; step < 500; ++step) {
+        for (std::size_t i = 0; i < num_symbols; ++i) {
+            values[i] = 100.0 + static_cast<double>(i) + noise(rng);
+            reference[i].add(values[i]);
+        }
+        soa.update_all(values.data());
+    }
+
+    // Sparse batch with a repeated id
+    const uint32_t ids[] = {3, 36, 3};
+    const double sparse[] = {104.5, 130.0, 102.0};
+    soa.update(ids, sparse, 3);
+    reference[3].add(104.5);
+    reference[36].add(130.0);
+    reference[3].add(102.0);
+
+    for (std::size_t i = 0; i < num_symbols; ++i) {
+        assert(soa.count(i) == reference[i].count());
+        assert(close_enough(soa.mean(i), reference[i].mean(), 1e-9));
+        assert(close_enough(soa.variance(i), reference[i].variance(), 1e-9));
+    }
+
+    // Threshold scan agrees with scalar z-scores
+    for (std::size_t i = 0; i < num_symbols; ++i) {
+        values[i] = 100.0 + static_cast<double>(i) + 3.0 * noise(rng);
+    }
+    std::vector<uint32_t> hits(num_symbols);
+    const double threshold = 2.0;
+    const std::size_t hit_count = soa.scan_zscore(values.data(), threshold, 10, hits.data());
+
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < num_symbols; ++i) {
+        [[maybe_unused]] const double z = reference[i].z_score(values[i]);
+        [[maybe_unused]] const bool hit = next < hit_count && hits[next] == i;
+        if (hit) ++next;
+        assert(hit == (std::abs(z) >= threshold));
+        assert(close_enough(soa.z_score(i, values[i]), z, 1e-9));
+    }
+    assert(next == hit_count);
+
+    // Too few observations never qualify
+    SoAStats fresh(4);
+    const double first[] = {1.0, 2.0, 3.0, 4.0};
+    fresh.update_all(first);
+    assert(fresh.scan_zscore(first, 0.0, 10, hits.data()) == 0);
+
+    std::cout << "✅ SoAStats tests passed\n";
+}
+
+void test_covariance_matrix() {
+    std::cout << "Testing EMACovarianceMatrix against pairwise EMACovar...\n";
+
+    // More series than one BLOCK, and not a multiple of it, to cross tile edges
+    const std::size_t n = 75;
+    const std::size_t window = 20;
+    const int steps = 300;
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    // Series 2k and 2k+1 share a factor; the rest are independent
+    std::vector<double> snapshots(static_cast<std::size_t>(steps) * n);
+    for (int step = 0; step < steps; ++step) {
+        double* row = snapshots.data() + static_cast<std::size_t>(step) * n;
+        for (std::size_t i = 0; i < n; ++i) {
+            row[i] = noise(rng);
+            if (i % 2 == 1 && i < 20) row[i] = 0.9 * row[i - 1] + 0.3 * row[i];
+        }
+    }
+
+    EMACovarianceMatrix one_by_one(n, window);
+    EMACovarianceMatrix batched(n, window);
+    for (int step = 0; step < steps; ++step) {
+        one_by_one.update(snapshots.data() + static_cast<std::size_t>(step) * n);
+    }
+    // Uneven batches, the first one seeding the means
+    std::size_t done = 0;
+    for (std::size_t batch : {1u, 16u, 50u, 233u}) {
+        batched.update_batch(snapshots.data() + done * n, batch);
+        done += batch;
+    }
+    assert(done == static_cast<std::size_t>(steps));
+    assert(one_by_one.observations() == static_cast<uint64_t>(steps));
+    assert(batched.observations() == one_by_one.observations());
+    assert(one_by_one.pair_count() == n * (n - 1) / 2);
+
+    const std::pair<std::size_t, std::size_t> probes[] = {{0, 1}, {3, 70}, {64, 74}, {12, 11}, {40, 40}};
+    for (const auto& [i, j] : probes) {
+        EMACovar reference(window);
+        for (int step = 0; step < steps; ++step) {
+            const double* row = snapshots.data() + static_cast<std::size_t>(step) * n;
+            reference.add(row[i], row[j]);
+        }
+        assert(close_enough(one_by_one.covariance(i, j), reference.covariance(), 1e-12));
+        assert(close_enough(one_by_one.covariance(j, i), reference.covariance(), 1e-12));
+        assert(close_enough(one_by_one.correlation(i, j), reference.correlation(), 1e-12));
+        assert(close_enough(one_by_one.mean(i), reference.mean_x(), 1e-12));
+        assert(close_enough(batched.covariance(i, j), one_by_one.covariance(i, j), 1e-12));
+    }
+
+    // Top-k agrees with a brute-force ranking by |correlation|
+    std::vector<std::pair<double, std::pair<std::size_t, std::size_t>>> ranked;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            ranked.push_back({std::abs(one_by_one.correlation(i, j)), {i, j}});
+        }
+    }
+    std::sort(ranked.begin(), ranked.end());
+    const auto lowest = one_by_one.top_decorrelating(10);
+    assert(lowest.size() == 10);
+    for (std::size_t r = 0; r < lowest.size(); ++r) {
+        assert(lowest[r].i == ranked[r].second.first && lowest[r].j == ranked[r].second.second);
+        assert(close_enough(lowest[r].correlation, one_by_one.correlation(lowest[r].i, lowest[r].j), 1e-12));
+    }
+
+    // Against a reference: the factor pairs lose their correlation once the
+    // shared factor goes away
+    EMACovarianceMatrix slow(n, std::size_t{200});
+    slow.update_batch(snapshots.data(), static_cast<std::size_t>(steps));
+    EMACovarianceMatrix fast(n, window);
+    fast.update_batch(snapshots.data(), static_cast<std::size_t>(steps));
+    std::vector<double> independent(n);
+    for (int step = 0; step < 60; ++step) {
+        for (double& value : independent) value = noise(rng);
+        fast.update(independent.data());
+        slow.update(independent.data());
+    }
+    const auto drops = fast.top_decorrelating(5, &slow);
+    assert(drops.size() == 5);
+    for ([[maybe_unused]] const MatrixPair& pair : drops) {
+        assert(pair.j == pair.i + 1 && pair.i % 2 == 0 && pair.j < 20);
+        assert(std::abs(pair.reference_correlation) > std::abs(pair.correlation));
+    }
+    assert(drops.front().reference_correlation > 0.5);
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        (void)fast.top_decorrelating(1, &batched);
+        EMACovarianceMatrix mismatched(n + 1, window);
+        (void)fast.top_decorrelating(1, &mismatched);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ EMACovarianceMatrix tests passed\n";
+}
+
 void run_stats_tests() {
     std::cout << "🧪 Running Statistics Tests\n";
     std::cout << "============================\n";
@@ -181,6 +413,9 @@ void run_stats_tests() {
     test_rolling_covar_known_correlation();
     test_ema_stats();
     test_windowed_stats();
+    test_sliding_window_stats();
+    test_soa_stats();
+    test_covariance_matrix();
 
     std::cout << "\n✅ All statistics tests passed!\n\n";
 }
\ No newline at end of file
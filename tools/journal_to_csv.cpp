@@ -0,0 +1,54 @@
+#include "io/journal.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Convert journal files to CSV for the Python tooling:
+//   journal_to_csv [--ticks] [-o out.csv] data/journal/signals-*.rtj
+// Files are concatenated in the order given; output goes to stdout by default.
+int main(int argc, char* argv[]) {
+    bool ticks = false;
+    std::string output;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--ticks") {
+            ticks = true;
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [--ticks] [-o out.csv] journal.rtj...\n";
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (paths.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--ticks] [-o out.csv] journal.rtj...\n";
+        return 1;
+    }
+
+    try {
+        std::ofstream file;
+        if (!output.empty()) {
+            file.open(output);
+            if (!file) {
+                std::cerr << "Cannot write " << output << "\n";
+                return 1;
+            }
+        }
+        std::ostream& out = output.empty() ? std::cout : file;
+
+        const std::size_t rows = ticks ? write_tick_journal_csv(paths, out)
+                                       : write_signal_journal_csv(paths, out);
+        std::cerr << rows << " records from " << paths.size() << " file(s)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "engine/backtest.hpp"
+#include "md/feed_sim.hpp"
+#include "md/replay_feed.hpp"
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Sweep Router thresholds over one tick stream and write one CSV row per
+// configuration:
+//   param_sweep [--steps N] [--rate-ms MS] [--zscore 2,2.5,3] [--corr 0.3]
+//               [--volume 3] [--pair A:B]... [--emission demo|level]
+//               [--threads N] [-o out.csv] [ticks-*.rtj...]
+// With journal files the recorded ticks are replayed; otherwise the demo's
+// four symbols are simulated for N steps, as two correlated pairs that are
+// watched unless --pair says otherwise. Signals are emitted under the
+// demo's policies (one per regime change) unless --emission level asks for
+// one per tick past the threshold.
+namespace {
+
+// Per-step volatility of the simulated symbols; enough to move prices off
+// the tick grid every step so the rules see real variance
+constexpr double SIMULATED_VOLATILITY = 0.3;
+
+const char* signal_type_name(std::size_t type) noexcept {
+    SignalEvent event;
+    event.event_type = static_cast<SignalEvent::Type>(type);
+    return event.type_name();
+}
+
+std::vector<double> parse_list(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) values.push_back(std::stod(item));
+    }
+    if (values.empty()) throw std::invalid_argument("Empty value list: " + text);
+    return values;
+}
+
+std::pair<std::string, std::string> parse_pair(const std::string& text) {
+    const auto colon = text.find(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == text.size()) {
+        throw std::invalid_argument("Pair must be A:B, got " + text);
+    }
+    return {text.substr(0, colon), text.substr(colon + 1)};
+}
+
+std::vector<Tick> simulated_stream(std::size_t steps, double rate_ms) {
+    std::vector<SymbolConfig> symbols;
+    symbols.emplace_back("AAPL", 150.0, SIMULATED_VOLATILITY);
+    symbols.emplace_back("MSFT", 300.0, SIMULATED_VOLATILITY);
+    symbols.emplace_back("GOOGL", 120.0, SIMULATED_VOLATILITY);
+    symbols.emplace_back("TSLA", 200.0, SIMULATED_VOLATILITY);
+
+    FeedSimulator feed(std::move(symbols), PriceModel::GEOMETRIC_BROWNIAN_MOTION, rate_ms);
+    feed.set_pair_correlation("AAPL", "MSFT", 0.8);
+    feed.set_pair_correlation("GOOGL", "TSLA", 0.7);
+    return simulate_ticks(feed, steps, rate_ms);
+}
+
+// The demo's policies: one signal per regime change rather than one per tick
+EmissionPolicies demo_emission_policies() {
+    EmissionPolicies policies{};
+    policies[signal_type_index(SignalEvent::Type::Z_SCORE_BREAK)] = EmissionPolicy::hysteresis(0.5);
+    policies[signal_type_index(SignalEvent::Type::VOLUME_SPIKE)] = EmissionPolicy::edge();
+    policies[signal_type_index(SignalEvent::Type::PAIR_TRADE_ENTRY)] = EmissionPolicy::hysteresis(0.5);
+    policies[signal_type_index(SignalEvent::Type::CORRELATION_BREAK)] = EmissionPolicy::hysteresis(0.05);
+    return policies;
+}
+
+void write_csv(std::ostream& out, const std::vector<BacktestResult>& results) {
+    out << "zscore_threshold,correlation_threshold,volume_threshold,ticks,signals";
+    for (std::size_t t = 0; t < SIGNAL_TYPE_COUNT; ++t) out << ',' << signal_type_name(t);
+    out << ",signals_per_1k_ticks,mean_abs_strength,max_abs_strength,mean_confidence,elapsed_ms\n";
+
+    for (const auto& result : results) {
+        out << result.params.zscore_threshold << ',' << result.params.correlation_threshold << ','
+            << result.params.volume_threshold << ',' << result.ticks_processed << ',' << result.signals;
+        for (uint64_t count : result.signals_by_type) out << ',' << count;
+        out << ',' << result.signals_per_1k_ticks() << ',' << result.mean_abs_strength << ','
+            << result.max_abs_strength << ',' << result.mean_confidence << ','
+            << std::chrono::duration<double, std::milli>(result.elapsed).count() << '\n';
+    }
+}
+
+void print_usage(std::ostream& out, const char* program) {
+    out << "Usage: " << program << " [--steps N] [--rate-ms MS] [--zscore LIST] [--corr LIST]\n"
+        << "       [--volume LIST] [--pair A:B]... [--emission demo|level] [--threads N]\n"
+        << "       [-o out.csv] [ticks.rtj...]\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t steps = 200000;
+    double rate_ms = 0.5;
+    std::vector<double> zscores{2.5};
+    std::vector<double> correlations{0.3};
+    std::vector<double> volumes{3.0};
+    std::vector<std::pair<std::string, std::string>> pairs;
+    BacktestConfig config;
+    BacktestParams base;
+    base.emission_policies = demo_emission_policies();
+    std::string output;
+    std::vector<std::string> journals;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--steps" && i + 1 < argc) {
+                steps = std::stoull(argv[++i]);
+            } else if (arg == "--rate-ms" && i + 1 < argc) {
+                rate_ms = std::stod(argv[++i]);
+            } else if (arg == "--zscore" && i + 1 < argc) {
+                zscores = parse_list(argv[++i]);
+            } else if (arg == "--corr" && i + 1 < argc) {
+                correlations = parse_list(argv[++i]);
+            } else if (arg == "--volume" && i + 1 < argc) {
+                volumes = parse_list(argv[++i]);
+            } else if (arg == "--pair" && i + 1 < argc) {
+                pairs.push_back(parse_pair(argv[++i]));
+            } else if (arg == "--emission" && i + 1 < argc) {
+                const std::string emission = argv[++i];
+                if (emission == "level") {
+                    base.emission_policies = EmissionPolicies{};
+                } else if (emission != "demo") {
+                    throw std::invalid_argument("Unknown emission policy set: " + emission + " (demo|level)");
+                }
+            } else if (arg == "--threads" && i + 1 < argc) {
+                config.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (arg == "-o" && i + 1 < argc) {
+                output = argv[++i];
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(std::cout, argv[0]);
+                return 0;
+            } else if (!arg.empty() && arg[0] == '-') {
+                print_usage(std::cerr, argv[0]);
+                return 1;
+            } else {
+                journals.push_back(arg);
+            }
+        }
+        std::vector<Tick> ticks;
+        if (journals.empty()) {
+            if (pairs.empty()) pairs = {{"AAPL", "MSFT"}, {"GOOGL", "TSLA"}};
+            ticks = simulated_stream(steps, rate_ms);
+        } else {
+            ReplayConfig replay_config;
+            replay_config.timestamps = ReplayTimestamps::RECORDED;
+            ReplayFeed replay(journals, replay_config);
+            ticks = replay_ticks(replay);
+        }
+
+        BacktestRunner runner(std::move(ticks), config);
+        for (const auto& [first, second] : pairs) {
+            runner.add_watched_pair(first, second);
+        }
+        const auto grid = BacktestRunner::grid(zscores, correlations, volumes, base);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = runner.run(grid);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ofstream file;
+        if (!output.empty()) {
+            file.open(output);
+            if (!file) {
+                std::cerr << "Cannot write " << output << "\n";
+                return 1;
+            }
+        }
+        write_csv(output.empty() ? std::cout : file, results);
+        std::cerr << grid.size() << " configurations x " << runner.ticks().size() << " ticks in "
+                  << seconds << "s on " << std::min<std::size_t>(runner.threads(), grid.size())
+                  << " thread(s)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,334 @@
+#include "engine/backtest.hpp"
+#include "engine/consumer_runner.hpp"
+#include "engine/router.hpp"
+#include "engine/signal_dispatcher.hpp"
+#include "md/feed_sim.hpp"
+#include "md/overload_policy.hpp"
+#include "md/replay_feed.hpp"
+#include "md/spsc_queue.hpp"
+#include "util/load_report.hpp"
+#include "util/thread_affinity.hpp"
+#include "util/wait_strategy.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sustained-load harness for the whole tick path: a paced producer thread
+// pushes pre-generated ticks into an SPSC queue, a ConsumerRunner feeds them
+// to a Router, and signals leave through a SignalDispatcher. Each offered
+// rate runs for a fixed time and reports throughput, drops, queue depth and
+// push-to-process latency:
+//   rt_loadtest [--loads 100k,1M,10M] [--seconds S] [--symbols N]
+//               [--producer-cpu C] [--consumer-cpu C] [--wait spin|yield|block|sleep]
+//               [-o report.json] [--baseline report.json] [--label TEXT]
+//               [--throughput-tolerance F] [--latency-tolerance F] [--drop-tolerance F]
+//               [ticks-*.rtj...]
+// With --baseline, exits 1 if any step regressed against that report.
+namespace {
+
+using TickQueue = SPSCQueue<Tick, 65536>;
+
+constexpr std::size_t PUSH_BATCH = 64;
+constexpr std::size_t SIMULATED_STEPS = 1 << 16;  // Pool of SIMULATED_STEPS * symbols ticks
+constexpr int AUTO_CPU = -2;
+
+struct LoadTestConfig {
+    std::vector<double> loads{100e3, 300e3, 1e6, 3e6, 10e6};
+    double seconds{2.0};
+    std::size_t symbols{16};
+    int producer_cpu{AUTO_CPU};
+    int consumer_cpu{AUTO_CPU};
+    std::optional<WaitStrategy> wait;  // Default: spin on dedicated cores, else block
+    std::string output{"loadtest_report.json"};
+    std::string baseline;
+    std::string label;
+    LoadTolerance tolerance;
+    std::vector<std::string> journals;
+};
+
+// "250k", "1.5M", "2000000"
+double parse_rate(const std::string& text) {
+    std::size_t used = 0;
+    double value = std::stod(text, &used);
+    const std::string suffix = text.substr(used);
+    if (suffix == "k" || suffix == "K") {
+        value *= 1e3;
+    } else if (suffix == "m" || suffix == "M") {
+        value *= 1e6;
+    } else if (!suffix.empty()) {
+        throw std::invalid_argument("Bad rate: " + text);
+    }
+    if (!(value > 0.0)) throw std::invalid_argument("Rate must be positive: " + text);
+    return value;
+}
+
+std::vector<double> parse_rates(const std::string& text) {
+    std::vector<double> rates;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) rates.push_back(parse_rate(item));
+    }
+    if (rates.empty()) throw std::invalid_argument("Empty load list: " + text);
+    return rates;
+}
+
+std::string symbol_name(std::size_t i) {
+    return "LT" + std::to_string(i);
+}
+
+std::vector<Tick> tick_pool(const LoadTestConfig& config) {
+    if (!config.journals.empty()) {
+        ReplayConfig replay_config;
+        replay_config.timestamps = ReplayTimestamps::RECORDED;
+        ReplayFeed replay(config.journals, replay_config);
+        auto ticks = replay_ticks(replay);
+        if (ticks.empty()) throw std::runtime_error("Journals hold no ticks");
+        return ticks;
+    }
+
+    std::vector<SymbolConfig> symbols;
+    for (std::size_t i = 0; i < config.symbols; ++i) {
+        symbols.emplace_back(symbol_name(i), 50.0 + static_cast<double>(i % 10) * 25.0, 0.02);
+    }
+    FeedSimulator feed(std::move(symbols), PriceModel::GEOMETRIC_BROWNIAN_MOTION, 1.0);
+    for (std::size_t i = 0; i + 1 < config.symbols; i += 2) {
+        feed.set_pair_correlation(symbol_name(i), symbol_name(i + 1), 0.8);
+    }
+    return simulate_ticks(feed, SIMULATED_STEPS, 1.0);
+}
+
+// Offer rate ticks/s for seconds; the Router's stats must be fresh
+LoadStepResult run_step(const LoadTestConfig& config, double rate, const std::vector<Tick>& pool,
+                        TickQueue& queue, Router& router, const SignalDispatcher& dispatcher) {
+    ConsumerConfig consumer_config;
+    consumer_config.wait = *config.wait;
+    consumer_config.cpu = config.consumer_cpu;
+    ConsumerRunner consumer(queue, [&router](const Tick& tick) { router.process_tick(tick); },
+                            consumer_config);
+
+    QueueDepthHistogram depth;
+    LoadStepResult result;
+    result.offered_tps = rate;
+    const uint64_t signals_before = dispatcher.published();
+    const uint64_t signal_drops_before = dispatcher.dropped();
+
+    consumer.start();
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&]() {
+        if (config.producer_cpu >= 0 && !pin_current_thread(static_cast<unsigned>(config.producer_cpu))) {
+            std::cerr << "Could not pin producer to CPU " << config.producer_cpu << "\n";
+        }
+        const auto duration = std::chrono::duration<double>(config.seconds);
+        std::vector<Tick> batch(PUSH_BATCH);
+        std::size_t cursor = 0;
+        uint64_t offered = 0;
+        uint64_t dropped = 0;
+        for (;;) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed >= duration) break;
+
+            // Absolute schedule: a stall is made up by later batches, not lost
+            const auto due = static_cast<uint64_t>(rate * elapsed.count());
+            if (offered >= due) {
+                if (*config.wait == WaitStrategy::BUSY_SPIN) {
+                    cpu_relax();
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+
+            const std::size_t n = static_cast<std::size_t>(std::min<uint64_t>(due - offered, PUSH_BATCH));
+            const auto now = TickClock::now();
+            for (std::size_t i = 0; i < n; ++i) {
+                batch[i] = pool[cursor];
+                batch[i].timestamp = now;
+                if (++cursor == pool.size()) cursor = 0;
+            }
+            depth.record(queue.size());
+            dropped += n - queue.try_push_n(batch.data(), n);
+            offered += n;
+            consumer.wake_signal().notify();
+        }
+        result.ticks_offered = offered;
+        result.ticks_dropped = dropped;
+    });
+    producer.join();
+    consumer.stop();  // Drains what is queued
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (config.consumer_cpu >= 0 && !consumer.pinned()) {
+        std::cerr << "Could not pin consumer to CPU " << config.consumer_cpu << "\n";
+    }
+
+    const RouterSnapshot snapshot = router.snapshot();
+    result.ticks_processed = consumer.items_consumed();
+    result.achieved_tps = result.seconds > 0.0 ? static_cast<double>(result.ticks_processed) / result.seconds : 0.0;
+    result.signals = dispatcher.published() - signals_before;
+    result.signals_dropped = dispatcher.dropped() - signal_drops_before;
+    result.queue_depth_p50 = depth.quantile(0.50);
+    result.queue_depth_p99 = depth.quantile(0.99);
+    result.queue_depth_max = depth.max();
+    result.latency_p50_ns = snapshot.latency.percentile_ns(50.0);
+    result.latency_p99_ns = snapshot.latency.percentile_ns(99.0);
+    result.latency_p999_ns = snapshot.latency.percentile_ns(99.9);
+    result.latency_max_ns = snapshot.latency.max_latency_ns();
+    return result;
+}
+
+void print_step(const LoadStepResult& step) {
+    std::cout << std::setw(12) << static_cast<uint64_t>(step.offered_tps) << std::setw(12)
+              << static_cast<uint64_t>(step.achieved_tps) << std::setw(9) << std::fixed << std::setprecision(2)
+              << step.drop_rate() * 100.0 << "%" << std::setw(9) << step.queue_depth_p99 << std::setw(10)
+              << step.latency_p50_ns << std::setw(10) << step.latency_p99_ns << std::setw(11)
+              << step.latency_p999_ns << std::setw(11) << step.latency_max_ns << std::setw(10) << step.signals
+              << "\n";
+}
+
+void print_usage(std::ostream& out, const char* program) {
+    out << "Usage: " << program << " [--loads LIST] [--seconds S] [--symbols N] [--producer-cpu C]\n"
+        << "       [--consumer-cpu C] [--wait spin|yield|block|sleep] [-o report.json]\n"
+        << "       [--baseline report.json] [--label TEXT] [--throughput-tolerance F]\n"
+        << "       [--latency-tolerance F] [--drop-tolerance F] [ticks.rtj...]\n"
+        << "Loads are ticks/s with optional k/M suffix. With at least three CPUs the producer and\n"
+        << "consumer default to CPUs 1 and 2 and spin; otherwise they float and the consumer blocks.\n"
+        << "A CPU of -1 leaves that thread floating.\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    LoadTestConfig config;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--loads" && i + 1 < argc) {
+                config.loads = parse_rates(argv[++i]);
+            } else if (arg == "--seconds" && i + 1 < argc) {
+                config.seconds = std::stod(argv[++i]);
+            } else if (arg == "--symbols" && i + 1 < argc) {
+                config.symbols = std::stoull(argv[++i]);
+            } else if (arg == "--producer-cpu" && i + 1 < argc) {
+                config.producer_cpu = std::stoi(argv[++i]);
+            } else if (arg == "--consumer-cpu" && i + 1 < argc) {
+                config.consumer_cpu = std::stoi(argv[++i]);
+            } else if (arg == "--wait" && i + 1 < argc) {
+                const auto wait = parse_wait_strategy(argv[++i]);
+                if (!wait) throw std::invalid_argument(std::string("Unknown wait strategy: ") + argv[i]);
+                config.wait = wait;
+            } else if (arg == "-o" && i + 1 < argc) {
+                config.output = argv[++i];
+            } else if (arg == "--baseline" && i + 1 < argc) {
+                config.baseline = argv[++i];
+            } else if (arg == "--label" && i + 1 < argc) {
+                config.label = argv[++i];
+            } else if (arg == "--throughput-tolerance" && i + 1 < argc) {
+                config.tolerance.throughput = std::stod(argv[++i]);
+            } else if (arg == "--latency-tolerance" && i + 1 < argc) {
+                config.tolerance.latency = std::stod(argv[++i]);
+            } else if (arg == "--drop-tolerance" && i + 1 < argc) {
+                config.tolerance.drop_rate = std::stod(argv[++i]);
+            } else if (arg == "--help" || arg == "-h") {
+                print_usage(std::cout, argv[0]);
+                return 0;
+            } else if (!arg.empty() && arg[0] == '-') {
+                print_usage(std::cerr, argv[0]);
+                return 2;
+            } else {
+                config.journals.push_back(arg);
+            }
+        }
+        if (!(config.seconds > 0.0)) throw std::invalid_argument("--seconds must be positive");
+        if (config.symbols < 2) throw std::invalid_argument("--symbols must be at least 2");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        print_usage(std::cerr, argv[0]);
+        return 2;
+    }
+
+    try {
+        // Two dedicated cores when the machine has them; sharing one with the
+        // other thread or the OS would measure the scheduler instead
+        const bool spare_cores = std::thread::hardware_concurrency() >= 3;
+        if (config.producer_cpu == AUTO_CPU) config.producer_cpu = spare_cores ? 1 : -1;
+        if (config.consumer_cpu == AUTO_CPU) config.consumer_cpu = spare_cores ? 2 : -1;
+        if (!config.wait) config.wait = spare_cores ? WaitStrategy::BUSY_SPIN : WaitStrategy::BLOCKING;
+
+        std::vector<LoadStepResult> baseline;
+        if (!config.baseline.empty()) {
+            std::ifstream in(config.baseline);
+            if (!in) throw std::runtime_error("Cannot read baseline " + config.baseline);
+            baseline = read_load_report(in);
+        }
+
+        CycleClock::calibrate();
+        const std::vector<Tick> pool = tick_pool(config);
+        auto queue = std::make_unique<TickQueue>();
+
+        // Same rule set and emission policies as the demo; the dispatcher
+        // counts signals, the sink only stands in for a consumer of them
+        SignalDispatcher dispatcher;
+        dispatcher.add_sink([](const SignalEvent&) {});
+        Router router;
+        router.set_emission_policy(SignalEvent::Type::Z_SCORE_BREAK, EmissionPolicy::hysteresis(0.5));
+        router.set_emission_policy(SignalEvent::Type::VOLUME_SPIKE, EmissionPolicy::edge());
+        router.set_emission_policy(SignalEvent::Type::PAIR_TRADE_ENTRY, EmissionPolicy::hysteresis(0.5));
+        router.set_emission_policy(SignalEvent::Type::CORRELATION_BREAK, EmissionPolicy::hysteresis(0.05));
+        router.set_signal_dispatcher(&dispatcher);
+        if (config.journals.empty()) {
+            router.reserve(config.symbols, config.symbols / 2);
+            for (std::size_t i = 0; i < config.symbols; ++i) router.add_symbol(symbol_name(i));
+            for (std::size_t i = 0; i + 1 < config.symbols; i += 2) {
+                router.add_watched_pair(symbol_name(i), symbol_name(i + 1));
+            }
+        }
+        dispatcher.start();
+
+        std::cout << pool.size() << " ticks in pool, " << config.seconds << "s per step, producer CPU "
+                  << config.producer_cpu << ", consumer CPU " << config.consumer_cpu << ", wait "
+                  << wait_strategy_name(*config.wait) << "\n\n"
+                  << std::setw(12) << "offered/s" << std::setw(12) << "achieved/s" << std::setw(10) << "dropped"
+                  << std::setw(9) << "depth99" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns"
+                  << std::setw(11) << "p99.9 ns" << std::setw(11) << "max ns" << std::setw(10) << "signals"
+                  << "\n";
+
+        std::vector<LoadStepResult> steps;
+        for (double rate : config.loads) {
+            router.reset_stats();
+            CycleClock::reanchor();  // Between steps, while no thread stamps ticks
+            steps.push_back(run_step(config, rate, pool, *queue, router, dispatcher));
+            print_step(steps.back());
+        }
+        dispatcher.stop();
+
+        std::ofstream out(config.output);
+        if (!out) throw std::runtime_error("Cannot write " + config.output);
+        write_load_report(out, steps, config.label);
+        std::cout << "\nReport written to " << config.output << "\n";
+
+        if (!config.baseline.empty()) {
+            const auto regressions = compare_load_reports(baseline, steps, config.tolerance);
+            for (const LoadRegression& r : regressions) {
+                std::cerr << "REGRESSION at " << static_cast<uint64_t>(r.offered_tps) << " ticks/s: " << r.metric
+                          << " " << r.baseline << " -> " << r.measured << "\n";
+            }
+            if (!regressions.empty()) return 1;
+            std::cout << "No regressions against " << config.baseline << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}